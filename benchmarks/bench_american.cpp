@@ -0,0 +1,65 @@
+#include "bench_common.h"
+#include "pricer/american_approximation.h"
+#include "pricer/finite_difference.h"
+#include "pricer/monte_carlo.h"
+#include <vector>
+
+namespace {
+
+// Args: spot grid steps (time steps are half as many)
+void BM_FiniteDifferencePrice(benchmark::State& state) {
+    const auto steps = static_cast<std::size_t>(state.range(0));
+    const pricer::FiniteDifferenceEngine engine(steps, steps / 2);
+    const auto option = bench::atTheMoney(pricer::OptionType::Put, pricer::ExerciseStyle::American);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.calculate(option));
+    }
+    bench::setContractCounters(state, 1);
+}
+BENCHMARK(BM_FiniteDifferencePrice)->ArgName("steps")->Arg(200)->Arg(800)->Unit(benchmark::kMicrosecond);
+
+// Args: approximation method, contracts
+void BM_AmericanApproximationPriceBatch(benchmark::State& state) {
+    constexpr pricer::AmericanApproximation kMethods[] = {pricer::AmericanApproximation::BjerksundStensland,
+                                                          pricer::AmericanApproximation::BaroneAdesiWhaley,
+                                                          pricer::AmericanApproximation::AndersenLakeOffengenden};
+    const auto n = static_cast<std::size_t>(state.range(1));
+    const pricer::AmericanApproximationEngine engine(kMethods[state.range(0)]);
+    const pricer::ContractBatch batch = bench::makeChain(n, pricer::ExerciseStyle::American);
+    std::vector<double> prices(n);
+
+    for (auto _ : state) {
+        engine.priceBatch(batch, prices);
+        benchmark::DoNotOptimize(prices.data());
+        benchmark::ClobberMemory();
+    }
+    bench::setContractCounters(state, n);
+}
+BENCHMARK(BM_AmericanApproximationPriceBatch)
+    ->ArgNames({"method", "contracts"})
+    ->Args({0, 1 << 16})
+    ->Args({1, 1 << 16})
+    ->Args({2, 1 << 10})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Least-squares Monte Carlo; args: paths, exercise dates
+void BM_LeastSquaresMonteCarlo(benchmark::State& state) {
+    const auto paths = static_cast<std::size_t>(state.range(0));
+    const auto dates = static_cast<std::size_t>(state.range(1));
+    const pricer::MonteCarloEngine engine(paths, dates);
+    const auto option = bench::atTheMoney(pricer::OptionType::Put, pricer::ExerciseStyle::American);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.simulate(option));
+    }
+    state.counters["path_steps_per_second"] = benchmark::Counter(
+        static_cast<double>(paths * dates), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_LeastSquaresMonteCarlo)
+    ->ArgNames({"paths", "dates"})
+    ->ArgsProduct({{10000, 100000}, {52, 252}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,52 @@
+#include "bench_common.h"
+#include "pricer/binomial.h"
+#include <vector>
+
+namespace {
+
+// Args: tree steps, Richardson (BBS) extrapolation on/off, American exercise on/off
+void BM_BinomialTreePrice(benchmark::State& state) {
+    const pricer::BinomialTreeEngine engine(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+    const auto option = bench::atTheMoney(pricer::OptionType::Put,
+                                          state.range(2) != 0 ? pricer::ExerciseStyle::American
+                                                              : pricer::ExerciseStyle::European);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.calculate(option));
+    }
+    bench::setContractCounters(state, 1);
+}
+BENCHMARK(BM_BinomialTreePrice)
+    ->ArgNames({"steps", "bbs", "american"})
+    ->ArgsProduct({{100, 500, 2000}, {0, 1}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_BinomialTreeCalculateAll(benchmark::State& state) {
+    const pricer::BinomialTreeEngine engine(static_cast<std::size_t>(state.range(0)), true);
+    const auto option = bench::atTheMoney(pricer::OptionType::Put, pricer::ExerciseStyle::American);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.calculateAll(option));
+    }
+    bench::setContractCounters(state, 1);
+}
+BENCHMARK(BM_BinomialTreeCalculateAll)->ArgName("steps")->Arg(500)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+// Args: chain length, American exercise on/off; 200-step trees with extrapolation
+void BM_BinomialTreeBatch(benchmark::State& state) {
+    const pricer::BinomialTreeEngine engine(200, true);
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const pricer::ContractBatch batch = bench::makeChain(n, state.range(1) != 0 ? pricer::ExerciseStyle::American
+                                                                              : pricer::ExerciseStyle::European);
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        engine.priceBatch(batch, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    bench::setContractCounters(state, n);
+}
+BENCHMARK(BM_BinomialTreeBatch)
+    ->ArgNames({"contracts", "american"})
+    ->ArgsProduct({{1000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
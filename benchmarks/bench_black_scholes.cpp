@@ -0,0 +1,62 @@
+#include "bench_common.h"
+#include "pricer/black_scholes.h"
+#include <vector>
+
+namespace {
+
+void BM_BlackScholesPrice(benchmark::State& state) {
+    const pricer::BlackScholesPricingEngine engine;
+    const auto option = bench::atTheMoney();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.calculate(option));
+    }
+    bench::setContractCounters(state, 1);
+}
+BENCHMARK(BM_BlackScholesPrice);
+
+void BM_BlackScholesCalculateAll(benchmark::State& state) {
+    const pricer::BlackScholesPricingEngine engine;
+    const auto option = bench::atTheMoney();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.calculateAll(option));
+    }
+    bench::setContractCounters(state, 1);
+}
+BENCHMARK(BM_BlackScholesCalculateAll);
+
+// Vectorized chain kernel; args: contracts, fast normal CDF tier
+void BM_BlackScholesPriceBatch(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    pricer::BlackScholesPricingEngine engine;
+    engine.setNormalAccuracy(state.range(1) != 0 ? pricer::NormalAccuracy::Fast : pricer::NormalAccuracy::Full);
+    const pricer::ContractBatch batch = bench::makeChain(n);
+    std::vector<double> prices(n);
+
+    for (auto _ : state) {
+        engine.priceBatch(batch, prices);
+        benchmark::DoNotOptimize(prices.data());
+        benchmark::ClobberMemory();
+    }
+    bench::setContractCounters(state, n);
+}
+BENCHMARK(BM_BlackScholesPriceBatch)
+    ->ArgNames({"contracts", "fast"})
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1}})
+    ->UseRealTime();
+
+void BM_BlackScholesCalculateAllBatch(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const pricer::BlackScholesPricingEngine engine;
+    const pricer::ContractBatch batch = bench::makeChain(n);
+    std::vector<pricer::PricingResult> results(n);
+
+    for (auto _ : state) {
+        engine.calculateAllBatch(batch, 0, results);
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    bench::setContractCounters(state, n);
+}
+BENCHMARK(BM_BlackScholesCalculateAllBatch)->ArgName("contracts")->Arg(1 << 10)->Arg(1 << 16);
+
+} // namespace
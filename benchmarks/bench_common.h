@@ -0,0 +1,56 @@
+//
+// Shared inputs and throughput counters of the benchmark suite.
+//
+
+#ifndef OPTIONS_PRICER_BENCH_COMMON_H
+#define OPTIONS_PRICER_BENCH_COMMON_H
+
+#include "pricer/contract.h"
+#include "pricer/option.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+namespace bench {
+
+// At-the-money one-year contract used by the single-option benchmarks
+inline pricer::OptionParameters atTheMoney(const pricer::OptionType type = pricer::OptionType::Call,
+                                           const pricer::ExerciseStyle exercise = pricer::ExerciseStyle::European) {
+    return {type, 100.0, 1.0, 100.0, 0.05, 0.2, 0.02, exercise};
+}
+
+/**
+ * @brief Deterministic chain of n contracts spread over strikes, expiries
+ *        and both option types, so batch kernels see realistic mixes
+ */
+inline pricer::ContractBatch makeChain(const std::size_t n,
+                                       const pricer::ExerciseStyle exercise = pricer::ExerciseStyle::European) {
+    pricer::ContractBatch batch;
+    batch.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double strike = 70.0 + static_cast<double>(i % 61);
+        const double expiry = 0.1 + 0.25 * static_cast<double>(i % 8);
+        const auto type = i % 2 == 0 ? pricer::OptionType::Call : pricer::OptionType::Put;
+        batch.add({strike, expiry, type, exercise}, {100.0, 0.05, 0.15 + 0.01 * static_cast<double>(i % 20), 0.02});
+    }
+    return batch;
+}
+
+/**
+ * @brief Report contracts/s and the time per contract for a benchmark that
+ *        prices `contracts` contracts per iteration
+ *
+ * The time is in seconds, which the console prints with an SI prefix
+ * (e.g. 43.2ns) and the JSON output keeps as a plain number.
+ */
+inline void setContractCounters(benchmark::State& state, const std::size_t contracts) {
+    const auto per_iteration = static_cast<double>(contracts);
+    state.counters["contracts_per_second"] =
+        benchmark::Counter(per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["time_per_contract"] =
+        benchmark::Counter(per_iteration, benchmark::Counter::kIsIterationInvariantRate
+                                              | benchmark::Counter::kInvert);
+}
+
+} // namespace bench
+
+#endif // OPTIONS_PRICER_BENCH_COMMON_H
@@ -0,0 +1,69 @@
+#include "bench_common.h"
+#include "pricer/monte_carlo.h"
+
+namespace {
+
+// Price and standard error; args: paths, time steps, thread cap (0 for the whole pool)
+void BM_MonteCarloSimulate(benchmark::State& state) {
+    const auto paths = static_cast<std::size_t>(state.range(0));
+    const auto steps = static_cast<std::size_t>(state.range(1));
+    const pricer::MonteCarloEngine engine(paths, steps, true, static_cast<std::size_t>(state.range(2)));
+    const auto option = bench::atTheMoney();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.simulate(option));
+    }
+    state.counters["paths_per_second"] = benchmark::Counter(
+        static_cast<double>(paths), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["path_steps_per_second"] = benchmark::Counter(
+        static_cast<double>(paths * steps), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MonteCarloSimulate)
+    ->ArgNames({"paths", "steps", "threads"})
+    ->ArgsProduct({{10000, 100000}, {1, 52, 252}, {1, 2, 4, 0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Price and every Greek from one simulation, per Greek estimator
+void BM_MonteCarloCalculateAll(benchmark::State& state) {
+    constexpr pricer::GreekMethod kMethods[] = {pricer::GreekMethod::Pathwise,
+                                                pricer::GreekMethod::LikelihoodRatio,
+                                                pricer::GreekMethod::CommonRandomNumbers};
+    pricer::MonteCarloEngine engine(100000, 52);
+    engine.setGreekMethod(kMethods[state.range(0)]);
+    const auto option = bench::atTheMoney();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.calculateAll(option));
+    }
+    bench::setContractCounters(state, 1);
+}
+BENCHMARK(BM_MonteCarloCalculateAll)
+    ->ArgName("greek_method")
+    ->DenseRange(0, 2)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Path-dependent payoffs on 100k paths; args: payoff (Asian, barrier, lookback), monitoring dates
+void BM_MonteCarloPathPayoff(benchmark::State& state) {
+    const pricer::Payoff kPayoffs[] = {pricer::AsianPayoff{},
+                                       pricer::BarrierPayoff{pricer::BarrierType::DownAndOut, 90.0},
+                                       pricer::LookbackPayoff{}};
+    const auto steps = static_cast<std::size_t>(state.range(1));
+    pricer::MonteCarloEngine engine(100000, steps);
+    engine.setPayoff(kPayoffs[state.range(0)]);
+    const auto option = bench::atTheMoney();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.simulate(option));
+    }
+    state.counters["path_steps_per_second"] = benchmark::Counter(
+        static_cast<double>(100000 * steps), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MonteCarloPathPayoff)
+    ->ArgNames({"payoff", "steps"})
+    ->ArgsProduct({{0, 1, 2}, {52, 252}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,76 @@
+#include "bench_common.h"
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/portfolio.h"
+#include "pricer/scenario.h"
+#include <memory>
+
+namespace {
+
+pricer::Portfolio makeBook(const std::size_t n, const std::shared_ptr<const pricer::PricingEngine>& engine,
+                           const pricer::ExerciseStyle exercise) {
+    const pricer::ContractBatch chain = bench::makeChain(n, exercise);
+    pricer::Portfolio book;
+    book.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        book.add(chain.contract(i), chain.market(i), i % 3 == 0 ? -1.0 : 1.0, engine);
+    }
+    return book;
+}
+
+// Whole-book price and Greeks through the vectorized Black-Scholes batch path; args: positions
+void BM_PortfolioBlackScholes(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const pricer::Portfolio book = makeBook(n, pricer::makeBlackScholesPricingEngine(),
+                                            pricer::ExerciseStyle::European);
+    const pricer::PortfolioPricer book_pricer;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book_pricer.price(book));
+    }
+    bench::setContractCounters(state, n);
+}
+BENCHMARK(BM_PortfolioBlackScholes)
+    ->ArgName("positions")
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// American book on trees, where each position is a scalar calculateAll
+void BM_PortfolioBinomial(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const pricer::Portfolio book = makeBook(n, pricer::makeBinomialTreeEngine(200, true),
+                                            pricer::ExerciseStyle::American);
+    const pricer::PortfolioPricer book_pricer;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book_pricer.price(book));
+    }
+    bench::setContractCounters(state, n);
+}
+BENCHMARK(BM_PortfolioBinomial)->ArgName("positions")->Arg(1 << 10)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Spot x volatility ladder of a Black-Scholes book, one batch kernel call per
+// task; args: positions, with 21 x 5 scenarios each
+void BM_ScenarioLadderBlackScholes(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const pricer::Portfolio book = makeBook(n, pricer::makeBlackScholesPricingEngine(),
+                                            pricer::ExerciseStyle::European);
+    const pricer::ScenarioGrid grid = pricer::ScenarioGrid::ladder(0.2, 21, 0.05, 5);
+    const pricer::ScenarioPricer scenario_pricer;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scenario_pricer.price(book, grid));
+    }
+    bench::setContractCounters(state, n * grid.size());
+}
+BENCHMARK(BM_ScenarioLadderBlackScholes)
+    ->ArgName("positions")
+    ->Arg(1 << 10)
+    ->Arg(1 << 14)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
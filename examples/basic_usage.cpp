@@ -5,6 +5,7 @@
 #include "pricer/black_scholes.h"
 #include "pricer/monte_carlo.h"
 #include "pricer/binomial.h"
+#include "pricer/portfolio.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -13,13 +14,14 @@
 // Helper function to print option results
 void printResults(const std::string& method, const pricer::Option& option) {
     std::cout << "\n" << method << " Results:\n";
+    const pricer::PricingResult result = option.calculateAll();
     std::cout << std::fixed << std::setprecision(6);
-    std::cout << "Price: " << option.price() << "\n";
-    std::cout << "Delta: " << option.delta() << "\n";
-    std::cout << "Gamma: " << option.gamma() << "\n";
-    std::cout << "Theta: " << option.theta() << "\n";
-    std::cout << "Vega:  " << option.vega() << "\n";
-    std::cout << "Rho:   " << option.rho() << "\n";
+    std::cout << "Price: " << result.price << "\n";
+    std::cout << "Delta: " << result.delta << "\n";
+    std::cout << "Gamma: " << result.gamma << "\n";
+    std::cout << "Theta: " << result.theta << "\n";
+    std::cout << "Vega:  " << result.vega << "\n";
+    std::cout << "Rho:   " << result.rho << "\n";
     std::cout << "----------------------------\n";
 }
 
@@ -107,6 +109,24 @@ int main() {
                      << ", Vega = " << euro_call.vega() << "\n";
         }
 
+        // Price a small book in one call
+        std::cout << "\nBook Pricing:\n";
+        std::cout << "=============\n";
+
+        const pricer::MarketState market{100.0, 0.05, 0.2, 0.02};
+        pricer::Portfolio book;
+        for (const double strike : {90.0, 100.0, 110.0}) {
+            book.add({strike, 1.0, pricer::OptionType::Call}, market, 10.0, bs_engine);
+            book.add({strike, 1.0, pricer::OptionType::Put, pricer::ExerciseStyle::American},
+                     market, -5.0, bin_engine);
+        }
+
+        const pricer::PortfolioResult book_result = pricer::PortfolioPricer().price(book);
+        std::cout << "Positions: " << book.size() << "\n";
+        std::cout << "Book Value: " << book_result.total.price << "\n";
+        std::cout << "Book Delta: " << book_result.total.delta << "\n";
+        std::cout << "Book Vega:  " << book_result.total.vega << "\n";
+
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
@@ -0,0 +1,144 @@
+//
+// Analytic approximations of American option prices.
+//
+
+#ifndef OPTIONS_PRICER_AMERICAN_APPROXIMATION_H
+#define OPTIONS_PRICER_AMERICAN_APPROXIMATION_H
+
+#include "engine.h"
+#include "thread_pool.h"
+#include <memory>
+#include <span>
+
+namespace pricer {
+
+/**
+ * @brief Approximation used by AmericanApproximationEngine
+ */
+enum class AmericanApproximation {
+    BjerksundStensland,       ///< Bjerksund-Stensland (2002) two-step flat boundary; vectorized
+    BaroneAdesiWhaley,        ///< Barone-Adesi-Whaley (1987) quadratic approximation; vectorized
+    AndersenLakeOffengenden   ///< Andersen-Lake-Offengenden (2016) boundary iteration, ~1e-5 accurate
+};
+
+/**
+ * @brief Closed-form and semi-analytic American option prices
+ *
+ * Every contract is priced as American, mirroring how the Black-Scholes
+ * engine prices every contract as European. Calls are priced directly and
+ * puts through the put-call symmetry P(S, K, r, q) = C(K, S, q, r).
+ *
+ * Bjerksund-Stensland and Barone-Adesi-Whaley are within a few cents of
+ * the exact price for typical contracts (Bjerksund-Stensland from below)
+ * and run as branch-free kernels that vectorize across contracts, at a few
+ * microseconds per contract or less. Andersen-Lake-Offengenden iterates the
+ * early-exercise boundary on Chebyshev nodes and is accurate to about 1e-5
+ * for contracts up to a few years, at around a hundred microseconds per
+ * contract. Negative rates, where the exercise region can split in two, are
+ * outside all three methods.
+ */
+class AmericanApproximationEngine : public PricingEngine {
+public:
+    /**
+     * @brief Constructor
+     * @param method Approximation to price with
+     */
+    explicit AmericanApproximationEngine(
+        AmericanApproximation method = AmericanApproximation::BjerksundStensland);
+
+    [[nodiscard]] double calculate(const OptionParameters& option) const override;
+
+    /**
+     * @brief Greeks are central differences of the approximation, so each
+     *        costs one calculateAll
+     */
+    [[nodiscard]] double calculateDelta(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateGamma(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateTheta(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateVega(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateRho(const OptionParameters& option) const override;
+
+    /**
+     * @brief Price and Greeks from the base and eight bumped scenarios,
+     *        evaluated in one pass of the chain kernel
+     */
+    [[nodiscard]] PricingResult calculateAll(const OptionParameters& option) const override;
+
+    /**
+     * @brief Price a whole chain from structure-of-arrays inputs
+     *
+     * Same contract as BlackScholesPricingEngine::priceBatch, with every
+     * contract priced as American. Long chains are split into fixed-size
+     * chunks that run on the thread pool.
+     *
+     * @param spot Spot prices
+     * @param strike Strike prices
+     * @param expiry Times to expiry in years
+     * @param rate Risk-free rates
+     * @param volatility Volatilities
+     * @param dividend Dividend yields
+     * @param type Call/put flags
+     * @param out Receives the prices
+     * @throws std::invalid_argument on mismatched lengths or invalid parameters
+     */
+    void priceBatch(std::span<const double> spot,
+                    std::span<const double> strike,
+                    std::span<const double> expiry,
+                    std::span<const double> rate,
+                    std::span<const double> volatility,
+                    std::span<const double> dividend,
+                    std::span<const OptionType> type,
+                    std::span<double> out) const;
+
+    /**
+     * @brief Price every contract of a batch; the exercise style is ignored
+     * @param batch Contracts and their market inputs
+     * @param out Receives one price per contract
+     * @throws std::invalid_argument if out has the wrong length
+     */
+    void priceBatch(const ContractBatch& batch, std::span<double> out) const override;
+
+    /**
+     * @brief Price and Greeks of a batch range, with the bumped scenarios of
+     *        a block of contracts evaluated in one kernel pass
+     */
+    void calculateAllBatch(const ContractBatch& batch,
+                           std::size_t begin,
+                           std::span<PricingResult> out) const override;
+
+    [[nodiscard]] AmericanApproximation getMethod() const { return method_; }
+    void setMethod(const AmericanApproximation method) { method_ = method; }
+
+    /**
+     * @brief Schedule batch chunks on a specific pool
+     * @param pool Pool to use, or nullptr for ThreadPool::global()
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { thread_pool_ = std::move(pool); }
+
+private:
+    AmericanApproximation method_;
+    std::shared_ptr<ThreadPool> thread_pool_;
+
+    // Contracts per pool task in priceBatch
+    static constexpr std::size_t kBatchChunk = 4096;
+
+    // Relative spot and expiry bump, absolute volatility and rate bump of the Greeks
+    static constexpr double kBump = 1e-4;
+
+    /**
+     * @brief Dispatch unchecked raw arrays to the kernel of the current method
+     */
+    void priceChain(const double* spot, const double* strike, const double* expiry,
+                    const double* rate, const double* volatility, const double* dividend,
+                    const OptionType* type, double* out, std::size_t n) const;
+};
+
+// Factory function
+inline std::shared_ptr<PricingEngine> makeAmericanApproximationEngine(
+    AmericanApproximation method = AmericanApproximation::BjerksundStensland) {
+    return std::make_shared<AmericanApproximationEngine>(method);
+}
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_AMERICAN_APPROXIMATION_H
@@ -0,0 +1,166 @@
+//
+// Background pricing jobs with cancellation and progress reporting.
+//
+
+#ifndef OPTIONS_PRICER_ASYNC_H
+#define OPTIONS_PRICER_ASYNC_H
+
+#include "engine.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+namespace pricer {
+
+class ThreadPool;
+
+/**
+ * @brief Thrown out of a pricing call whose job was cancelled
+ */
+class PricingCancelled : public std::runtime_error {
+public:
+    PricingCancelled() : std::runtime_error("Pricing was cancelled") {}
+};
+
+/**
+ * @brief Shared flag a caller sets to stop a running job
+ *
+ * Copies share the same flag, so the caller keeps one copy and the job
+ * another. Cancelling is a request: the engines notice it at their next
+ * checkpoint, between simulation waves or tree time steps.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag_->store(true, std::memory_order_relaxed); }
+    [[nodiscard]] bool cancelled() const { return flag_->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/**
+ * @brief How far a pricing call has got
+ */
+struct PricingProgress {
+    double fraction = 0.0;       ///< Share of the current pass done, in [0, 1]
+    bool has_estimate = false;   ///< Whether estimate holds a usable price yet
+    PricingResult estimate;      ///< Price so far, with its standard error if simulated
+};
+
+/**
+ * @brief Receives progress reports on the thread running the job
+ */
+using ProgressCallback = std::function<void(const PricingProgress&)>;
+
+/**
+ * @brief What a running job shares with the engines it calls
+ */
+struct JobControl {
+    CancellationToken token;
+    ProgressCallback progress;
+};
+
+namespace async {
+
+namespace detail {
+    inline thread_local const JobControl* current_job = nullptr;
+}
+
+/**
+ * @brief Job installed on the calling thread, or nullptr outside of one
+ */
+[[nodiscard]] inline const JobControl* currentJob() { return detail::current_job; }
+
+/**
+ * @brief Throw PricingCancelled if the current job was cancelled
+ *
+ * Costs one thread-local load and a branch outside of a job.
+ */
+inline void checkpoint() {
+    if (const JobControl* job = detail::current_job; job && job->token.cancelled()) {
+        throw PricingCancelled();
+    }
+}
+
+/**
+ * @brief Pass a progress report to the current job, if it wants them
+ */
+inline void report(const PricingProgress& progress) {
+    if (const JobControl* job = detail::current_job; job && job->progress) {
+        job->progress(progress);
+    }
+}
+
+/**
+ * @brief Installs a job on the calling thread for the lifetime of the object
+ *
+ * Engines that hand work to other threads install the caller's job there
+ * too, so those threads see the same token. A null job runs outside of
+ * any job. The previously installed job is restored on destruction.
+ */
+class ScopedJob {
+public:
+    explicit ScopedJob(const JobControl* job) : previous_(detail::current_job) {
+        detail::current_job = job;
+    }
+    ~ScopedJob() { detail::current_job = previous_; }
+
+    ScopedJob(const ScopedJob&) = delete;
+    ScopedJob& operator=(const ScopedJob&) = delete;
+
+private:
+    const JobControl* previous_;
+};
+
+/**
+ * @brief Keeps the current job's token but drops its progress reports
+ *
+ * For the bumped repricings behind the Greeks, whose partial prices would
+ * otherwise read as estimates of the contract itself.
+ */
+class ScopedQuiet {
+public:
+    ScopedQuiet()
+        : quiet_{detail::current_job ? detail::current_job->token : CancellationToken{}, {}}
+        , scope_(detail::current_job ? &quiet_ : nullptr) {}
+
+private:
+    JobControl quiet_;
+    ScopedJob scope_;
+};
+
+} // namespace async
+
+/**
+ * @brief Handle of a job started by priceAsync
+ */
+struct PricingJob {
+    std::shared_future<PricingResult> result;  ///< Throws PricingCancelled if the job was cancelled
+    CancellationToken token;                   ///< Cancels the job
+};
+
+/**
+ * @brief Run engine.calculateAll(option) as a task on a pool
+ *
+ * The engine's own pool does the parallel work as usual; the returned future
+ * is ready once the job finishes, fails or notices its cancellation.
+ * @param engine Engine to price with, kept alive until the job finishes
+ * @param option Contract and market inputs
+ * @param progress Called with partial results as the engine makes progress
+ * @param finished Called on the job's thread once result is ready
+ * @param pool Pool the job itself runs on (nullptr for the global pool)
+ * @return Future of the result and the token that cancels it
+ */
+[[nodiscard]] PricingJob priceAsync(std::shared_ptr<const PricingEngine> engine,
+                                    const OptionParameters& option,
+                                    ProgressCallback progress = {},
+                                    std::function<void()> finished = {},
+                                    ThreadPool* pool = nullptr);
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_ASYNC_H
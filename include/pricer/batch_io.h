@@ -0,0 +1,250 @@
+//
+// Contract and result files for streaming batch pricing.
+//
+
+#ifndef OPTIONS_PRICER_BATCH_IO_H
+#define OPTIONS_PRICER_BATCH_IO_H
+
+#include "contract.h"
+#include "engine.h"
+#include "thread_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Encoding of a contract or result file
+ *
+ * CSV files start with a header row. Contract columns are matched by name:
+ * type (call/put), strike, expiry, spot, rate and volatility are required,
+ * dividend (default 0) and exercise (european/american, default european)
+ * are optional, and any other column is ignored. Result files have the
+ * columns price, delta, gamma, theta, vega, rho and std_error.
+ *
+ * Binary files are columnar: an 8-byte header (a 4-byte magic, "OPCB" for
+ * contracts and "OPRB" for results, then a uint32 version) and a sequence
+ * of blocks. Each block is a uint64 row count followed by one contiguous
+ * column per field: contract blocks hold the six double columns strike,
+ * expiry, spot, rate, volatility and dividend, then the uint8 columns type
+ * (0 call, 1 put) and exercise (0 European, 1 American), each padded with
+ * zeros to a multiple of 8 bytes. Result blocks hold the seven result
+ * columns as doubles. Values are in the machine's byte order.
+ */
+enum class BatchFormat {
+    Csv,
+    Binary
+};
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where supported
+ *
+ * Falls back to reading the file into memory on platforms without mmap.
+ */
+class MappedFile {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::string_view contents() const { return {data_, size_}; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> buffer_;
+};
+
+/**
+ * @brief Format of a contract file, from its first bytes
+ */
+[[nodiscard]] BatchFormat detectContractFormat(std::string_view contents);
+
+/**
+ * @brief Parses consecutive chunks of contracts out of a file's contents
+ *
+ * Fields are parsed in place with std::from_chars; the only allocations
+ * are the batch's own, which keeps its capacity from chunk to chunk.
+ */
+class ContractReader {
+public:
+    /**
+     * @param contents Whole file, which must outlive the reader
+     * @throws std::runtime_error if the header is malformed
+     */
+    explicit ContractReader(std::string_view contents);
+
+    [[nodiscard]] BatchFormat format() const { return format_; }
+
+    /**
+     * @brief Replace the batch's contents with the next contracts
+     * @param batch Receives up to max_rows contracts
+     * @param max_rows Most contracts to read
+     * @return Whether any contract was read
+     * @throws std::runtime_error with the line or block of a malformed entry
+     */
+    bool next(ContractBatch& batch, std::size_t max_rows);
+
+private:
+    // Columns of a CSV contract file
+    enum Column : std::size_t {
+        kType,
+        kStrike,
+        kExpiry,
+        kSpot,
+        kRate,
+        kVolatility,
+        kDividend,
+        kExercise,
+        kNumColumns
+    };
+
+    void readCsvHeader();
+    bool nextCsv(ContractBatch& batch, std::size_t max_rows);
+    bool nextBinary(ContractBatch& batch, std::size_t max_rows);
+
+    std::string_view contents_;
+    BatchFormat format_;
+    std::size_t offset_ = 0;
+
+    // CSV: column of each field (kNumColumns for ignored ones) and the
+    // number of the last line read
+    std::vector<std::size_t> field_columns_;
+    std::size_t line_ = 0;
+
+    // Binary: the current block and how much of it has been read
+    std::size_t block_ = 0;
+    std::size_t block_offset_ = 0;
+    std::size_t block_rows_ = 0;
+    std::size_t block_read_ = 0;
+};
+
+/**
+ * @brief Appends chunks of results to a stream
+ *
+ * Each chunk is formatted into a reused buffer with std::to_chars and
+ * written with a single call.
+ */
+class ResultWriter {
+public:
+    /**
+     * @brief Write the header of the format
+     */
+    ResultWriter(std::ostream& out, BatchFormat format);
+
+    void write(std::span<const PricingResult> results);
+
+    /**
+     * @brief Append the CSV rows of results to text
+     *
+     * Formatting dominates writing CSV, so callers can format the pieces of
+     * a chunk in parallel and pass them to writeCsv in order.
+     */
+    static void formatCsv(std::span<const PricingResult> results, std::string& text);
+
+    /**
+     * @brief Write rows made by formatCsv to a CSV stream, in order
+     */
+    void writeCsv(std::span<const std::string> rows);
+
+private:
+    void flush(std::string_view bytes);
+
+    std::ostream& out_;
+    BatchFormat format_;
+    std::string buffer_;
+};
+
+/**
+ * @brief Write contracts in a format ContractReader reads
+ * @param out Stream to write to
+ * @param batch Contracts to write, as one block for the binary format
+ * @param format Encoding
+ */
+void writeContracts(std::ostream& out, const ContractBatch& batch, BatchFormat format);
+
+/**
+ * @brief Totals of one BatchFilePricer run
+ */
+struct BatchRunStats {
+    std::size_t contracts = 0;
+    std::size_t chunks = 0;
+    double seconds = 0.0;
+
+    [[nodiscard]] double contractsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(contracts) / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Prices a contract file into a result file in bounded memory
+ *
+ * The file is processed chunk by chunk in a three-stage pipeline: while one
+ * chunk is priced, the next is parsed and the previous one is written, each
+ * as a pool task. Pricing cuts a chunk into tasks that run concurrently on
+ * the pool through PricingEngine::calculateAllBatch, as PortfolioPricer
+ * does; for CSV output the same tasks also format their rows. At most three chunks are in memory, and their buffers are reused,
+ * so memory does not grow with the file. Results are written in input
+ * order.
+ *
+ * Call it from outside the pool's own tasks: it waits on the stages it
+ * queues there.
+ */
+class BatchFilePricer {
+public:
+    /**
+     * @param pool Pool to use, or nullptr for ThreadPool::global()
+     */
+    explicit BatchFilePricer(std::shared_ptr<ThreadPool> pool = nullptr);
+
+    /**
+     * @brief Price every contract of a file
+     * @param engine Engine to price with
+     * @param contents Contract file, in either format
+     * @param out Receives the results
+     * @param format Encoding of the results
+     * @return Contracts and chunks processed and the wall-clock time taken
+     * @throws std::runtime_error if the contract file is malformed
+     * @throws std::invalid_argument if a contract's parameters are invalid
+     */
+    BatchRunStats price(const PricingEngine& engine,
+                        std::string_view contents,
+                        std::ostream& out,
+                        BatchFormat format) const;
+
+    [[nodiscard]] std::size_t getChunkRows() const { return chunk_rows_; }
+    [[nodiscard]] std::size_t getTaskSize() const { return task_size_; }
+
+    /**
+     * @brief Contracts per pipeline chunk
+     * @throws std::invalid_argument if rows is 0
+     */
+    void setChunkRows(std::size_t rows);
+
+    /**
+     * @brief Contracts per pricing task within a chunk
+     * @throws std::invalid_argument if size is 0
+     */
+    void setTaskSize(std::size_t size);
+
+private:
+    std::shared_ptr<ThreadPool> thread_pool_;
+    std::size_t chunk_rows_ = 65536;
+    std::size_t task_size_ = 256;
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_BATCH_IO_H
@@ -1,12 +1,25 @@
 #ifndef OPTIONS_PRICER_BINOMIAL_H
 #define OPTIONS_PRICER_BINOMIAL_H
 
+#include "contract.h"
 #include "engine.h"
+#include "thread_pool.h"
+#include <functional>
+#include <span>
 #include <vector>
 #include <tuple>
+#include <utility>
 
 namespace pricer {
 
+/**
+ * @brief How the backward induction stores the lattice
+ */
+enum class TreeStorage {
+    Rolling,  ///< One layer of O(N) values updated in place
+    FullTree  ///< Every node of the triangle, O(N^2) memory
+};
+
 /**
  * @brief Cox-Ross-Rubinstein binomial tree implementation
  */
@@ -19,24 +32,96 @@ public:
      */
     explicit BinomialTreeEngine(size_t num_steps = 100, bool use_bbs = true);
 
-    [[nodiscard]] double calculate(const Option& option) const override;
-    [[nodiscard]] double calculateDelta(const Option& option) const override;
-    [[nodiscard]] double calculateGamma(const Option& option) const override;
-    [[nodiscard]] double calculateTheta(const Option& option) const override;
-    [[nodiscard]] double calculateVega(const Option& option) const override;
-    [[nodiscard]] double calculateRho(const Option& option) const override;
+    [[nodiscard]] double calculate(const OptionParameters& option) const override;
+
+    /**
+     * @brief Delta, gamma and theta are read off the lattice of the pricing
+     *        tree(s), so each costs what the price does
+     */
+    [[nodiscard]] double calculateDelta(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateGamma(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateTheta(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateVega(const OptionParameters& option) const override;
+    [[nodiscard]] double calculateRho(const OptionParameters& option) const override;
+
+    /**
+     * @brief Price, delta, gamma and theta from one tree per step count
+     *
+     * The tree starts two steps before today, so delta and gamma come from
+     * today's three nodes and theta from a central difference in time around
+     * them; vega and rho are still bumped.
+     */
+    [[nodiscard]] PricingResult calculateAll(const OptionParameters& option) const override;
+
+    /**
+     * @brief Price every contract of a batch
+     *
+     * The contracts are grouped by option type and exercise style, and each
+     * group runs the tree specialized for its type and style. Within a group,
+     * contracts on the same spot, volatility and expiry run together on one
+     * pool task and share the spot nodes of their rolling trees, so a chain
+     * builds them once per underlying and expiry rather than once per strike.
+     * @param batch Contracts and their market inputs
+     * @param out Receives one price per contract
+     * @throws std::invalid_argument if out has the wrong length
+     */
+    void priceBatch(const ContractBatch& batch, std::span<double> out) const override;
+
+    /**
+     * @brief calculateAll of a batch range, grouped and scheduled as in priceBatch
+     */
+    void calculateAllBatch(const ContractBatch& batch,
+                           std::size_t begin,
+                           std::span<PricingResult> out) const override;
 
     // Getters
     [[nodiscard]] size_t getNumSteps() const { return num_steps_; }
     [[nodiscard]] bool getUseBBS() const { return use_bbs_; }
+    [[nodiscard]] TreeStorage getTreeStorage() const { return storage_; }
 
     // Setters
     void setNumSteps(const size_t steps) { num_steps_ = steps; }
     void setUseBBS(const bool use_bbs) { use_bbs_ = use_bbs; }
 
+    /**
+     * @brief Choose between rolling and full-tree induction
+     *
+     * Rolling (the default) keeps a few O(N) buffers, so trees of 10k+
+     * steps stay in cache; FullTree materializes every node and gives the
+     * same results up to rounding.
+     */
+    void setTreeStorage(const TreeStorage storage) { storage_ = storage; }
+
+    /**
+     * @brief Schedule the extrapolation trees on a specific pool
+     * @param pool Pool to use, or nullptr for ThreadPool::global()
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { thread_pool_ = std::move(pool); }
+
 private:
     size_t num_steps_;
     bool use_bbs_;
+    TreeStorage storage_ = TreeStorage::Rolling;
+    std::shared_ptr<ThreadPool> thread_pool_;
+
+    // Layers before today in the extended tree
+    static constexpr size_t kExtraLayers = 2;
+
+    // Most contracts of a batch that share one pool task and its spot lattices
+    static constexpr size_t kLatticeRun = 16;
+
+    /**
+     * @brief Spot nodes of an extended rolling tree; they depend only on the
+     *        spot, the volatility and the time step, so strikes share them
+     */
+    struct SpotLattice {
+        double up;                      ///< u = e^{sigma sqrt(dt)}
+        double down;                    ///< d = 1 / u
+        std::vector<double> ladder;     ///< ladder[layers + m] = S u^m for |m| <= layers
+        std::vector<double> levels[2];  ///< Even and odd rungs, filled for early exercise
+    };
+
+    class LatticeCache;
 
     /**
      * @brief Calculate option price with specified number of steps
@@ -44,26 +129,86 @@ private:
      * @param steps Number of steps to use
      * @return Option price
      */
-    [[nodiscard]] double calculateWithParameters(const Option& option, size_t steps) const;
+    [[nodiscard]] double calculateWithParameters(const OptionParameters& option, size_t steps) const;
+
+    /**
+     * @brief Price an extended tree and read delta, gamma and theta off its first layers
+     * @param option Option being priced
+     * @param steps Number of steps from today to expiry
+     * @return Price, delta, gamma and theta; vega and rho are left at zero
+     */
+    [[nodiscard]] PricingResult calculateLattice(const OptionParameters& option, size_t steps) const;
+
+    /**
+     * @brief calculateLattice for an option of type Type and style Style
+     * @param cache Spot lattices to reuse and extend, or nullptr to build one for this tree
+     */
+    template <OptionType Type, ExerciseStyle Style>
+    [[nodiscard]] PricingResult calculateLatticeKernel(const OptionParameters& option, size_t steps,
+                                                       LatticeCache* cache = nullptr) const;
+
+    /**
+     * @brief Spot nodes of the rolling tree with the given layers and time step
+     * @param american Whether to fill the parity-split levels early exercise reads
+     */
+    [[nodiscard]] static SpotLattice buildSpotLattice(const OptionParameters& option, size_t layers,
+                                                      double dt, bool american);
+
+    /**
+     * @brief calculateLattice with a single in-place layer of node values
+     * @param option Option being priced
+     * @param lattice Spot nodes of the extended tree, kExtraLayers more steps than to expiry
+     * @param dt Time step size
+     */
+    template <OptionType Type, ExerciseStyle Style>
+    [[nodiscard]] PricingResult calculateRollingLattice(const OptionParameters& option,
+                                                        const SpotLattice& lattice, double dt) const;
+
+    /**
+     * @brief Price and Greeks of one batch contract, with every tree on the calling thread
+     */
+    template <OptionType Type, ExerciseStyle Style>
+    [[nodiscard]] PricingResult calculateContract(const OptionParameters& option, bool greeks,
+                                                  LatticeCache& cache) const;
+
+    /**
+     * @brief Shared body of priceBatch and calculateAllBatch
+     * @param store Receives the index relative to begin and the result of each contract
+     * @param greeks Whether to bump for vega and rho
+     */
+    void calculateBatch(const ContractBatch& batch, size_t begin, size_t count,
+                        const std::function<void(size_t, const PricingResult&)>& store,
+                        bool greeks) const;
+
+    /**
+     * @brief Lattice price and Greeks of the configured tree, extrapolated if BBS is on
+     */
+    [[nodiscard]] PricingResult calculateLatticeGreeks(const OptionParameters& option) const;
 
     /**
      * @brief Build price tree for underlying asset
      * @param option Option parameters
+     * @param steps Number of time steps in the tree
+     * @param dt Time step size
      * @return Vector containing price tree nodes
      */
-    [[nodiscard]] std::vector<double> buildPriceTree(const Option& option) const;
+    [[nodiscard]] std::vector<double> buildPriceTree(const OptionParameters& option, size_t steps, double dt) const;
 
     /**
-     * @brief Calculate option values at each node
+     * @brief Calculate option values at each node, checking for early
+     *        exercise if Style is American
      * @param option Option parameters
      * @param price_tree Underlying price tree
-     * @param american Whether to check for early exercise
+     * @param steps Number of time steps in the tree
+     * @param dt Time step size
      * @return Vector containing option values at each node
      */
+    template <OptionType Type, ExerciseStyle Style>
     [[nodiscard]] std::vector<double> calculateOptionValues(
-        const Option& option,
+        const OptionParameters& option,
         const std::vector<double>& price_tree,
-        bool american) const;
+        size_t steps,
+        double dt) const;
 
     /**
      * @brief Calculate tree parameters (up, down, probability)
@@ -72,28 +217,16 @@ private:
      * @return Tuple of (up_factor, down_factor, probability)
      */
     static std::tuple<double, double, double> calculateParameters(
-        const Option& option,
+        const OptionParameters& option,
         double dt) ;
 
     /**
-     * @brief Apply Black-Scholes-Richardson extrapolation
-     * @param option Option parameters
-     * @param value Initial binomial value
-     * @return Extrapolated option value
-     */
-    [[nodiscard]] double applyBBSExtrapolation(
-        const Option& option,
-        double value) const;
-
-    /**
-     * @brief Calculate payoff at given spot price
+     * @brief Evaluate the num_steps_ and 2 * num_steps_ trees concurrently
      * @param option Option parameters
-     * @param spot_price Current spot price
-     * @return Option payoff
+     * @return Lattice results of the coarse and the fine tree
      */
-    static double calculatePayoff(
-        const Option& option,
-        double spot_price);
+    [[nodiscard]] std::pair<PricingResult, PricingResult> calculateLatticePair(
+        const OptionParameters& option) const;
 
     /**
      * @brief Convert step and node numbers to array index
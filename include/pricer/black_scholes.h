@@ -6,7 +6,10 @@
 #define OPTIONS_PRICER_BLACK_SCHOLES_H
 
 #include "engine.h"
+#include "normal.h"
+#include "thread_pool.h"
 #include <memory>
+#include <span>
 
 namespace pricer {
 
@@ -15,18 +18,91 @@ namespace pricer {
   */
  class BlackScholesPricingEngine : public PricingEngine {
  public:
-  [[nodiscard]] double calculate(const Option& option) const override;
-  [[nodiscard]] double calculateDelta(const Option& option) const override;
-  [[nodiscard]] double calculateGamma(const Option& option) const override;
-  [[nodiscard]] double calculateTheta(const Option& option) const override;
-  [[nodiscard]] double calculateVega(const Option& option) const override;
-  [[nodiscard]] double calculateRho(const Option& option) const override;
+  [[nodiscard]] double calculate(const OptionParameters& option) const override;
+  [[nodiscard]] double calculateDelta(const OptionParameters& option) const override;
+  [[nodiscard]] double calculateGamma(const OptionParameters& option) const override;
+  [[nodiscard]] double calculateTheta(const OptionParameters& option) const override;
+  [[nodiscard]] double calculateVega(const OptionParameters& option) const override;
+  [[nodiscard]] double calculateRho(const OptionParameters& option) const override;
+  [[nodiscard]] PricingResult calculateAll(const OptionParameters& option) const override;
+
+  /**
+   * @brief Price a whole chain from structure-of-arrays inputs
+   *
+   * Evaluates every contract with branch-free vectorized exp/log/N(x)
+   * kernels instead of one virtual call and one Option per contract.
+   * All spans must have the same length; element i of each input
+   * describes contract i and its price is written to out[i]. Long chains
+   * are split into fixed-size chunks that run on the thread pool.
+   *
+   * @param spot Spot prices
+   * @param strike Strike prices
+   * @param expiry Times to expiry in years
+   * @param rate Risk-free rates
+   * @param volatility Volatilities
+   * @param dividend Dividend yields
+   * @param type Call/put flags
+   * @param out Receives the prices
+   * @throws std::invalid_argument on mismatched lengths or invalid parameters
+   */
+  void priceBatch(std::span<const double> spot,
+                  std::span<const double> strike,
+                  std::span<const double> expiry,
+                  std::span<const double> rate,
+                  std::span<const double> volatility,
+                  std::span<const double> dividend,
+                  std::span<const OptionType> type,
+                  std::span<double> out) const;
+
+  /**
+   * @brief Price every contract of a batch
+   *
+   * Reads the batch's arrays in place, with the discount factors, sqrt(T)
+   * and forward of each contract taken from the batch's expiry terms.
+   * Like calculate(), the exercise style is ignored and every contract is
+   * priced as European.
+   * @param batch Contracts and their market inputs
+   * @param out Receives one price per contract
+   * @throws std::invalid_argument if out has the wrong length
+   */
+  void priceBatch(const ContractBatch& batch, std::span<double> out) const override;
+
+  /**
+   * @brief Price and Greeks of a batch range with the vectorized chain kernel
+   *
+   * Same results as calculateAll up to rounding; the exercise style is
+   * ignored as in priceBatch.
+   */
+  void calculateAllBatch(const ContractBatch& batch,
+                         std::size_t begin,
+                         std::span<PricingResult> out) const override;
+
+  /**
+   * @brief Schedule batch chunks on a specific pool
+   * @param pool Pool to use, or nullptr for ThreadPool::global()
+   */
+  void setThreadPool(std::shared_ptr<ThreadPool> pool) { thread_pool_ = std::move(pool); }
+
+  /**
+   * @brief Normal CDF tier used by every pricing path of this engine
+   *
+   * Full (the default) keeps relative precision deep in the tails; Fast
+   * trades that for throughput on the batch kernels.
+   */
+  void setNormalAccuracy(NormalAccuracy accuracy) { accuracy_ = accuracy; }
+  [[nodiscard]] NormalAccuracy getNormalAccuracy() const { return accuracy_; }
 
  private:
+  std::shared_ptr<ThreadPool> thread_pool_;
+  NormalAccuracy accuracy_ = NormalAccuracy::Full;
+
+  // Contracts per pool task in priceBatch
+  static constexpr std::size_t kBatchChunk = 4096;
+
   static double calculateD1(double S, double K, double r, double q,
                           double sigma, double T);
   static double calculateD2(double d1, double sigma, double T);
-  static double normalCDF(double x);
+  [[nodiscard]] double normalCDF(double x) const;
   static double normalPDF(double x);
  };
 
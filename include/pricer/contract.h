@@ -0,0 +1,156 @@
+//
+// Plain value types describing contracts and market inputs for bulk pricing.
+//
+
+#ifndef OPTIONS_PRICER_CONTRACT_H
+#define OPTIONS_PRICER_CONTRACT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Enumeration for option types
+ */
+enum class OptionType {
+    Call,
+    Put
+};
+
+/**
+ * @brief Enumeration for exercise styles
+ */
+enum class ExerciseStyle {
+    European,
+    American
+};
+
+/**
+ * @brief Terms of a vanilla option contract
+ */
+struct ContractSpec {
+    double strike = 0.0;
+    double expiry = 0.0;  ///< Time to expiry in years
+    OptionType type = OptionType::Call;
+    ExerciseStyle exercise = ExerciseStyle::European;
+};
+
+/**
+ * @brief Market inputs of one underlying
+ */
+struct MarketState {
+    double spot = 0.0;
+    double rate = 0.0;        ///< Continuously compounded risk-free rate
+    double volatility = 0.0;
+    double dividend = 0.0;    ///< Continuous dividend yield
+};
+
+/**
+ * @brief Terms every contract on one underlying and expiry shares
+ *
+ * Only the volatility, strike and type are left per contract, so the batch
+ * kernels skip two exponentials and a square root for every contract whose
+ * spot, rate, dividend and expiry were seen before.
+ */
+struct ExpiryTerms {
+    double sqrt_expiry;        ///< sqrt(T)
+    double rate_discount;      ///< e^{-rT}
+    double dividend_discount;  ///< e^{-qT}
+    double log_forward;        ///< ln(S e^{(r-q)T})
+};
+
+static_assert(std::is_trivially_copyable_v<ContractSpec> && std::is_standard_layout_v<ContractSpec>);
+static_assert(std::is_trivially_copyable_v<MarketState> && std::is_standard_layout_v<MarketState>);
+static_assert(std::is_trivially_copyable_v<ExpiryTerms> && std::is_standard_layout_v<ExpiryTerms>);
+
+/**
+ * @brief Check a contract and its market inputs
+ * @throws std::invalid_argument if strike, expiry, spot or volatility is not
+ *         positive, or the dividend yield is negative
+ */
+void validate(const ContractSpec& contract, const MarketState& market);
+
+/**
+ * @brief Contiguous structure-of-arrays store of contracts with their market inputs
+ *
+ * Every field lives in its own array, so a book of millions of contracts
+ * is a handful of allocations, and the batch kernels read the arrays
+ * directly.
+ *
+ * The batch also keeps one ExpiryTerms per distinct (spot, rate, dividend,
+ * expiry), keyed by those values and computed when the first contract with
+ * them is added. Market inputs only enter through add(), so the terms can
+ * never disagree with them; clear() drops both.
+ */
+class ContractBatch {
+public:
+    ContractBatch() = default;
+
+    /**
+     * @brief Append a contract
+     * @throws std::invalid_argument if the parameters are invalid
+     */
+    void add(const ContractSpec& contract, const MarketState& market);
+
+    void reserve(std::size_t count);
+    void clear();
+
+    [[nodiscard]] std::size_t size() const { return strike_.size(); }
+    [[nodiscard]] bool empty() const { return strike_.empty(); }
+
+    [[nodiscard]] ContractSpec contract(std::size_t i) const {
+        return {strike_[i], expiry_[i], type_[i], exercise_[i]};
+    }
+    [[nodiscard]] MarketState market(std::size_t i) const {
+        return {spot_[i], rate_[i], volatility_[i], dividend_[i]};
+    }
+
+    [[nodiscard]] std::span<const double> strikes() const { return strike_; }
+    [[nodiscard]] std::span<const double> expiries() const { return expiry_; }
+    [[nodiscard]] std::span<const OptionType> types() const { return type_; }
+    [[nodiscard]] std::span<const ExerciseStyle> exercises() const { return exercise_; }
+    [[nodiscard]] std::span<const double> spots() const { return spot_; }
+    [[nodiscard]] std::span<const double> rates() const { return rate_; }
+    [[nodiscard]] std::span<const double> volatilities() const { return volatility_; }
+    [[nodiscard]] std::span<const double> dividends() const { return dividend_; }
+
+    // Per contract, the index of its entry in expiryTerms()
+    [[nodiscard]] std::span<const std::uint32_t> termIndices() const { return term_index_; }
+    [[nodiscard]] std::span<const ExpiryTerms> expiryTerms() const { return terms_; }
+
+private:
+    struct TermKey {
+        double spot;
+        double rate;
+        double dividend;
+        double expiry;
+
+        bool operator==(const TermKey&) const = default;
+    };
+
+    struct TermKeyHash {
+        std::size_t operator()(const TermKey& key) const;
+    };
+
+    std::vector<double> strike_;
+    std::vector<double> expiry_;
+    std::vector<OptionType> type_;
+    std::vector<ExerciseStyle> exercise_;
+    std::vector<double> spot_;
+    std::vector<double> rate_;
+    std::vector<double> volatility_;
+    std::vector<double> dividend_;
+
+    std::vector<std::uint32_t> term_index_;
+    std::vector<ExpiryTerms> terms_;
+    std::unordered_map<TermKey, std::uint32_t, TermKeyHash> term_lookup_;
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_CONTRACT_H
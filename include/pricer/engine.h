@@ -6,6 +6,9 @@
 #define OPTIONS_PRICER_ENGINE_H
 
 #include "option.h"
+#include <cstddef>
+#include <span>
+#include <stdexcept>
 
 namespace pricer {
 
@@ -24,42 +27,98 @@ namespace pricer {
          * @param option The option to price
          * @return The calculated price
          */
-        [[nodiscard]] virtual double calculate(const Option& option) const = 0;
+        [[nodiscard]] virtual double calculate(const OptionParameters& option) const = 0;
 
         /**
          * @brief Calculate option's delta
          * @param option The option to calculate delta for
          * @return The calculated delta
          */
-        [[nodiscard]] virtual double calculateDelta(const Option& option) const = 0;
+        [[nodiscard]] virtual double calculateDelta(const OptionParameters& option) const = 0;
 
         /**
          * @brief Calculate option's gamma
          * @param option The option to calculate gamma for
          * @return The calculated gamma
          */
-        [[nodiscard]] virtual double calculateGamma(const Option& option) const = 0;
+        [[nodiscard]] virtual double calculateGamma(const OptionParameters& option) const = 0;
 
         /**
          * @brief Calculate option's theta
          * @param option The option to calculate theta for
          * @return The calculated theta
          */
-        [[nodiscard]] virtual double calculateTheta(const Option& option) const = 0;
+        [[nodiscard]] virtual double calculateTheta(const OptionParameters& option) const = 0;
 
         /**
          * @brief Calculate option's vega
          * @param option The option to calculate vega for
          * @return The calculated vega
          */
-        [[nodiscard]] virtual double calculateVega(const Option& option) const = 0;
+        [[nodiscard]] virtual double calculateVega(const OptionParameters& option) const = 0;
 
         /**
          * @brief Calculate option's rho
          * @param option The option to calculate rho for
          * @return The calculated rho
          */
-        [[nodiscard]] virtual double calculateRho(const Option& option) const = 0;
+        [[nodiscard]] virtual double calculateRho(const OptionParameters& option) const = 0;
+
+        /**
+         * @brief Calculate price and all Greeks in one evaluation
+         *
+         * The default calls each method above in turn; engines override it
+         * to share intermediate terms between the price and the Greeks.
+         * @param option The option to evaluate
+         * @return The calculated price and Greeks
+         */
+        [[nodiscard]] virtual PricingResult calculateAll(const OptionParameters& option) const {
+            return {calculate(option),
+                    calculateDelta(option),
+                    calculateGamma(option),
+                    calculateTheta(option),
+                    calculateVega(option),
+                    calculateRho(option)};
+        }
+
+        /**
+         * @brief Price every contract of a batch
+         *
+         * The default calls calculate once per contract; engines with a
+         * batch kernel override it.
+         * @param batch Contracts and their market inputs
+         * @param out Receives one price per contract
+         * @throws std::invalid_argument if out has the wrong length
+         */
+        virtual void priceBatch(const ContractBatch& batch, std::span<double> out) const {
+            if (out.size() != batch.size()) {
+                throw std::invalid_argument("Batch inputs must all have the same length");
+            }
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out[i] = calculate({batch.contract(i), batch.market(i)});
+            }
+        }
+
+        /**
+         * @brief Price and Greeks of consecutive contracts of a batch
+         *
+         * The default calls calculateAll once per contract; engines with a
+         * batch kernel override it.
+         * @param batch Contracts and their market inputs
+         * @param begin First contract to evaluate
+         * @param out Receives the results of contracts begin, begin + 1, ...
+         * @throws std::out_of_range if the range exceeds the batch
+         */
+        virtual void calculateAllBatch(const ContractBatch& batch,
+                                       std::size_t begin,
+                                       std::span<PricingResult> out) const {
+            if (begin + out.size() > batch.size()) {
+                throw std::out_of_range("Batch range exceeds the batch size");
+            }
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out[i] = calculateAll({batch.contract(begin + i), batch.market(begin + i)});
+            }
+        }
     };
 
 } // namespace pricer
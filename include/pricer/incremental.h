@@ -0,0 +1,123 @@
+//
+// Incremental book repricing driven by which market inputs changed.
+//
+
+#ifndef OPTIONS_PRICER_INCREMENTAL_H
+#define OPTIONS_PRICER_INCREMENTAL_H
+
+#include "contract.h"
+#include "engine.h"
+#include "portfolio.h"
+#include "thread_pool.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Keeps a book's results current by repricing only what moved
+ *
+ * Positions reference an underlying, whose spot, volatility, rate and
+ * dividend are set individually. Each setter marks the underlying dirty,
+ * and reprice() recomputes only the positions of dirty underlyings (and
+ * positions added since the last call) through a PortfolioPricer. Book
+ * totals are updated by the change of each recomputed position.
+ *
+ * With a Taylor threshold set, a position whose underlying only moved in
+ * spot, by at most that fraction of the spot at its last full pricing, is
+ * updated from the delta and gamma of that pricing instead:
+ * V + delta dS + gamma dS^2 / 2, delta + gamma dS. Its theta, vega and rho
+ * keep their last full values.
+ */
+class IncrementalPricer {
+public:
+    /**
+     * @param pool Pool for the repricing, or nullptr for ThreadPool::global()
+     */
+    explicit IncrementalPricer(std::shared_ptr<ThreadPool> pool = nullptr);
+
+    /**
+     * @brief Register an underlying
+     * @return Its index
+     */
+    std::size_t addUnderlying(const MarketState& market);
+
+    /**
+     * @brief Add a position on a registered underlying; it is priced on the next reprice()
+     * @return Index of the position
+     * @throws std::out_of_range if the underlying does not exist
+     * @throws std::invalid_argument if the engine is null or the parameters are invalid
+     */
+    std::size_t addPosition(const ContractSpec& contract,
+                            std::size_t underlying,
+                            double quantity,
+                            std::shared_ptr<const PricingEngine> engine);
+
+    // Market updates; each marks the underlying dirty and throws
+    // std::invalid_argument for values an Option would reject
+    void setSpot(std::size_t underlying, double spot);
+    void setVolatility(std::size_t underlying, double volatility);
+    void setRate(std::size_t underlying, double rate);
+    void setDividend(std::size_t underlying, double dividend);
+
+    [[nodiscard]] const MarketState& market(std::size_t underlying) const {
+        return underlyings_[underlying].market;
+    }
+
+    /**
+     * @brief Largest relative spot move served by the Taylor update
+     * @param relative_move Fraction of the spot, 0 (the default) to always reprice
+     */
+    void setTaylorThreshold(double relative_move) { taylor_threshold_ = relative_move; }
+    [[nodiscard]] double getTaylorThreshold() const { return taylor_threshold_; }
+
+    /**
+     * @brief Bring every result up to date with the current market
+     * @return Per-position and book results
+     */
+    const PortfolioResult& reprice();
+
+    [[nodiscard]] const PortfolioResult& result() const { return result_; }
+    [[nodiscard]] std::size_t size() const { return positions_.size(); }
+
+    // Positions fully repriced and Taylor-updated by the last reprice()
+    [[nodiscard]] std::size_t lastRepriced() const { return last_repriced_; }
+    [[nodiscard]] std::size_t lastApproximated() const { return last_approximated_; }
+
+private:
+    struct Underlying {
+        MarketState market;
+        bool spot_moved = false;
+        bool other_moved = false;  // volatility, rate or dividend
+        std::vector<std::size_t> positions;
+    };
+
+    struct Position {
+        ContractSpec contract;
+        std::size_t underlying;
+        double quantity;
+        std::shared_ptr<const PricingEngine> engine;
+        double anchor_spot = 0.0;  // spot of the last full pricing
+        PricingResult anchor;      // result of the last full pricing
+    };
+
+    PortfolioPricer pricer_;
+    double taylor_threshold_ = 0.0;
+
+    std::vector<Underlying> underlyings_;
+    std::vector<Position> positions_;
+    std::vector<std::size_t> dirty_underlyings_;
+    std::vector<std::size_t> new_positions_;
+
+    PortfolioResult result_;
+    std::size_t last_repriced_ = 0;
+    std::size_t last_approximated_ = 0;
+
+    void markDirty(std::size_t underlying, bool spot_only);
+    void update(std::size_t position, const PricingResult& value);
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_INCREMENTAL_H
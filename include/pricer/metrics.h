@@ -0,0 +1,215 @@
+//
+// Opt-in hot-path counters and latency histograms of the pricing engines.
+//
+
+#ifndef OPTIONS_PRICER_METRICS_H
+#define OPTIONS_PRICER_METRICS_H
+
+#include "thread_pool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Compile-time switch for the engine metrics points
+ *
+ * When 0 every PRICER_METRICS_* macro expands to nothing. When 1 (the
+ * default) a metrics point costs one relaxed atomic load and a branch until
+ * collection is switched on with metrics::setEnabled().
+ */
+#ifndef OPTIONS_PRICER_ENABLE_METRICS
+#define OPTIONS_PRICER_ENABLE_METRICS 1
+#endif
+
+namespace pricer {
+
+/**
+ * @brief Engines that report metrics
+ */
+enum class MetricsEngine {
+    BlackScholes,
+    MonteCarlo,
+    BinomialTree,
+    FiniteDifference,
+    AmericanApproximation
+};
+
+inline constexpr std::size_t kMetricsEngines = 5;
+
+/**
+ * @brief Work units counted next to the call latencies
+ */
+enum class MetricsCounter {
+    Paths,  ///< Monte Carlo paths simulated
+    Nodes   ///< Tree or grid nodes evaluated
+};
+
+/**
+ * @brief Call latencies in power-of-two nanosecond buckets
+ *
+ * Bucket b counts calls that took [2^b, 2^(b+1)) ns; bucket 0 also holds
+ * calls under 1 ns and the last bucket everything slower.
+ */
+struct LatencyHistogram {
+    static constexpr std::size_t kBuckets = 40;
+
+    std::array<std::uint64_t, kBuckets> counts{};
+
+    [[nodiscard]] std::uint64_t total() const;
+
+    /**
+     * @brief Upper edge in ns of the bucket holding the q-quantile
+     * @param q Quantile in [0, 1]
+     * @return 0 for an empty histogram
+     */
+    [[nodiscard]] double quantile(double q) const;
+};
+
+/**
+ * @brief Counters of one engine since the last reset
+ *
+ * Only the outermost timed call on a thread is recorded, so an engine
+ * whose calculateAll calls calculate counts one call, not several. Work
+ * counters include the pool tasks that helped with the call.
+ */
+struct EngineMetrics {
+    std::uint64_t calls = 0;
+    std::uint64_t contracts = 0;  ///< Contracts priced; batch calls add their length
+    std::uint64_t total_ns = 0;
+    std::uint64_t paths = 0;
+    std::uint64_t nodes = 0;
+    LatencyHistogram latency;
+
+    [[nodiscard]] double nanosecondsPerCall() const;
+    [[nodiscard]] double nanosecondsPerContract() const;
+    [[nodiscard]] double pathsPerSecond() const;
+    [[nodiscard]] double nodesPerSecond() const;
+};
+
+/**
+ * @brief Point-in-time copy of every metric, safe to read and export
+ */
+struct PricingMetrics {
+    std::array<EngineMetrics, kMetricsEngines> engines{};
+    ThreadPoolMetrics thread_pools;  ///< Summed over every live pool
+
+    [[nodiscard]] const EngineMetrics& engine(const MetricsEngine e) const {
+        return engines[static_cast<std::size_t>(e)];
+    }
+};
+
+namespace metrics {
+
+namespace detail {
+    inline std::atomic<bool> enabled{false};
+    inline thread_local unsigned timer_depth = 0;
+}
+
+/**
+ * @brief Whether the engines are recording
+ */
+[[nodiscard]] inline bool enabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Switch collection on or off for every thread
+ *
+ * Counters keep their values while collection is off.
+ */
+void setEnabled(bool on);
+
+/**
+ * @brief Zero every engine counter; thread-pool counters belong to the pools
+ */
+void reset();
+
+/**
+ * @brief Copy the current counters
+ *
+ * Counters are read one by one while other threads may still be
+ * recording, so totals taken during a run can be off by the calls in flight.
+ */
+[[nodiscard]] PricingMetrics snapshot();
+
+/**
+ * @brief Display name of an engine, e.g. "Black-Scholes"
+ */
+[[nodiscard]] std::string_view engineName(MetricsEngine engine);
+
+/**
+ * @brief Record one completed call
+ * @param engine Engine that was called
+ * @param nanoseconds Wall time of the call
+ * @param contracts Contracts priced by the call
+ */
+void recordCall(MetricsEngine engine, std::uint64_t nanoseconds, std::uint64_t contracts);
+
+/**
+ * @brief Add to a work counter of an engine
+ */
+void add(MetricsEngine engine, MetricsCounter counter, std::uint64_t amount);
+
+/**
+ * @brief Times a call from construction to destruction
+ *
+ * Does nothing when collection is off at construction, or when another
+ * timer is already running on this thread.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const MetricsEngine engine, const std::uint64_t contracts = 1)
+        : engine_(engine), contracts_(contracts), active_(enabled() && detail::timer_depth == 0) {
+        if (active_) {
+            ++detail::timer_depth;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (active_) {
+            const auto elapsed = std::chrono::steady_clock::now() - start_;
+            --detail::timer_depth;
+            recordCall(engine_, static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), contracts_);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    MetricsEngine engine_;
+    std::uint64_t contracts_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace metrics
+} // namespace pricer
+
+/**
+ * @brief Time the rest of the enclosing scope as one call of an engine
+ *
+ * Optional second argument: contracts priced by the call (default 1).
+ */
+#if OPTIONS_PRICER_ENABLE_METRICS
+#define PRICER_METRICS_TIMER(...) \
+    const ::pricer::metrics::ScopedTimer pricer_metrics_timer_(__VA_ARGS__)
+#define PRICER_METRICS_ADD(engine, counter, amount)                          \
+    do {                                                                     \
+        if (::pricer::metrics::enabled()) {                                  \
+            ::pricer::metrics::add((engine), (counter), (amount));           \
+        }                                                                    \
+    } while (0)
+#else
+#define PRICER_METRICS_TIMER(...) \
+    do {                          \
+    } while (0)
+#define PRICER_METRICS_ADD(engine, counter, amount) \
+    do {                                            \
+    } while (0)
+#endif
+
+#endif // OPTIONS_PRICER_METRICS_H
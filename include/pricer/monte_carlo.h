@@ -6,13 +6,63 @@
 #define OPTIONS_PRICER_MONTE_CARLO_H
 
 #include "engine.h"
-#include <random>
+#include "payoff.h"
+#include "random.h"
+#include "sobol.h"
+#include "thread_pool.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace pricer {
 
+/**
+ * @brief How the simulation samples the underlying
+ */
+enum class PathSampling {
+    Automatic,  ///< Terminal sampling whenever the payoff only depends on S_T
+    Terminal,   ///< Always draw S_T directly from its lognormal law in one step
+    FullPath    ///< Always march all num_steps increments
+};
+
+/**
+ * @brief Where the normal draws of each path come from
+ */
+enum class SequenceType {
+    PseudoRandom,  ///< Counter-based random streams, O(1/sqrt(N)) convergence
+    Sobol          ///< Sobol points, close to O(1/N) for smooth integrands
+};
+
+/**
+ * @brief Payoff with a known expectation that the price is regressed against
+ */
+enum class ControlVariate {
+    None,
+    TerminalSpot,  ///< S_T, with expectation S e^{(r-q)T}
+    BlackScholes   ///< European payoff on the same strike, priced by BlackScholesPricingEngine
+};
+
+/**
+ * @brief How the simulation estimates the Greeks
+ *
+ * All three methods take their Greeks from the same paths as the price.
+ */
+enum class GreekMethod {
+    Pathwise,            ///< Differentiate each path's payoff (likelihood ratio for gamma)
+    LikelihoodRatio,     ///< Weight each payoff by the score of the S_T density
+    CommonRandomNumbers  ///< Finite differences of bumped scenarios on the same paths
+};
+
 /**
  * @brief Monte Carlo simulation engine for option pricing
+ *
+ * American options are priced by least-squares Monte Carlo (Longstaff and
+ * Schwartz): an exercise opportunity at every one of num_steps dates, with
+ * the continuation value regressed on a cubic in moneyness over the
+ * in-the-money paths.
  */
 class MonteCarloEngine final : public PricingEngine {
 public:
@@ -21,52 +71,338 @@ public:
      * @param num_paths Number of simulation paths
      * @param num_steps Number of time steps per path
      * @param use_antithetic Whether to use antithetic variates
-     * @param num_threads Number of threads (0 for auto)
+     * @param num_threads Most pool threads working on one call (0 for auto)
      */
     explicit MonteCarloEngine(size_t num_paths = 100000,
                             size_t num_steps = 252,
                             bool use_antithetic = true,
                             size_t num_threads = 0);
 
-    double calculate(const Option& option) const override;
-    double calculateDelta(const Option& option) const override;
-    double calculateGamma(const Option& option) const override;
-    double calculateTheta(const Option& option) const override;
-    double calculateVega(const Option& option) const override;
-    double calculateRho(const Option& option) const override;
+    double calculate(const OptionParameters& option) const override;
+    double calculateDelta(const OptionParameters& option) const override;
+    double calculateGamma(const OptionParameters& option) const override;
+    double calculateTheta(const OptionParameters& option) const override;
+    double calculateVega(const OptionParameters& option) const override;
+    double calculateRho(const OptionParameters& option) const override;
+
+    /**
+     * @brief Price and all Greeks from a single set of simulated paths
+     *
+     * The Greeks are estimated with the configured GreekMethod; none of the
+     * methods re-simulates, so a full Greek set costs one simulation. The
+     * result also carries the standard error of the price. American Greeks
+     * are finite differences of least-squares prices on common random
+     * numbers under the unbumped run's exercise rule, so they cost nine
+     * simulations. Path-dependent payoffs are bumped and repriced the same way.
+     */
+    PricingResult calculateAll(const OptionParameters& option) const override;
+
+    /**
+     * @brief Price and its standard error, without Greek estimators
+     * @return Result with price and std_error set
+     */
+    PricingResult simulate(const OptionParameters& option) const;
 
     // Getters
     size_t getNumPaths() const { return num_paths_; }
     size_t getNumSteps() const { return num_steps_; }
     bool getUseAntithetic() const { return use_antithetic_; }
+    ControlVariate getControlVariate() const { return control_variate_; }
     size_t getNumThreads() const { return num_threads_; }
+    PathSampling getPathSampling() const { return path_sampling_; }
+    GreekMethod getGreekMethod() const { return greek_method_; }
+    RandomGenerator getRandomGenerator() const { return random_generator_; }
+    std::uint64_t getSeed() const { return seed_; }
+    SequenceType getSequenceType() const { return sequence_type_; }
+    bool getScrambling() const { return scramble_; }
+    bool getBrownianBridge() const { return brownian_bridge_; }
+    size_t getReplicates() const { return replicates_; }
+    const Payoff& getPayoff() const { return payoff_; }
+    double getTargetStdError() const { return target_std_error_; }
+    std::chrono::nanoseconds getTimeBudget() const { return time_budget_; }
 
     // Setters
     void setNumPaths(size_t paths) { num_paths_ = paths; }
     void setNumSteps(size_t steps) { num_steps_ = steps; }
     void setUseAntithetic(bool use) { use_antithetic_ = use; }
+
+    /**
+     * @brief Regress the price on a control payoff simulated on the same paths
+     *
+     * The coefficient is estimated on the fly. The control adjusts the price
+     * and its standard error; the Greek estimators are left as they are.
+     */
+    void setControlVariate(ControlVariate control) { control_variate_ = control; }
     void setNumThreads(size_t threads) { num_threads_ = threads; }
+    void setPathSampling(PathSampling sampling) { path_sampling_ = sampling; }
+    void setGreekMethod(GreekMethod method) { greek_method_ = method; }
+    void setRandomGenerator(RandomGenerator generator) { random_generator_ = generator; }
+
+    /**
+     * @brief Key of the random streams
+     *
+     * Path i always reads stream i of this seed, so a price depends only on
+     * the seed and the settings above, not on threads or scheduling.
+     */
+    void setSeed(std::uint64_t seed) { seed_ = seed; }
+
+    /**
+     * @brief Quasi-Monte Carlo settings, used with SequenceType::Sobol
+     *
+     * With scrambling on, the paths are split into independently
+     * Owen-scrambled replicates, and the spread of their means is the
+     * standard error that getConfidenceInterval reports. Unscrambled points
+     * are deterministic, so the reported interval then falls back to the
+     * (pessimistic) per-path sample variance. The Brownian bridge assigns
+     * W_T to the first dimension and the finer path detail to later ones.
+     */
+    void setSequenceType(SequenceType type) { sequence_type_ = type; }
+    void setScrambling(bool scramble) { scramble_ = scramble; }
+    void setBrownianBridge(bool use) { brownian_bridge_ = use; }
+    void setReplicates(size_t replicates) { replicates_ = replicates; }
+
+    /**
+     * @brief Stop simulating once the price is known to a standard error
+     *
+     * Chunks of paths are simulated in waves on the pool and the running
+     * estimate is checked after each chunk, in index order, so the stopping
+     * point depends only on the seed and the settings, not on the threads.
+     * num_paths stays the upper limit and PricingResult::paths reports how
+     * many were used. Scrambled Sobol replicates always run every path.
+     * @param target Standard error of the discounted price, or 0 to run every path
+     */
+    void setTargetStdError(double target) { target_std_error_ = target; }
+
+    /**
+     * @brief Stop simulating after a wall-clock budget
+     *
+     * The budget is checked between waves of chunks, so a call can overrun
+     * it by one wave, and the paths used then depend on the machine.
+     * @param budget Longest time for one call, or 0 for no limit
+     */
+    void setTimeBudget(std::chrono::nanoseconds budget) { time_budget_ = budget; }
+
+    /**
+     * @brief Schedule the simulation on a specific pool
+     * @param pool Pool to use, or nullptr for ThreadPool::global()
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { thread_pool_ = std::move(pool); }
 
-    std::pair<double, double> getConfidenceInterval(const Option& option) const;
+    /**
+     * @brief Payoff to simulate, on the option's type and strike
+     *
+     * Path-dependent payoffs are monitored at every one of num_steps steps,
+     * unless PathSampling::Terminal asks for expiry only. Their kernels keep
+     * a running state per path (sum, extremes or barrier survival), so no
+     * path is ever stored. With Sobol points the steps take the dimensions
+     * in time order, without the Brownian bridge. They are European only.
+     * @throws std::invalid_argument if a barrier is not positive or a rebate is negative
+     */
+    void setPayoff(Payoff payoff);
+
+    /**
+     * @brief 95% confidence interval of the price
+     *
+     * Runs its own simulation; prefer the confidenceInterval() of a result
+     * already computed.
+     */
+    std::pair<double, double> getConfidenceInterval(const OptionParameters& option) const;
+
+    /**
+     * @brief Simulate one full price path into a caller-provided buffer
+     *
+     * Pricing itself never materializes paths; this is for path-dependent
+     * consumers that want every step without a per-path allocation. The
+     * path uses the same random stream as path path_index of a FullPath
+     * pricing run.
+     * @param option Option supplying the model parameters
+     * @param path_index Index of the path (and of its random stream)
+     * @param path Receives S_0 ... S_T; must hold getNumSteps() + 1 values
+     * @param antithetic Whether to negate the normal draws
+     * @throws std::invalid_argument if the buffer has the wrong size
+     */
+    void generatePath(const OptionParameters& option,
+                      std::uint64_t path_index,
+                      std::span<double> path,
+                      bool antithetic = false) const;
 
 private:
     size_t num_paths_;
     size_t num_steps_;
     bool use_antithetic_;
     size_t num_threads_;
+    ControlVariate control_variate_ = ControlVariate::None;
+    PathSampling path_sampling_ = PathSampling::Automatic;
+    GreekMethod greek_method_ = GreekMethod::Pathwise;
+    std::shared_ptr<ThreadPool> thread_pool_;
+    RandomGenerator random_generator_ = RandomGenerator::Philox4x32;
+    std::uint64_t seed_ = 0;
+    SequenceType sequence_type_ = SequenceType::PseudoRandom;
+    bool scramble_ = true;
+    bool brownian_bridge_ = true;
+    size_t replicates_ = 16;
+    Payoff payoff_;
+    double target_std_error_ = 0.0;
+    std::chrono::nanoseconds time_budget_{0};
+
+    // Paths advanced together through each time step
+    static constexpr size_t kPathBlock = 64;
+
+    // Paths per scheduled task; chunks are fixed so the summation order, and
+    // with it the estimate, does not depend on how many threads ran them
+    static constexpr size_t kChunkPaths = 8192;
+
+    /**
+     * @brief Number of time steps the simulation actually takes
+     *
+     * GBM log-increments are exact, so for payoffs that only read S_T a
+     * single step of length T has the same distribution as num_steps_ steps.
+     * Automatic sampling takes every step for path-dependent payoffs.
+     * @return 1 for terminal sampling, num_steps_ otherwise
+     */
+    size_t simulationSteps() const;
+
+    // Source of the normal draws of one simulation
+    struct PathDraws {
+        CounterBasedRng rng;
+        std::optional<SobolSequence> sobol;  // engaged for SequenceType::Sobol
+    };
+
+    PathDraws makeDraws(size_t steps) const;
+
+    // Randomized-QMC layout: replicate r owns paths [replicateBegin(r), replicateBegin(r + 1))
+    size_t replicateCount() const;
+    size_t replicateBegin(size_t replicate) const;
+    size_t replicateOf(std::uint64_t path) const;
+    std::uint32_t scrambleSeed(size_t replicate, size_t dim) const;
+
+    /**
+     * @brief Advance a block of paths from t = 0 to expiry
+     *
+     * Only the terminal log-return log(S_T / S_0) of each path is kept, and
+     * the per-step update is a plain loop across the block so it vectorizes.
+     * @param option Option supplying the model parameters
+     * @param steps Number of time steps to take
+     * @param draws Random streams or Sobol points
+     * @param first_path Index of the first path in the block
+     * @param count Number of paths in the block (at most kPathBlock)
+     * @param log_return Receives the log-returns
+     * @param anti_log_return Receives the antithetic log-returns, or nullptr
+     */
+    void evolveBlock(const OptionParameters& option,
+                     size_t steps,
+                     const PathDraws& draws,
+                     std::uint64_t first_path,
+                     size_t count,
+                     double* log_return,
+                     double* anti_log_return) const;
+
+    static double calculatePayoff(const OptionParameters& option, double final_price);
 
-    mutable double last_mean_;
-    mutable double last_stderr_;
+    // Control payoff of one path and its (undiscounted) expectation
+    double controlPayoff(const OptionParameters& option, double final_price) const;
+    double controlMean(const OptionParameters& option) const;
 
-    std::vector<double> generatePath(const Option& option,
-                                   std::mt19937& rng,
-                                   bool antithetic = false) const;
+    // Sums of payoff f and control y, and their centred second moments
+    // sum (f - mean f)^2, sum (y - mean y)^2 and sum (f - mean f)(y - mean y);
+    // every per-batch sum array starts with these
+    static constexpr size_t kNumMoments = 5;
+    using MomentSums = std::array<double, kNumMoments>;
 
-    static double calculatePayoff(const Option& option, double final_price);
+    MomentSums simulateBatch(const OptionParameters& option,
+                             size_t first_path,
+                             size_t num_paths) const;
 
-    std::pair<double, double> simulateBatch(const Option& option,
-                                          unsigned int seed,
-                                          size_t num_paths) const;
+    // Moments of a path-dependent payoff; visits payoff_ once per batch
+    MomentSums simulatePathBatch(const OptionParameters& option,
+                                 size_t first_path,
+                                 size_t num_paths) const;
+
+    /**
+     * @brief March blocks of paths through every monitoring date of a payoff kernel
+     *
+     * @param kernel One of the path::PathKernel implementations of src/path_payoff.h
+     */
+    template <typename Kernel>
+    MomentSums simulatePaths(Kernel kernel,
+                             const OptionParameters& option,
+                             size_t first_path,
+                             size_t num_paths) const;
+
+    // Moments, then the delta, gamma, vega, rho and expiry terms
+    static constexpr size_t kNumEstimators = kNumMoments + 5;
+    using EstimatorSums = std::array<double, kNumEstimators>;
+
+    /**
+     * @brief Simulate paths once and accumulate the pathwise or
+     *        likelihood-ratio estimator of every Greek
+     * @return Per-estimator sums (undiscounted)
+     */
+    EstimatorSums simulateEstimators(const OptionParameters& option,
+                                     size_t first_path,
+                                     size_t num_paths) const;
+
+    // Base case plus up/down bumps of spot, expiry, volatility and rate
+    static constexpr size_t kNumScenarios = 9;
+    using ScenarioSums = std::array<double, kNumMoments + kNumScenarios>;
+
+    /**
+     * @brief Simulate paths once and accumulate payoffs for every bump scenario
+     * @return Moments, followed by the per-scenario payoff sums (undiscounted)
+     */
+    ScenarioSums simulateScenarios(const OptionParameters& option,
+                                   size_t first_path,
+                                   size_t num_paths) const;
+
+    // Price and Greeks as common-random-number finite differences
+    PricingResult calculateBumped(const OptionParameters& option) const;
+
+    /**
+     * @brief Least-squares Monte Carlo price of an American option
+     *
+     * Paths are never stored: each one is drawn from its random stream
+     * backwards from W_T by Brownian bridging, so only the current spot and
+     * cash flow of every path are kept while the exercise dates are swept
+     * from expiry to today. Each date is one pass over the chunks on the
+     * pool, fusing the previous date's exercise decision with this date's
+     * regression sums, and the sums are reduced in chunk order. The random
+     * streams are always pseudo-random, and the target standard error and
+     * time budget do not apply.
+     * @param policy If given and empty, receives the fitted continuation
+     *        coefficients of every date; if given and filled, is used as
+     *        the exercise rule instead of fitting one
+     * @return Result with price, std_error and paths set
+     */
+    PricingResult simulateAmerican(const OptionParameters& option,
+                                   std::vector<double>* policy = nullptr) const;
+
+    // American price and Greeks as common-random-number finite differences
+    // under one fitted exercise policy
+    PricingResult calculateAmericanBumped(const OptionParameters& option) const;
+
+    // Summed batches with the undiscounted, control-variate adjusted mean
+    // payoff, its standard error and the number of paths behind them
+    template <typename Sums>
+    struct Batches {
+        Sums sums;
+        double mean;
+        double std_error;
+        size_t paths;
+    };
+
+    /**
+     * @brief Simulate up to num_paths_ paths as pool tasks and add up their sums
+     *
+     * Chunks are reduced in index order, merging the centred moments with
+     * Chan's pairwise update, so the result is reproducible. With a target
+     * standard error or time budget the chunks run in waves until either is
+     * met.
+     * @param batch Member returning the elementwise sums for (first path, paths),
+     *        starting with the moments
+     */
+    template <typename Sums>
+    Batches<Sums> runBatches(Sums (MonteCarloEngine::*batch)(const OptionParameters&, size_t, size_t) const,
+                    const OptionParameters& option) const;
 };
 
 // Factory function
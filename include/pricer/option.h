@@ -6,19 +6,103 @@
 #define OPTION_H
 
 
+#include "contract.h"
+#include <cstddef>
 #include <memory>
+#include <utility>
 
 namespace pricer {
 
 // Forward declarations
 class PricingEngine;
+class Option;
 
 /**
- * @brief Enumeration for option types
+ * @brief Price and Greeks produced by a single engine evaluation
+ *
+ * Units follow the Black-Scholes engine: theta is per calendar day,
+ * vega and rho are per 1% move in volatility and rate.
  */
-enum class OptionType {
-    Call,
-    Put
+struct PricingResult {
+    double price = 0.0;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double theta = 0.0;
+    double vega = 0.0;
+    double rho = 0.0;
+    double std_error = 0.0;  ///< Standard error of the price; 0 unless simulated
+    std::size_t paths = 0;   ///< Paths behind the price; 0 unless simulated
+
+    /**
+     * @brief Confidence interval of the price
+     * @param z_score Standard errors on either side (1.96 for 95%)
+     * @return Lower and upper bound
+     */
+    [[nodiscard]] std::pair<double, double> confidenceInterval(const double z_score = 1.96) const {
+        return {price - z_score * std_error, price + z_score * std_error};
+    }
+};
+
+/**
+ * @brief Immutable snapshot of the inputs an engine prices
+ *
+ * Engines only ever see snapshots, never the Option they came from, so one
+ * engine, and one Option, can be priced from many threads at once. Bumped
+ * scenarios are new snapshots made with the with* functions. A snapshot is
+ * just a ContractSpec and a MarketState, so engines can also price those
+ * directly, e.g. engine.calculate({contract, market}).
+ */
+class OptionParameters {
+public:
+    /**
+     * @brief Constructor with the same parameters and validation as Option
+     * @throws std::invalid_argument if parameters are invalid
+     */
+    OptionParameters(OptionType type,
+                     double strike,
+                     double expiry,
+                     double spot,
+                     double rate,
+                     double volatility,
+                     double dividend = 0.0,
+                     ExerciseStyle exercise = ExerciseStyle::European);
+
+    /**
+     * @brief Snapshot of an option's current parameters
+     *
+     * Implicit, so an Option can be passed wherever a snapshot is expected.
+     */
+    OptionParameters(const Option& option);  // NOLINT(google-explicit-constructor)
+
+    /**
+     * @brief Snapshot of a plain contract and its market inputs
+     * @throws std::invalid_argument if parameters are invalid
+     */
+    OptionParameters(const ContractSpec& contract, const MarketState& market);
+
+    [[nodiscard]] const ContractSpec& contract() const { return contract_; }
+    [[nodiscard]] const MarketState& market() const { return market_; }
+
+    [[nodiscard]] OptionType getType() const { return contract_.type; }
+    [[nodiscard]] double getStrike() const { return contract_.strike; }
+    [[nodiscard]] double getExpiry() const { return contract_.expiry; }
+    [[nodiscard]] double getSpot() const { return market_.spot; }
+    [[nodiscard]] double getRate() const { return market_.rate; }
+    [[nodiscard]] double getVolatility() const { return market_.volatility; }
+    [[nodiscard]] double getDividend() const { return market_.dividend; }
+    [[nodiscard]] ExerciseStyle getExercise() const { return contract_.exercise; }
+    [[nodiscard]] bool isAmerican() const { return contract_.exercise == ExerciseStyle::American; }
+
+    // Copies with one parameter replaced, validated like the Option setters
+    [[nodiscard]] OptionParameters withSpot(double spot) const;
+    [[nodiscard]] OptionParameters withRate(double rate) const;
+    [[nodiscard]] OptionParameters withVolatility(double volatility) const;
+    [[nodiscard]] OptionParameters withDividend(double dividend) const;
+    [[nodiscard]] OptionParameters withExpiry(double expiry) const;
+
+private:
+    ContractSpec contract_;
+    MarketState market_;
 };
 
 /**
@@ -47,6 +131,12 @@ public:
            double volatility,
            double dividend = 0.0);
 
+    /**
+     * @brief Constructor from plain contract terms and market inputs
+     * @throws std::invalid_argument if parameters are invalid
+     */
+    Option(const ContractSpec& contract, const MarketState& market);
+
     // Virtual destructor for proper inheritance
     virtual ~Option() = default;
 
@@ -95,6 +185,13 @@ public:
      */
     [[nodiscard]] virtual double rho() const;
 
+    /**
+     * @brief Calculate price and all Greeks in one engine evaluation
+     * @return The calculated price and Greeks
+     * @throws std::runtime_error if no pricing engine is set
+     */
+    [[nodiscard]] PricingResult calculateAll() const;
+
     /**
      * @brief Set the pricing engine for this option
      * @param engine Shared pointer to the pricing engine
@@ -102,14 +199,22 @@ public:
     void setPricingEngine(std::shared_ptr<PricingEngine> engine);
 
     // Getters
-    [[nodiscard]] OptionType getType() const { return type_; }
-    [[nodiscard]] double getStrike() const { return strike_; }
-    [[nodiscard]] double getExpiry() const { return expiry_; }
-    [[nodiscard]] double getSpot() const { return spot_; }
-    [[nodiscard]] double getRate() const { return rate_; }
-    [[nodiscard]] double getVolatility() const { return volatility_; }
-    [[nodiscard]] double getDividend() const { return dividend_; }
+    [[nodiscard]] OptionType getType() const { return contract_.type; }
+    [[nodiscard]] double getStrike() const { return contract_.strike; }
+    [[nodiscard]] double getExpiry() const { return contract_.expiry; }
+    [[nodiscard]] double getSpot() const { return market_.spot; }
+    [[nodiscard]] double getRate() const { return market_.rate; }
+    [[nodiscard]] double getVolatility() const { return market_.volatility; }
+    [[nodiscard]] double getDividend() const { return market_.dividend; }
     [[nodiscard]] const PricingEngine* getEngine() const { return engine_.get(); }
+    [[nodiscard]] ExerciseStyle getExercise() const { return contract_.exercise; }
+    [[nodiscard]] const ContractSpec& contract() const { return contract_; }
+    [[nodiscard]] const MarketState& market() const { return market_; }
+
+    /**
+     * @brief Snapshot of the current parameters, as passed to the engine
+     */
+    [[nodiscard]] OptionParameters parameters() const { return *this; }
 
     // Setters with validation
     void setSpot(double spot);
@@ -120,13 +225,8 @@ public:
 
 protected:
     // Option parameters
-    OptionType type_;
-    double strike_;
-    double expiry_;
-    double spot_;
-    double rate_;
-    double volatility_;
-    double dividend_;
+    ContractSpec contract_;
+    MarketState market_;
 
     // Pricing engine
     std::shared_ptr<PricingEngine> engine_;
@@ -145,7 +245,18 @@ protected:
  */
 class EuropeanOption final : public Option {
 public:
-    using Option::Option;  // Inherit constructors
+    EuropeanOption(OptionType type,
+                   double strike,
+                   double expiry,
+                   double spot,
+                   double rate,
+                   double volatility,
+                   double dividend = 0.0);
+
+    /**
+     * @brief Constructor from plain values; the exercise style is forced to European
+     */
+    EuropeanOption(ContractSpec contract, const MarketState& market);
 };
 
 /**
@@ -153,7 +264,18 @@ public:
  */
 class AmericanOption final : public Option {
 public:
-    using Option::Option;  // Inherit constructors
+    AmericanOption(OptionType type,
+                   double strike,
+                   double expiry,
+                   double spot,
+                   double rate,
+                   double volatility,
+                   double dividend = 0.0);
+
+    /**
+     * @brief Constructor from plain values; the exercise style is forced to American
+     */
+    AmericanOption(ContractSpec contract, const MarketState& market);
 
     /**
      * @brief Override price calculation for American options
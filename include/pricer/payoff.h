@@ -0,0 +1,95 @@
+//
+// Path-dependent payoffs the Monte Carlo engine can price.
+//
+
+#ifndef OPTIONS_PRICER_PAYOFF_H
+#define OPTIONS_PRICER_PAYOFF_H
+
+#include <variant>
+
+namespace pricer {
+
+/**
+ * @brief Payoff of the contract's type and strike on S_T
+ */
+struct VanillaPayoff {};
+
+/**
+ * @brief How an Asian option averages the monitored spots
+ */
+enum class AsianAveraging {
+    Arithmetic,
+    Geometric
+};
+
+/**
+ * @brief Option on the average spot over the monitoring dates
+ *
+ * The dates are the engine's num_steps equally spaced steps, t_1 ... t_n = T;
+ * today's spot is not part of the average. Pays max(A - K, 0) for a call
+ * and max(K - A, 0) for a put.
+ */
+struct AsianPayoff {
+    AsianAveraging averaging = AsianAveraging::Arithmetic;
+};
+
+/**
+ * @brief Side of the barrier and whether touching it knocks out or in
+ */
+enum class BarrierType {
+    UpAndOut,
+    DownAndOut,
+    UpAndIn,
+    DownAndIn
+};
+
+/**
+ * @brief Vanilla payoff that a barrier on the spot switches off or on
+ *
+ * With the bridge correction each path survives a step with the probability
+ * that the Brownian bridge between its two monitored spots stayed clear of
+ * the barrier, which prices a continuously monitored barrier. Without it the
+ * barrier is only checked at the monitoring dates.
+ */
+struct BarrierPayoff {
+    BarrierType type = BarrierType::DownAndOut;
+    double barrier = 0.0;
+    double rebate = 0.0;            ///< Paid at expiry when the vanilla payoff is not
+    bool bridge_correction = true;
+};
+
+/**
+ * @brief Strike of a lookback option
+ */
+enum class LookbackStrike {
+    Floating,  ///< Call pays S_T - min S, put pays max S - S_T
+    Fixed      ///< Call pays max(max S - K, 0), put pays max(K - min S, 0)
+};
+
+/**
+ * @brief Option on the extreme spot since today
+ *
+ * With the continuity correction the monitored extremes are shifted by
+ * exp(±0.5826 σ sqrt(dt)) (Broadie, Glasserman and Kou), which approximates
+ * continuous monitoring.
+ */
+struct LookbackPayoff {
+    LookbackStrike strike = LookbackStrike::Floating;
+    bool continuity_correction = true;
+};
+
+/**
+ * @brief Any payoff of MonteCarloEngine::setPayoff
+ */
+using Payoff = std::variant<VanillaPayoff, AsianPayoff, BarrierPayoff, LookbackPayoff>;
+
+/**
+ * @brief Whether a payoff needs the spot before expiry
+ */
+[[nodiscard]] inline bool isPathDependent(const Payoff& payoff) {
+    return !std::holds_alternative<VanillaPayoff>(payoff);
+}
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_PAYOFF_H
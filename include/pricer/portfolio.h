@@ -0,0 +1,114 @@
+//
+// Books of option positions and their parallel pricing.
+//
+
+#ifndef OPTIONS_PRICER_PORTFOLIO_H
+#define OPTIONS_PRICER_PORTFOLIO_H
+
+#include "contract.h"
+#include "engine.h"
+#include "thread_pool.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Option positions, stored contiguously per pricing engine
+ *
+ * Positions keep the index they were added under; internally they are
+ * grouped by engine so each group can go through that engine's batch
+ * kernel in one pass.
+ */
+class Portfolio {
+public:
+    // Positions priced by one engine, in the order they were added
+    struct EngineGroup {
+        std::shared_ptr<const PricingEngine> engine;
+        ContractBatch contracts;
+        std::vector<std::size_t> positions;  // Portfolio index of each contract
+    };
+
+    /**
+     * @brief Add a position
+     * @param contract Contract terms
+     * @param market Market inputs of the underlying
+     * @param quantity Number of contracts, negative for short positions
+     * @param engine Engine that prices the position
+     * @return Index of the new position
+     * @throws std::invalid_argument if the engine is null or the parameters are invalid
+     */
+    std::size_t add(const ContractSpec& contract,
+                    const MarketState& market,
+                    double quantity,
+                    std::shared_ptr<const PricingEngine> engine);
+
+    void reserve(std::size_t positions);
+
+    [[nodiscard]] std::size_t size() const { return slots_.size(); }
+    [[nodiscard]] bool empty() const { return slots_.empty(); }
+
+    [[nodiscard]] double quantity(std::size_t position) const { return quantities_[position]; }
+    [[nodiscard]] ContractSpec contract(std::size_t position) const;
+    [[nodiscard]] MarketState market(std::size_t position) const;
+    [[nodiscard]] const PricingEngine& engine(std::size_t position) const;
+
+    [[nodiscard]] const std::vector<EngineGroup>& groups() const { return groups_; }
+
+private:
+    // Group of each position and its index within the group
+    struct Slot {
+        std::size_t group;
+        std::size_t index;
+    };
+
+    std::vector<EngineGroup> groups_;
+    std::vector<Slot> slots_;
+    std::vector<double> quantities_;
+};
+
+/**
+ * @brief Per-position and book-level results of a portfolio
+ */
+struct PortfolioResult {
+    std::vector<PricingResult> positions;  ///< Per contract, in position order
+    PricingResult total;                   ///< Quantity-weighted sum; std_error is not aggregated
+};
+
+/**
+ * @brief Prices a whole portfolio in parallel
+ *
+ * Every engine group is cut into fixed-size chunks that the pool runs
+ * concurrently through PricingEngine::calculateAllBatch, so engines with a
+ * vectorized kernel use it. Results are summed in position order, so the
+ * totals do not depend on scheduling.
+ */
+class PortfolioPricer {
+public:
+    /**
+     * @param pool Pool to use, or nullptr for ThreadPool::global()
+     */
+    explicit PortfolioPricer(std::shared_ptr<ThreadPool> pool = nullptr);
+
+    /**
+     * @brief Price and Greeks of every position and of the whole book
+     */
+    [[nodiscard]] PortfolioResult price(const Portfolio& portfolio) const;
+
+    [[nodiscard]] std::size_t getChunkSize() const { return chunk_size_; }
+
+    /**
+     * @brief Contracts per pool task
+     * @throws std::invalid_argument if size is 0
+     */
+    void setChunkSize(std::size_t size);
+
+private:
+    std::shared_ptr<ThreadPool> thread_pool_;
+    std::size_t chunk_size_ = 256;
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_PORTFOLIO_H
@@ -0,0 +1,88 @@
+//
+// Counter-based random number streams for the simulation engines.
+//
+
+#ifndef OPTIONS_PRICER_RANDOM_H
+#define OPTIONS_PRICER_RANDOM_H
+
+#include "normal.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace pricer {
+
+/**
+ * @brief Counter-based generators available to the simulation engines
+ *
+ * Both map (key, counter) to random bits with a fixed number of rounds of a
+ * keyed bijection (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2,
+ * 3", SC 2011), so any draw of any stream can be computed directly.
+ */
+enum class RandomGenerator {
+    Philox4x32,   ///< Philox4x32-10: 32-bit multiplies, cheapest on SIMD units
+    Threefry2x64  ///< Threefry2x64-20: adds, rotations and xors only
+};
+
+/**
+ * @brief Philox4x32-10 block function
+ * @param counter 128-bit counter
+ * @param key 64-bit key
+ * @return 128 random bits
+ */
+[[nodiscard]] std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter,
+                                                      std::array<std::uint32_t, 2> key);
+
+/**
+ * @brief Threefry2x64-20 block function
+ * @param counter 128-bit counter
+ * @param key 128-bit key
+ * @return 128 random bits
+ */
+[[nodiscard]] std::array<std::uint64_t, 2> threefry2x64(std::array<std::uint64_t, 2> counter,
+                                                        std::array<std::uint64_t, 2> key);
+
+/**
+ * @brief Independent random streams keyed by a seed
+ *
+ * Draw d of stream s is a pure function of (generator, seed, s, d): there is
+ * no state to advance, skipping ahead is free, and results do not depend on
+ * which thread computes which draw. The simulation engines use one stream
+ * per path and one draw per time step.
+ */
+class CounterBasedRng {
+public:
+    explicit CounterBasedRng(RandomGenerator generator = RandomGenerator::Philox4x32,
+                             std::uint64_t seed = 0)
+        : generator_(generator), seed_(seed) {}
+
+    [[nodiscard]] RandomGenerator getGenerator() const { return generator_; }
+    [[nodiscard]] std::uint64_t getSeed() const { return seed_; }
+
+    /**
+     * @brief Uniform draw of one stream
+     * @return Midpoint of a 2^-52 cell, so never exactly 0 or 1
+     */
+    [[nodiscard]] double uniform(std::uint64_t stream, std::uint64_t draw) const;
+
+    /**
+     * @brief Standard normal draw of one stream
+     */
+    [[nodiscard]] double normal(std::uint64_t stream, std::uint64_t draw) const;
+
+    /**
+     * @brief Draw d of the consecutive streams first_stream, first_stream + 1, ...
+     * @param first_stream Stream written to out[0]
+     * @param draw Draw index within each stream
+     * @param out Receives one standard normal per stream
+     */
+    void normals(std::uint64_t first_stream, std::uint64_t draw, std::span<double> out) const;
+
+private:
+    RandomGenerator generator_;
+    std::uint64_t seed_;
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_RANDOM_H
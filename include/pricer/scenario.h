@@ -0,0 +1,128 @@
+//
+// Scenario grids of market shifts and their batched evaluation over a book.
+//
+
+#ifndef OPTIONS_PRICER_SCENARIO_H
+#define OPTIONS_PRICER_SCENARIO_H
+
+#include "engine.h"
+#include "portfolio.h"
+#include "thread_pool.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Market shifts applied to every position of a book
+ *
+ * A scenario is one spot shift and one volatility shift; the grid is their
+ * cross product. Spot shifts are relative, so a shift s moves the spot to
+ * S (1 + s); volatility shifts are absolute, moving it to sigma + s.
+ */
+struct ScenarioGrid {
+    std::vector<double> spot_shifts{0.0};
+    std::vector<double> volatility_shifts{0.0};
+
+    [[nodiscard]] std::size_t size() const { return spot_shifts.size() * volatility_shifts.size(); }
+
+    /**
+     * @brief Evenly spaced shifts, symmetric about zero
+     * @param spot_range Largest relative spot shift, e.g. 0.2 for +/-20%
+     * @param spot_points Number of spot shifts; 1 for no spot shift
+     * @param volatility_range Largest absolute volatility shift
+     * @param volatility_points Number of volatility shifts; 1 for no volatility shift
+     * @throws std::invalid_argument if a point count is 0 or a range is negative
+     */
+    [[nodiscard]] static ScenarioGrid ladder(double spot_range,
+                                             std::size_t spot_points,
+                                             double volatility_range = 0.0,
+                                             std::size_t volatility_points = 1);
+};
+
+/**
+ * @brief Dense results of a book over a scenario grid
+ *
+ * Values are laid out position-major, then by spot shift, then by
+ * volatility shift, so the scenarios of one position are contiguous.
+ */
+struct ScenarioCube {
+    std::size_t positions = 0;
+    std::size_t spot_points = 0;
+    std::size_t volatility_points = 0;
+
+    std::vector<double> prices;          ///< Unit price per [position][spot][volatility]
+    std::vector<PricingResult> results;  ///< Price and Greeks in the same layout; empty unless requested
+    std::vector<double> book;            ///< Quantity-weighted book value per [spot][volatility]
+
+    [[nodiscard]] std::size_t index(const std::size_t position, const std::size_t spot,
+                                    const std::size_t volatility) const {
+        return (position * spot_points + spot) * volatility_points + volatility;
+    }
+
+    [[nodiscard]] double price(const std::size_t position, const std::size_t spot,
+                               const std::size_t volatility) const {
+        return prices[index(position, spot, volatility)];
+    }
+
+    [[nodiscard]] double bookValue(const std::size_t spot, const std::size_t volatility) const {
+        return book[spot * volatility_points + volatility];
+    }
+};
+
+/**
+ * @brief Evaluates a book under every scenario of a grid
+ *
+ * Each pool task takes a slice of one engine group, expands it into one
+ * ContractBatch holding every (position, scenario) contract and prices it
+ * with a single call to the engine's batch kernel. Scenarios of a position
+ * share their spot across the volatility shifts, so the batch computes the
+ * discount factors and forwards once per shifted spot and expiry, and the
+ * tree engines reuse their spot lattices across strikes and types.
+ *
+ * Monte Carlo draws its normals from counter-based streams keyed by seed,
+ * path and step, so every scenario is priced on the same paths, and the
+ * differences between scenarios carry no sampling noise of their own.
+ *
+ * Book values are summed in position order, so they do not depend on
+ * scheduling.
+ */
+class ScenarioPricer {
+public:
+    /**
+     * @param pool Pool to use, or nullptr for ThreadPool::global()
+     */
+    explicit ScenarioPricer(std::shared_ptr<ThreadPool> pool = nullptr);
+
+    /**
+     * @brief Price every position under every scenario
+     * @param portfolio Book to shift
+     * @param grid Shifts to apply
+     * @param greeks Whether to fill ScenarioCube::results as well; without
+     *        it the engines only compute prices
+     * @throws std::invalid_argument if the grid is empty or a shift makes a
+     *         spot or volatility non-positive
+     */
+    [[nodiscard]] ScenarioCube price(const Portfolio& portfolio,
+                                     const ScenarioGrid& grid,
+                                     bool greeks = false) const;
+
+    [[nodiscard]] std::size_t getChunkSize() const { return chunk_size_; }
+
+    /**
+     * @brief Scenario contracts per pool task
+     *
+     * A task always takes at least one position with all its scenarios.
+     * @throws std::invalid_argument if size is 0
+     */
+    void setChunkSize(std::size_t size);
+
+private:
+    std::shared_ptr<ThreadPool> thread_pool_;
+    std::size_t chunk_size_ = 4096;
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_SCENARIO_H
@@ -0,0 +1,124 @@
+//
+// Sobol low-discrepancy sequence and Brownian-bridge path construction.
+//
+
+#ifndef OPTIONS_PRICER_SOBOL_H
+#define OPTIONS_PRICER_SOBOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Owen scrambling of one 32-bit Sobol coordinate
+ *
+ * Hash-based nested uniform scramble (Burley, "Practical Hash-based Owen
+ * Scrambling", JCGT 2020): every point keeps its stratification while the
+ * scrambled set is a uniform random sample for error estimation.
+ * @param x Coordinate as a 32-bit binary fraction
+ * @param seed Scramble seed; use a different one per dimension
+ * @return Scrambled coordinate
+ */
+[[nodiscard]] std::uint32_t owenScramble(std::uint32_t x, std::uint32_t seed);
+
+/**
+ * @brief Sobol sequence in base 2, generated in Gray-code order
+ *
+ * Primitive polynomials are enumerated in the order of Joe and Kuo's tables,
+ * whose initial direction numbers are used for the first 21 dimensions;
+ * higher dimensions get pseudo-random odd initial numbers (Jäckel 2002).
+ * Coordinates have 32 bits, so at most 2^32 distinct points.
+ */
+class SobolSequence {
+public:
+    static constexpr std::size_t kMaxDimensions = 21201;
+
+    /**
+     * @brief Compute the direction numbers
+     * @param dimensions Number of dimensions
+     * @throws std::invalid_argument if dimensions is 0 or above kMaxDimensions
+     */
+    explicit SobolSequence(std::size_t dimensions);
+
+    [[nodiscard]] std::size_t dimensions() const { return dimensions_; }
+
+    /**
+     * @brief Coordinate of one point as a 32-bit binary fraction
+     * @param index Point index
+     * @param dim Dimension, below dimensions()
+     */
+    [[nodiscard]] std::uint32_t coordinate(std::uint64_t index, std::size_t dim) const;
+
+    /**
+     * @brief Standard normal transforms of consecutive points in one dimension
+     *
+     * Each coordinate is mapped to the midpoint of its 2^-32 cell, so even
+     * the unscrambled origin gives a finite draw.
+     * @param first_point Point written to out[0]
+     * @param dim Dimension, below dimensions()
+     * @param scramble Whether to Owen-scramble the coordinates
+     * @param scramble_seed Scramble seed for this dimension
+     * @param out Receives one normal per point
+     */
+    void normals(std::uint64_t first_point, std::size_t dim, bool scramble,
+                 std::uint32_t scramble_seed, std::span<double> out) const;
+
+    /**
+     * @brief Primitive polynomial of a dimension
+     * @return Polynomial over GF(2) with bit i holding the coefficient of x^i;
+     *         dimension 0 (the van der Corput sequence) returns 0
+     */
+    [[nodiscard]] std::uint32_t polynomial(std::size_t dim) const { return polynomials_[dim]; }
+
+private:
+    std::size_t dimensions_;
+    std::vector<std::uint32_t> polynomials_;
+    std::vector<std::uint32_t> directions_;  // 32 per dimension
+
+    [[nodiscard]] const std::uint32_t* directions(std::size_t dim) const {
+        return directions_.data() + 32 * dim;
+    }
+};
+
+/**
+ * @brief Brownian bridge over equally spaced steps
+ *
+ * Draw 0 sets the terminal value, draw 1 the midpoint and so on, which puts
+ * the most important directions of a path on the first and most uniform
+ * Sobol dimensions.
+ */
+class BrownianBridge {
+public:
+    /**
+     * @brief Precompute the construction order and weights
+     * @param steps Number of time steps
+     * @throws std::invalid_argument if steps is 0
+     */
+    explicit BrownianBridge(std::size_t steps);
+
+    [[nodiscard]] std::size_t steps() const { return steps_; }
+
+    /**
+     * @brief Build a unit-horizon Brownian path from standard normals
+     * @param z steps() independent standard normals, most important first
+     * @param w Receives W(t_1) ... W(t_n) with t_k = k / n
+     * @throws std::invalid_argument if either span has the wrong size
+     */
+    void build(std::span<const double> z, std::span<double> w) const;
+
+private:
+    std::size_t steps_;
+    std::vector<std::size_t> bridge_index_;
+    std::vector<std::size_t> left_index_;
+    std::vector<std::size_t> right_index_;
+    std::vector<double> left_weight_;
+    std::vector<double> right_weight_;
+    std::vector<double> std_dev_;
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_SOBOL_H
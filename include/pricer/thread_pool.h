@@ -0,0 +1,150 @@
+//
+// Persistent work-stealing task scheduler shared by the pricing engines.
+//
+
+#ifndef OPTIONS_PRICER_THREAD_POOL_H
+#define OPTIONS_PRICER_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace pricer {
+
+/**
+ * @brief Scheduling counters of a pool since it started
+ */
+struct ThreadPoolMetrics {
+    std::size_t workers = 0;
+    std::uint64_t tasks_queued = 0;
+    std::uint64_t tasks_run = 0;
+    std::uint64_t steals = 0;           ///< Tasks taken from another worker's deque
+    std::size_t queue_depth = 0;        ///< Tasks waiting right now
+    std::size_t max_queue_depth = 0;    ///< Most tasks ever waiting at once
+};
+
+/**
+ * @brief Fixed set of worker threads with per-worker task deques
+ *
+ * Each worker pops from the back of its own deque and, when that runs dry,
+ * steals from the front of the others. Tasks submitted from a worker land on
+ * that worker's deque; tasks submitted from outside are dealt round-robin.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Start the worker threads
+     * @param num_threads Number of workers (0 for hardware concurrency)
+     * @param pin_threads Whether to pin worker i to CPU i (Linux only, ignored elsewhere)
+     */
+    explicit ThreadPool(size_t num_threads = 0, bool pin_threads = false);
+
+    /**
+     * @brief Finish the queued tasks and join the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] size_t size() const { return workers_.size(); }
+    [[nodiscard]] bool pinsThreads() const { return pin_threads_; }
+
+    /**
+     * @brief Scheduling counters of this pool
+     *
+     * Always maintained; they are updated next to the deque locks the
+     * scheduler takes anyway.
+     */
+    [[nodiscard]] ThreadPoolMetrics metrics() const;
+
+    /**
+     * @brief Scheduling counters summed over every live pool, with the
+     *        largest max_queue_depth of any of them
+     */
+    [[nodiscard]] static ThreadPoolMetrics totalMetrics();
+
+    /**
+     * @brief Run body(i) for every i in [0, count) and wait for all of them
+     *
+     * Indices are handed out one at a time from a shared counter, so fast
+     * threads simply take more of them. The calling thread works too, which
+     * makes nested calls from inside a task safe.
+     * @param count Number of indices
+     * @param body Work for one index
+     * @param max_concurrency Most threads, caller included, working on this
+     *        loop at once (0 for the whole pool)
+     * @throws Whatever the first failing body threw, once the loop has drained
+     */
+    void parallelFor(size_t count,
+                     const std::function<void(size_t)>& body,
+                     size_t max_concurrency = 0);
+
+    /**
+     * @brief Queue a single task
+     * @param task Callable taking no arguments
+     * @return Future for the task's result
+     */
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged] { (*packaged)(); });
+        return future;
+    }
+
+    /**
+     * @brief Pool used by every engine that was not given its own
+     *
+     * Created on first use with setGlobalConfiguration()'s settings.
+     */
+    static ThreadPool& global();
+
+    /**
+     * @brief Size and pinning of the global pool
+     * @param num_threads Number of workers (0 for hardware concurrency)
+     * @param pin_threads Whether to pin the workers to cores
+     * @throws std::runtime_error if the global pool is already running
+     */
+    static void setGlobalConfiguration(size_t num_threads, bool pin_threads = false);
+
+private:
+    using Task = std::function<void()>;
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> queues_;
+    std::vector<std::thread> workers_;
+    bool pin_threads_;
+
+    mutable std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<std::uint64_t> tasks_queued_{0};
+    std::atomic<std::uint64_t> tasks_run_{0};
+    std::atomic<std::uint64_t> steals_{0};
+    size_t max_queued_ = 0;  // Guarded by sleep_mutex_
+    bool stopping_ = false;
+
+    void enqueue(Task task);
+    bool tryPop(size_t self, Task& task);
+    void workerLoop(size_t index);
+};
+
+} // namespace pricer
+
+#endif // OPTIONS_PRICER_THREAD_POOL_H
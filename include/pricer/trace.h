@@ -0,0 +1,134 @@
+//
+// Opt-in tracing of intermediate pricing values.
+//
+
+#ifndef OPTIONS_PRICER_TRACE_H
+#define OPTIONS_PRICER_TRACE_H
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Compile-time switch for the engine trace points
+ *
+ * When 0 every PRICER_TRACE expands to nothing. When 1 (the default) a trace
+ * point costs one thread-local load and a branch unless a sink is installed.
+ */
+#ifndef OPTIONS_PRICER_ENABLE_TRACE
+#define OPTIONS_PRICER_ENABLE_TRACE 1
+#endif
+
+namespace pricer {
+
+/**
+ * @brief Receives the intermediate values recorded by the engines
+ */
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+
+    /**
+     * @brief Record one value
+     * @param engine Name of the engine emitting the value
+     * @param label What the value is (e.g. "d1")
+     * @param value The value itself
+     */
+    virtual void record(std::string_view engine, std::string_view label, double value) = 0;
+};
+
+/**
+ * @brief Sink that keeps every entry in memory for later inspection
+ */
+class RecordingTraceSink final : public TraceSink {
+public:
+    struct Entry {
+        std::string engine;
+        std::string label;
+        double value;
+    };
+
+    void record(std::string_view engine, std::string_view label, double value) override;
+
+    [[nodiscard]] const std::vector<Entry>& entries() const { return entries_; }
+    void clear() { entries_.clear(); }
+
+    /**
+     * @brief Find the most recent value recorded under a label
+     * @param label Label to look up
+     * @return Pointer to the value, or nullptr if it was never recorded
+     */
+    [[nodiscard]] const double* find(std::string_view label) const;
+
+private:
+    std::vector<Entry> entries_;
+};
+
+/**
+ * @brief Sink that writes one aligned "label = value" line per entry
+ */
+class StreamTraceSink final : public TraceSink {
+public:
+    explicit StreamTraceSink(std::ostream& out) : out_(out) {}
+
+    void record(std::string_view engine, std::string_view label, double value) override;
+
+private:
+    std::ostream& out_;
+};
+
+namespace trace {
+
+namespace detail {
+    inline thread_local TraceSink* current_sink = nullptr;
+}
+
+/**
+ * @brief Sink installed on the calling thread, or nullptr when tracing is off
+ */
+[[nodiscard]] inline TraceSink* currentSink() { return detail::current_sink; }
+
+/**
+ * @brief Installs a sink on the calling thread for the lifetime of the object
+ *
+ * Only pricing calls made on this thread are traced, so a single contract can
+ * be inspected while other threads keep pricing silently. The previously
+ * installed sink is restored on destruction.
+ */
+class ScopedSink {
+public:
+    explicit ScopedSink(TraceSink& sink) : previous_(detail::current_sink) {
+        detail::current_sink = &sink;
+    }
+    ~ScopedSink() { detail::current_sink = previous_; }
+
+    ScopedSink(const ScopedSink&) = delete;
+    ScopedSink& operator=(const ScopedSink&) = delete;
+
+private:
+    TraceSink* previous_;
+};
+
+} // namespace trace
+} // namespace pricer
+
+/**
+ * @brief Record an intermediate value if a sink is installed on this thread
+ *
+ * The value expression is only evaluated when tracing is active.
+ */
+#if OPTIONS_PRICER_ENABLE_TRACE
+#define PRICER_TRACE(engine, label, value)                                    \
+    do {                                                                      \
+        if (::pricer::TraceSink* pricer_trace_sink_ = ::pricer::trace::currentSink()) { \
+            pricer_trace_sink_->record((engine), (label), (value));          \
+        }                                                                     \
+    } while (0)
+#else
+#define PRICER_TRACE(engine, label, value) \
+    do {                                   \
+    } while (0)
+#endif
+
+#endif // OPTIONS_PRICER_TRACE_H
@@ -7,6 +7,7 @@
 
 #include "option.h"
 #include <random>
+#include <span>
 #include <vector>
 
 namespace pricer {
@@ -14,6 +15,8 @@ namespace utils {
 
 /**
  * @brief Normal cumulative distribution function (N(x))
+ *
+ * Same full-precision kernel as pricer::normalCDF, so results match the engines.
  * @param x Input value
  * @return The probability that a standard normal variable is less than x
  */
@@ -28,8 +31,11 @@ double normalPDF(double x);
 
 /**
  * @brief Inverse normal cumulative distribution function (N^(-1)(p))
+ *
+ * Same kernel as pricer::inverseNormalCDF, with the domain checked.
  * @param p Probability value between 0 and 1
  * @return The value x such that N(x) = p
+ * @throws std::invalid_argument if p is not strictly between 0 and 1
  */
 double inverseNormalCDF(double p);
 
@@ -68,7 +74,13 @@ double discountFactor(double rate, double time);
 double forwardPrice(double spot, double rate, double dividend, double time);
 
 /**
- * @brief Calculate implied volatility using Newton-Raphson method
+ * @brief Invert the Black-Scholes price of a European option for its volatility
+ *
+ * The quote is normalized to an out-of-the-money call on a unit forward and
+ * solved by safeguarded Halley steps on the log of the normalized price,
+ * seeded by Corrado-Miller or, deep in the low-volatility wing, by its
+ * asymptotic expansion. Typically 2-3 steps reach rounding level.
+ *
  * @param marketPrice Observed market price
  * @param spot Spot price
  * @param strike Strike price
@@ -77,10 +89,39 @@ double forwardPrice(double spot, double rate, double dividend, double time);
  * @param dividend Dividend yield
  * @param isCall Whether the option is a call (true) or put (false)
  * @return Implied volatility
+ * @throws std::invalid_argument if the price is outside the no-arbitrage bounds
+ *         or the inputs are invalid
  */
 double impliedVolatility(double marketPrice, double spot, double strike,
                         double rate, double time, double dividend, bool isCall);
 
+/**
+ * @brief Implied volatilities of a whole quote set from structure-of-arrays inputs
+ *
+ * Same solver as impliedVolatility, run branch-free across quotes so each
+ * step vectorizes. All spans must have the same length. Quotes outside the
+ * no-arbitrage bounds yield NaN instead of throwing; long inputs are split
+ * into chunks on ThreadPool::global().
+ *
+ * @param marketPrice Observed market prices
+ * @param spot Spot prices
+ * @param strike Strike prices
+ * @param expiry Times to expiry in years
+ * @param rate Risk-free rates
+ * @param dividend Dividend yields
+ * @param type Call/put flags
+ * @param out Receives the implied volatilities
+ * @throws std::invalid_argument on mismatched lengths or invalid parameters
+ */
+void impliedVolatilityBatch(std::span<const double> marketPrice,
+                            std::span<const double> spot,
+                            std::span<const double> strike,
+                            std::span<const double> expiry,
+                            std::span<const double> rate,
+                            std::span<const double> dividend,
+                            std::span<const OptionType> type,
+                            std::span<double> out);
+
 /**
  * @brief Calculate historical volatility from price series
  * @param prices Vector of historical prices
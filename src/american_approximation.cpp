@@ -0,0 +1,1013 @@
+#include "pricer/american_approximation.h"
+#include "pricer/metrics.h"
+#include "pricer/normal.h"
+#include "vector_math.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace pricer {
+    namespace {
+        // Contracts per block of calculateAllBatch; each contract takes kScenarios lanes
+        constexpr std::size_t kGreekBlock = 64;
+
+        // Base, spot up/down, expiry up/down, volatility up/down, rate up/down
+        constexpr std::size_t kScenarios = 9;
+
+        // Andersen-Lake-Offengenden resolution: Chebyshev nodes of the boundary,
+        // fixed-point sweeps, and Gauss-Legendre points of the boundary and
+        // pricing integrals
+        constexpr std::size_t kAloCollocation = 12;
+        constexpr std::size_t kAloIterations = 10;
+        constexpr std::size_t kAloIntegration = 24;
+        constexpr std::size_t kAloPricing = 48;
+
+        // Contracts per pool task of priceBatch for the boundary iteration, which
+        // costs as much as a few hundred kernel lanes
+        constexpr std::size_t kAloBatchChunk = 16;
+
+        // Bjerksund-Stensland's bivariate normals all have correlation
+        // +-rho = +-sqrt(t1 / T) = +-sqrt((sqrt(5) - 1) / 2). At that fixed
+        // correlation Genz's 20-point Gauss-Legendre form
+        //   M(a, b, rho) = N(a) N(b) + sum_i w_i exp((a b s_i - (a^2 + b^2) / 2) / (1 - s_i^2))
+        // with s_i = sin(asin(rho) (1 + x_i) / 2) is accurate to double precision
+        // and has no branches; M(a, b, -rho) flips the signs of w_i and s_i.
+        // Columns: w_i asin(rho) / (4 pi), s_i, 1 / (1 - s_i^2).
+        struct BivariateNode {
+            double weight;
+            double sine;
+            double secant2;
+        };
+        constexpr double kBivariateScale = 0.07198235051803856;
+        constexpr BivariateNode kBivariateNodes[20] = {
+            {0.017614007139152264 * kBivariateScale, 0.0031077814876463209, 1.0000096583990588},
+            {0.04060142980038705 * kBivariateScale, 0.016293999704091958, 1.0002655649323664},
+            {0.06267204833410904 * kBivariateScale, 0.039684053215025418, 1.0015773080622903},
+            {0.083276741576704741 * kBivariateScale, 0.072699733973249969, 1.0053133336233264},
+            {0.10193011981724048 * kBivariateScale, 0.11447708818931852, 1.0132790253975419},
+            {0.11819453196151831 * kBivariateScale, 0.16386275803491718, 1.0275918729470779},
+            {0.1316886384491765 * kBivariateScale, 0.21942426297223605, 1.0505823982738265},
+            {0.14209610931838215 * kBivariateScale, 0.2794864832820228, 1.0847312831596108},
+            {0.14917298647260382 * kBivariateScale, 0.34219864653391824, 1.1326309913265575},
+            {0.15275338713072598 * kBivariateScale, 0.40562924682346307, 1.1969383550374393},
+            {0.15275338713072598 * kBivariateScale, 0.4678793345622409, 1.2802639543102605},
+            {0.14917298647260382 * kBivariateScale, 0.52719916280123869, 1.3849244604071007},
+            {0.14209610931838215 * kBivariateScale, 0.58209080582330919, 1.5124696457382547},
+            {0.1316886384491765 * kBivariateScale, 0.63138085195917792, 1.6629023552168261},
+            {0.11819453196151831 * kBivariateScale, 0.67425233008260232, 1.8335711630496416},
+            {0.10193011981724048 * kBivariateScale, 0.7102323996436618, 2.0178786530798671},
+            {0.083276741576704741 * kBivariateScale, 0.73914021507488503, 2.2042369105460815},
+            {0.06267204833410904 * kBivariateScale, 0.76100601509325216, 2.3760314783761056},
+            {0.04060142980038705 * kBivariateScale, 0.77597676579545038, 2.5134465687510725},
+            {0.017614007139152264 * kBivariateScale, 0.78422686671408737, 2.5974820633263627},
+        };
+
+        // Lanes per pass of the staged kernels below. The full approximations are
+        // too large to inline into one loop, so each stage is its own loop over
+        // the rows of a block, small enough to vectorize across contracts. Normal
+        // CDFs are taken a whole row at a time through the shared span kernels.
+        constexpr std::size_t kLanes = 64;
+
+        inline void normalCDFRow(const double* x, double* out, const std::size_t n) {
+            normalCDF(std::span<const double>(x, n), std::span<double>(out, n));
+        }
+
+        // Call-form inputs of a block, with puts mapped onto calls by the
+        // symmetry P(S, K, r, q) = C(K, S, q, r)
+        struct CallRows {
+            double spot[kLanes];
+            double strike[kLanes];
+            double expiry[kLanes];
+            double rate[kLanes];
+            double carry[kLanes];  // b = r - q
+            double volatility[kLanes];
+            double growth[kLanes];    // e^{(b - r) T}
+            double discount[kLanes];  // e^{-rT}
+            double cdf_d1[kLanes];
+            double cdf_d2[kLanes];
+            double european[kLanes];
+        };
+
+        PRICER_SIMD_CLONES
+        void loadCallRows(const double* spot, const double* strike, const double* expiry,
+                          const double* rate, const double* volatility, const double* dividend,
+                          const OptionType* type, CallRows& rows, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                // Both operands are loaded before the selects, which keeps them plain blends
+                const double s = spot[i];
+                const double k = strike[i];
+                const double rf = rate[i];
+                const double y = dividend[i];
+                const bool call = type[i] == OptionType::Call;
+                const double S = call ? s : k;
+                const double K = call ? k : s;
+                const double r = call ? rf : y;
+                const double q = call ? y : rf;
+                const double T = expiry[i];
+                const double sigma = volatility[i];
+                const double vol_sqrt_t = sigma * std::sqrt(T);
+                const double d1 = (simd::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / vol_sqrt_t;
+
+                rows.spot[i] = S;
+                rows.strike[i] = K;
+                rows.expiry[i] = T;
+                rows.rate[i] = r;
+                rows.carry[i] = r - q;
+                rows.volatility[i] = sigma;
+                rows.growth[i] = simd::exp(-q * T);
+                rows.discount[i] = simd::exp(-r * T);
+                rows.cdf_d1[i] = d1;
+                rows.cdf_d2[i] = d1 - vol_sqrt_t;
+            }
+        }
+
+        // Generalized Black-Scholes call with cost of carry b = r - q
+        PRICER_SIMD_CLONES
+        void europeanCallRows(CallRows& rows, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                rows.european[i] = rows.spot[i] * rows.growth[i] * rows.cdf_d1[i]
+                                   - rows.strike[i] * rows.discount[i] * rows.cdf_d2[i];
+            }
+        }
+
+        void loadCalls(const double* spot, const double* strike, const double* expiry,
+                       const double* rate, const double* volatility, const double* dividend,
+                       const OptionType* type, CallRows& rows, const std::size_t n) {
+            loadCallRows(spot, strike, expiry, rate, volatility, dividend, type, rows, n);
+            normalCDFRow(rows.cdf_d1, rows.cdf_d1, n);
+            normalCDFRow(rows.cdf_d2, rows.cdf_d2, n);
+            europeanCallRows(rows, n);
+        }
+
+        // Bjerksund-Stensland (2002) state of a block. The flat exercise triggers
+        // I1 on [0, t1] and I2 on [t1, T] interpolate between the immediate
+        // boundary B0 and the perpetual one; value accumulates the terms.
+        struct BjerksundStenslandRows {
+            double variance[kLanes];
+            double t1[kLanes];
+            double beta[kLanes];
+            double i1[kLanes];
+            double i2[kLanes];
+            // alpha_j S^beta is carried as (I_j - K) (S / I_j)^beta so large beta cannot overflow
+            double alpha1[kLanes];
+            double alpha2[kLanes];
+            double zero[kLanes];
+            double one[kLanes];
+            double value[kLanes];
+            // Scratch of one phi term: e^{lambda t} (S / scale)^gamma, (I / S)^kappa and the two CDFs
+            double factor[kLanes];
+            double power[kLanes];
+            double cdf_direct[kLanes];
+            double cdf_reflected[kLanes];
+        };
+
+        // Arguments and weights of the four bivariate normals of one psi term
+        struct PsiRows {
+            double a[4][kLanes];
+            double b[4][kLanes];
+            double weight[4][kLanes];
+            double cdf_a[kLanes];
+            double cdf_b[kLanes];
+        };
+
+        PRICER_SIMD_CLONES
+        void bjerksundStenslandTriggers(const CallRows& call, BjerksundStenslandRows& rows, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double K = call.strike[i];
+                const double T = call.expiry[i];
+                const double r = call.rate[i];
+                const double b = call.carry[i];
+                const double sigma = call.volatility[i];
+
+                const double variance = sigma * sigma;
+                const double t1 = (std::numbers::phi - 1.0) * T;  // (sqrt(5) - 1) / 2 * T
+                const double carry = b / variance - 0.5;
+                const double beta = -carry + std::sqrt(carry * carry + 2.0 * r / variance);
+                const double b_infinity = beta / (beta - 1.0) * K;
+                const double b_zero = std::max(K, r / (r - b) * K);
+                const double span = b_infinity - b_zero;
+                const double h_scale = K * K / (span * b_zero);
+                const double i1 = b_zero + span * (1.0 - simd::exp(-(b * t1 + 2.0 * sigma * std::sqrt(t1)) * h_scale));
+                const double i2 = b_zero + span * (1.0 - simd::exp(-(b * T + 2.0 * sigma * std::sqrt(T)) * h_scale));
+
+                rows.variance[i] = variance;
+                rows.t1[i] = t1;
+                rows.beta[i] = beta;
+                rows.i1[i] = i1;
+                rows.i2[i] = i2;
+                rows.alpha1[i] = i1 - K;
+                rows.alpha2[i] = i2 - K;
+                rows.zero[i] = 0.0;
+                rows.one[i] = 1.0;
+                rows.value[i] = (i2 - K) * simd::exp(beta * simd::log(call.spot[i] / i2));
+            }
+        }
+
+        // Bjerksund-Stensland phi at t1 with S^gamma taken relative to scale:
+        //   e^{lambda t} (S / scale)^gamma [N(d) - (I / S)^kappa N(d - 2 ln(I / S) / (sigma sqrt(t)))]
+        // The CDF rows hold their arguments until normalCDFRow replaces them.
+        PRICER_SIMD_CLONES
+        void phiArguments(const CallRows& call, BjerksundStenslandRows& rows, const std::size_t n,
+                          const double* gamma, const double* scale, const double* H, const double* I) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double S = call.spot[i];
+                const double b = call.carry[i];
+                const double variance = rows.variance[i];
+                const double t = rows.t1[i];
+                const double g = gamma[i];
+
+                const double vol_sqrt_t = std::sqrt(variance * t);
+                const double lambda = -call.rate[i] + g * b + 0.5 * g * (g - 1.0) * variance;
+                const double kappa = 2.0 * b / variance + 2.0 * g - 1.0;
+                const double d = -(simd::log(S / H[i]) + (b + (g - 0.5) * variance) * t) / vol_sqrt_t;
+                const double log_ratio = simd::log(I[i] / S);
+
+                rows.factor[i] = simd::exp(lambda * t + g * simd::log(S / scale[i]));
+                rows.power[i] = simd::exp(kappa * log_ratio);
+                rows.cdf_direct[i] = d;
+                rows.cdf_reflected[i] = d - 2.0 * log_ratio / vol_sqrt_t;
+            }
+        }
+
+        PRICER_SIMD_CLONES
+        void accumulatePhi(BjerksundStenslandRows& rows, const std::size_t n,
+                           const double sign, const double* coefficient) {
+            for (std::size_t i = 0; i < n; ++i) {
+                rows.value[i] += sign * coefficient[i] * rows.factor[i]
+                                 * (rows.cdf_direct[i] - rows.power[i] * rows.cdf_reflected[i]);
+            }
+        }
+
+        // value += sign * coefficient * phi(S, t1 | gamma, H, I)
+        void addPhi(const CallRows& call, BjerksundStenslandRows& rows, const std::size_t n,
+                    const double sign, const double* coefficient, const double* gamma,
+                    const double* scale, const double* H, const double* I) {
+            phiArguments(call, rows, n, gamma, scale, H, I);
+            normalCDFRow(rows.cdf_direct, rows.cdf_direct, n);
+            normalCDFRow(rows.cdf_reflected, rows.cdf_reflected, n);
+            accumulatePhi(rows, n, sign, coefficient);
+        }
+
+        // Bjerksund-Stensland psi, the two-period analogue of phi over [0, t1] and [t1, T]:
+        //   psi = e^{lambda T} (S / scale)^gamma [M(-e1, -f1, rho) - (I2 / S)^kappa M(-e2, -f2, rho)
+        //         - (I1 / S)^kappa M(-e3, -f3, -rho) + (I1 / I2)^kappa M(-e4, -f4, -rho)]
+        // The arguments and weights of sign * coefficient * psi fill the rows
+        // here, in two passes to keep each loop small enough to inline;
+        // addBivariate then adds one term per pass.
+        PRICER_SIMD_CLONES
+        void psiArguments(const CallRows& call, const BjerksundStenslandRows& rows, PsiRows& psi,
+                          const std::size_t n, const double* gamma, const double* H) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double S = call.spot[i];
+                const double T = call.expiry[i];
+                const double variance = rows.variance[i];
+                const double t1 = rows.t1[i];
+                const double i1 = rows.i1[i];
+                const double i2 = rows.i2[i];
+
+                const double drift = call.carry[i] + (gamma[i] - 0.5) * variance;
+                const double vol_sqrt_t1 = std::sqrt(variance * t1);
+                const double vol_sqrt_t = std::sqrt(variance * T);
+
+                const double log_s_i1 = simd::log(S / i1);
+                const double log_mirror = simd::log(i2 * i2 / (S * i1));
+                const double log_s_h = simd::log(S / H[i]);
+                const double log_i2_s = simd::log(i2 / S);
+                const double log_i1_s = -log_s_i1;
+
+                psi.a[0][i] = -(log_s_i1 + drift * t1) / vol_sqrt_t1;
+                psi.a[1][i] = -(log_mirror + drift * t1) / vol_sqrt_t1;
+                psi.a[2][i] = -(log_s_i1 - drift * t1) / vol_sqrt_t1;
+                psi.a[3][i] = -(log_mirror - drift * t1) / vol_sqrt_t1;
+                psi.b[0][i] = -(log_s_h + drift * T) / vol_sqrt_t;
+                psi.b[1][i] = -(2.0 * log_i2_s + log_s_h + drift * T) / vol_sqrt_t;
+                psi.b[2][i] = -(2.0 * log_i1_s + log_s_h + drift * T) / vol_sqrt_t;
+                psi.b[3][i] = -(log_s_h - 2.0 * log_i2_s + 2.0 * log_i1_s + drift * T) / vol_sqrt_t;
+            }
+        }
+
+        PRICER_SIMD_CLONES
+        void psiWeights(const CallRows& call, const BjerksundStenslandRows& rows, PsiRows& psi,
+                        const std::size_t n, const double sign, const double* coefficient,
+                        const double* gamma, const double* scale) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double S = call.spot[i];
+                const double b = call.carry[i];
+                const double variance = rows.variance[i];
+                const double g = gamma[i];
+
+                const double lambda = -call.rate[i] + g * b + 0.5 * g * (g - 1.0) * variance;
+                const double kappa = 2.0 * b / variance + 2.0 * g - 1.0;
+                const double log_i2_s = simd::log(rows.i2[i] / S);
+                const double log_i1_s = simd::log(rows.i1[i] / S);
+
+                const double common = sign * coefficient[i]
+                                      * simd::exp(lambda * call.expiry[i] + g * simd::log(S / scale[i]));
+                psi.weight[0][i] = common;
+                psi.weight[1][i] = -common * simd::exp(kappa * log_i2_s);
+                psi.weight[2][i] = -common * simd::exp(kappa * log_i1_s);
+                psi.weight[3][i] = common * simd::exp(kappa * (log_i1_s - log_i2_s));
+            }
+        }
+
+        // value += weight M(a, b, correlation * rho) for psi term j, given
+        // N(a) and N(b) in the CDF rows. The quadrature runs one node per pass
+        // over the lanes, so each pass inlines a single exp.
+        PRICER_SIMD_CLONES
+        void addBivariate(const PsiRows& psi, BjerksundStenslandRows& rows, const std::size_t n,
+                          const std::size_t j, const double correlation) {
+            const double* a = psi.a[j];
+            const double* b = psi.b[j];
+            const double* weight = psi.weight[j];
+
+            for (std::size_t i = 0; i < n; ++i) {
+                rows.value[i] += weight[i] * psi.cdf_a[i] * psi.cdf_b[i];
+            }
+            for (const BivariateNode& node : kBivariateNodes) {
+                const double node_weight = correlation * node.weight;
+                const double sine = correlation * node.sine;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const double half_norm = 0.5 * (a[i] * a[i] + b[i] * b[i]);
+                    rows.value[i] += weight[i] * node_weight
+                                     * simd::exp((a[i] * b[i] * sine - half_norm) * node.secant2);
+                }
+            }
+        }
+
+        void addPsi(const CallRows& call, BjerksundStenslandRows& rows, PsiRows& psi, const std::size_t n,
+                    const double sign, const double* coefficient, const double* gamma,
+                    const double* scale, const double* H) {
+            psiArguments(call, rows, psi, n, gamma, H);
+            psiWeights(call, rows, psi, n, sign, coefficient, gamma, scale);
+            for (std::size_t j = 0; j < 4; ++j) {
+                normalCDFRow(psi.a[j], psi.cdf_a, n);
+                normalCDFRow(psi.b[j], psi.cdf_b, n);
+                addBivariate(psi, rows, n, j, j < 2 ? 1.0 : -1.0);
+            }
+        }
+
+        PRICER_SIMD_CLONES
+        void bjerksundStenslandSelect(const CallRows& call, const BjerksundStenslandRows& rows,
+                                      double* out, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                // Without a positive dividend yield a call is never exercised early;
+                // that lane's trigger terms are not finite and are discarded here
+                out[i] = call.carry[i] >= call.rate[i]
+                             ? call.european[i]
+                             : (call.spot[i] >= rows.i2[i] ? call.spot[i] - call.strike[i] : rows.value[i]);
+            }
+        }
+
+        void bjerksundStenslandChain(const double* spot, const double* strike, const double* expiry,
+                                     const double* rate, const double* volatility, const double* dividend,
+                                     const OptionType* type, double* out, const std::size_t n) {
+            CallRows call;
+            BjerksundStenslandRows rows;
+            PsiRows psi;
+
+            for (std::size_t offset = 0; offset < n; offset += kLanes) {
+                const std::size_t count = std::min(kLanes, n - offset);
+                loadCalls(spot + offset, strike + offset, expiry + offset, rate + offset,
+                          volatility + offset, dividend + offset, type + offset, call, count);
+                bjerksundStenslandTriggers(call, rows, count);
+
+                const double* K = call.strike;
+                addPhi(call, rows, count, -1.0, rows.alpha2, rows.beta, rows.i2, rows.i2, rows.i2);
+                addPhi(call, rows, count, 1.0, rows.one, rows.one, rows.one, rows.i2, rows.i2);
+                addPhi(call, rows, count, -1.0, rows.one, rows.one, rows.one, rows.i1, rows.i2);
+                addPhi(call, rows, count, -1.0, K, rows.zero, rows.one, rows.i2, rows.i2);
+                addPhi(call, rows, count, 1.0, K, rows.zero, rows.one, rows.i1, rows.i2);
+                addPhi(call, rows, count, 1.0, rows.alpha1, rows.beta, rows.i1, rows.i1, rows.i2);
+                addPsi(call, rows, psi, count, -1.0, rows.alpha1, rows.beta, rows.i1, rows.i1);
+                addPsi(call, rows, psi, count, 1.0, rows.one, rows.one, rows.one, rows.i1);
+                addPsi(call, rows, psi, count, -1.0, rows.one, rows.one, rows.one, K);
+                addPsi(call, rows, psi, count, -1.0, K, rows.zero, rows.one, rows.i1);
+                addPsi(call, rows, psi, count, 1.0, K, rows.zero, rows.one, K);
+
+                bjerksundStenslandSelect(call, rows, out + offset, count);
+            }
+        }
+
+        // Newton steps on the Barone-Adesi-Whaley critical price; the seed is
+        // within a few percent, so this is converged to rounding
+        constexpr int kBaroneAdesiWhaleyIterations = 8;
+
+        // Barone-Adesi-Whaley (1987) state of a block: the early-exercise premium
+        // A2 (S / S*)^q2 solves the quadratic approximation of the PDE, with the
+        // critical price S* the root of the smooth-pasting condition
+        struct BaroneAdesiWhaleyRows {
+            double vol_sqrt_t[kLanes];
+            double q2[kLanes];
+            double critical[kLanes];
+            // d1 and d2 of a European call struck at K with spot S*, then their CDFs
+            double cdf_d1[kLanes];
+            double cdf_d2[kLanes];
+            double pdf_d1[kLanes];
+        };
+
+        PRICER_SIMD_CLONES
+        void baroneAdesiWhaleySeed(const CallRows& call, BaroneAdesiWhaleyRows& rows, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double K = call.strike[i];
+                const double T = call.expiry[i];
+                const double r = call.rate[i];
+                const double b = call.carry[i];
+                const double sigma = call.volatility[i];
+
+                const double variance = sigma * sigma;
+                const double vol_sqrt_t = sigma * std::sqrt(T);
+                const double n_minus_1 = 2.0 * b / variance - 1.0;
+
+                // 2 r / (sigma^2 (1 - e^{-rT})) with its r -> 0 limit 2 / (sigma^2 T)
+                const double rt = r * T;
+                const double annuity = std::abs(rt) < 1e-5 ? T * (1.0 - rt / 2.0 + rt * rt / 6.0)
+                                                           : (1.0 - call.discount[i]) / r;
+                const double k = 2.0 / (variance * annuity);
+
+                // Seed from the perpetual boundary
+                const double q2_infinity = 0.5 * (-n_minus_1 + std::sqrt(n_minus_1 * n_minus_1 + 8.0 * r / variance));
+                const double s_infinity = K / (1.0 - 1.0 / q2_infinity);
+                const double h2 = -(b * T + 2.0 * vol_sqrt_t) * K / (s_infinity - K);
+
+                rows.vol_sqrt_t[i] = vol_sqrt_t;
+                rows.q2[i] = 0.5 * (-n_minus_1 + std::sqrt(n_minus_1 * n_minus_1 + 4.0 * k));
+                rows.critical[i] = K + (s_infinity - K) * (1.0 - simd::exp(h2));
+            }
+        }
+
+        PRICER_SIMD_CLONES
+        void baroneAdesiWhaleyArguments(const CallRows& call, BaroneAdesiWhaleyRows& rows, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double sigma = call.volatility[i];
+                const double d1 = (simd::log(rows.critical[i] / call.strike[i])
+                                   + (call.carry[i] + 0.5 * sigma * sigma) * call.expiry[i])
+                                  / rows.vol_sqrt_t[i];
+                rows.cdf_d1[i] = d1;
+                rows.cdf_d2[i] = d1 - rows.vol_sqrt_t[i];
+                rows.pdf_d1[i] = d1;
+            }
+        }
+
+        // One Newton step on S* from the CDF and PDF rows
+        PRICER_SIMD_CLONES
+        void baroneAdesiWhaleyStep(const CallRows& call, BaroneAdesiWhaleyRows& rows, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double K = call.strike[i];
+                const double growth = call.growth[i];
+                const double q2 = rows.q2[i];
+                const double critical = rows.critical[i];
+                const double nd1 = rows.cdf_d1[i];
+
+                const double value = critical * growth * nd1 - K * call.discount[i] * rows.cdf_d2[i];
+                const double rhs = value + (1.0 - growth * nd1) * critical / q2;
+                const double slope = growth * nd1 * (1.0 - 1.0 / q2)
+                                     + (1.0 - growth * rows.pdf_d1[i] / rows.vol_sqrt_t[i]) / q2;
+                rows.critical[i] = (K + rhs - slope * critical) / (1.0 - slope);
+            }
+        }
+
+        PRICER_SIMD_CLONES
+        void baroneAdesiWhaleySelect(const CallRows& call, const BaroneAdesiWhaleyRows& rows,
+                                     double* out, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double S = call.spot[i];
+                const double K = call.strike[i];
+                const double critical = rows.critical[i];
+                const double q2 = rows.q2[i];
+
+                const double a2 = critical / q2 * (1.0 - call.growth[i] * rows.cdf_d1[i]);
+                const double value = call.european[i] + a2 * simd::exp(q2 * simd::log(S / critical));
+
+                out[i] = call.carry[i] >= call.rate[i] ? call.european[i] : (S < critical ? value : S - K);
+            }
+        }
+
+        void baroneAdesiWhaleyNormals(const CallRows& call, BaroneAdesiWhaleyRows& rows, const std::size_t n) {
+            baroneAdesiWhaleyArguments(call, rows, n);
+            normalCDFRow(rows.cdf_d1, rows.cdf_d1, n);
+            normalCDFRow(rows.cdf_d2, rows.cdf_d2, n);
+            normalPDF(std::span<const double>(rows.pdf_d1, n), std::span<double>(rows.pdf_d1, n));
+        }
+
+        void baroneAdesiWhaleyChain(const double* spot, const double* strike, const double* expiry,
+                                    const double* rate, const double* volatility, const double* dividend,
+                                    const OptionType* type, double* out, const std::size_t n) {
+            CallRows call;
+            BaroneAdesiWhaleyRows rows;
+
+            for (std::size_t offset = 0; offset < n; offset += kLanes) {
+                const std::size_t count = std::min(kLanes, n - offset);
+                loadCalls(spot + offset, strike + offset, expiry + offset, rate + offset,
+                          volatility + offset, dividend + offset, type + offset, call, count);
+                baroneAdesiWhaleySeed(call, rows, count);
+                for (int iteration = 0; iteration < kBaroneAdesiWhaleyIterations; ++iteration) {
+                    baroneAdesiWhaleyNormals(call, rows, count);
+                    baroneAdesiWhaleyStep(call, rows, count);
+                }
+                baroneAdesiWhaleyNormals(call, rows, count);
+                baroneAdesiWhaleySelect(call, rows, out + offset, count);
+            }
+        }
+
+        struct GaussLegendre {
+            std::vector<double> nodes;
+            std::vector<double> weights;
+        };
+
+        // n-point Gauss-Legendre rule on [-1, 1], by Newton's method on P_n
+        GaussLegendre gaussLegendre(const std::size_t n) {
+            GaussLegendre rule{std::vector<double>(n), std::vector<double>(n)};
+            for (std::size_t i = 0; i < n; ++i) {
+                double x = std::cos(std::numbers::pi * (static_cast<double>(i) + 0.75)
+                                    / (static_cast<double>(n) + 0.5));
+                double derivative = 0.0;
+                for (int iteration = 0; iteration < 100; ++iteration) {
+                    double previous = 1.0;
+                    double current = x;
+                    for (std::size_t k = 2; k <= n; ++k) {
+                        const double next = ((2.0 * k - 1.0) * x * current - (k - 1.0) * previous) / k;
+                        previous = current;
+                        current = next;
+                    }
+                    derivative = n * (x * current - previous) / (x * x - 1.0);
+                    const double step = current / derivative;
+                    x -= step;
+                    if (std::abs(step) < 1e-16) {
+                        break;
+                    }
+                }
+                rule.nodes[i] = x;
+                rule.weights[i] = 2.0 / ((1.0 - x * x) * derivative * derivative);
+            }
+            return rule;
+        }
+
+        const GaussLegendre& aloIntegrationRule() {
+            static const GaussLegendre rule = gaussLegendre(kAloIntegration);
+            return rule;
+        }
+
+        const GaussLegendre& aloPricingRule() {
+            static const GaussLegendre rule = gaussLegendre(kAloPricing);
+            return rule;
+        }
+
+        /**
+         * @brief Put exercise boundary B(tau) of Andersen, Lake and Offengenden
+         *
+         * Interpolates H(sqrt(tau)) = ln(B(tau) / X)^2, which is smooth where B
+         * itself has a square-root singularity at expiry, on Chebyshev-Lobatto
+         * nodes in sqrt(tau); X = K min(1, r / q) is the boundary at expiry. The
+         * integrands only need ln(B / X), so the boundary is read and written as
+         * its depth sqrt(H) = ln(X / B).
+         */
+        class PutBoundary {
+        public:
+            static constexpr std::size_t kNodes = kAloCollocation;
+
+            explicit PutBoundary(const double expiry) : sqrt_expiry_(std::sqrt(expiry)) {}
+
+            // Time to maturity of collocation node i; node kNodes is expiry itself
+            [[nodiscard]] double nodeTau(const std::size_t i) const {
+                const double x = 0.5 * sqrt_expiry_ * (1.0 + cosines()[i][1]);
+                return x * x;
+            }
+
+            [[nodiscard]] double nodeDepth(const std::size_t i) const { return std::sqrt(values_[i]); }
+
+            void setNodeDepth(const std::size_t i, const double depth) {
+                const double clamped = std::max(depth, 0.0);
+                values_[i] = clamped * clamped;
+            }
+
+            // Coefficients of sum_k c_k T_k(z) through the node values, end terms
+            // halved; call after the last setNodeDepth
+            void fit() {
+                for (std::size_t k = 0; k <= kNodes; ++k) {
+                    double sum = 0.5 * (values_[0] + values_[kNodes] * cosines()[kNodes][k]);
+                    for (std::size_t i = 1; i < kNodes; ++i) {
+                        sum += values_[i] * cosines()[i][k];
+                    }
+                    coefficients_[k] = (k == 0 || k == kNodes ? 1.0 : 2.0) * sum / kNodes;
+                }
+            }
+
+            // Position of tau on the [-1, 1] interval of the interpolant
+            [[nodiscard]] double coordinate(const double tau) const {
+                return 2.0 * std::sqrt(tau) / sqrt_expiry_ - 1.0;
+            }
+
+            // H = sum_k c_k T_k(coordinate(tau)), for callers that hold the T_k
+            [[nodiscard]] double coefficient(const std::size_t k) const { return coefficients_[k]; }
+
+            // ln(X / B(tau)) from the Clenshaw recurrence
+            [[nodiscard]] double depth(const double tau) const {
+                const double z = coordinate(tau);
+                double next = 0.0;
+                double after = 0.0;
+#pragma GCC unroll 16
+                for (std::size_t k = kNodes; k >= 1; --k) {
+                    const double current = coefficients_[k] + 2.0 * z * next - after;
+                    after = next;
+                    next = current;
+                }
+                const double h = coefficients_[0] + z * next - after;
+                return std::sqrt(h > 0.0 ? h : 0.0);
+            }
+
+        private:
+            double sqrt_expiry_;
+            std::array<double, kNodes + 1> values_{};
+            std::array<double, kNodes + 1> coefficients_{};
+
+            // cos(i k pi / kNodes), shared by every boundary
+            using CosineTable = std::array<std::array<double, kNodes + 1>, kNodes + 1>;
+            static const CosineTable& cosines() {
+                static const CosineTable table = [] {
+                    CosineTable result{};
+                    for (std::size_t i = 0; i <= kNodes; ++i) {
+                        for (std::size_t k = 0; k <= kNodes; ++k) {
+                            result[i][k] = std::cos(std::numbers::pi * static_cast<double>(i * k) / kNodes);
+                        }
+                    }
+                    return result;
+                }();
+                return table;
+            }
+        };
+
+        double europeanPut(const double S, const double K, const double T, const double r,
+                           const double q, const double sigma) {
+            const double vol_sqrt_t = sigma * std::sqrt(T);
+            const double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / vol_sqrt_t;
+            return K * std::exp(-r * T) * normalCDF(vol_sqrt_t - d1) - S * std::exp(-q * T) * normalCDF(-d1);
+        }
+
+        // Andersen-Lake-Offengenden (2016) American put. The boundary solves
+        //   B(tau) = K e^{-(r-q) tau} N(tau, B) / D(tau, B),
+        //   N = N(d-(tau, B(tau) / K)) + r int_0^tau e^{ru} N(d-(tau - u, B(tau) / B(u))) du,
+        //   D = N(d+(tau, B(tau) / K)) + q int_0^tau e^{qu} N(d+(tau - u, B(tau) / B(u))) du,
+        // iterated on the collocation nodes from the Bjerksund-Stensland (1993)
+        // trigger; the price is the European one plus the early-exercise premium
+        // integral over that boundary. Both integrals substitute u = tau - z^2 to
+        // remove the square-root behaviour at u = tau.
+        double andersenLakeOffengendenPut(const double S, const double K, const double T,
+                                          const double r, const double q, const double sigma) {
+            const double european = europeanPut(S, K, T, r, q, sigma);
+            if (r <= 0.0) {
+                return european;
+            }
+
+            constexpr std::size_t kNodes = PutBoundary::kNodes;
+            const double variance = sigma * sigma;
+            const double drift = r - q + 0.5 * variance;
+            const double limit = q > r ? K * r / q : K;
+            const double log_limit_strike = simd::log(limit / K);
+            PutBoundary boundary(T);
+
+            // Initial guess: the call trigger I of Bjerksund-Stensland (1993) with
+            // r and q exchanged, mapped through B_put = K^2 / I
+            {
+                const double b = q - r;
+                const double carry = b / variance - 0.5;
+                const double beta = -carry + std::sqrt(carry * carry + 2.0 * q / variance);
+                const double b_infinity = beta / (beta - 1.0) * K;
+                const double b_zero = std::max(K, q / r * K);
+                for (std::size_t i = 0; i <= kNodes; ++i) {
+                    const double tau = boundary.nodeTau(i);
+                    const double h = -(b * tau + 2.0 * sigma * std::sqrt(tau)) * b_zero / (b_infinity - b_zero);
+                    const double trigger = b_zero + (b_infinity - b_zero) * (1.0 - simd::exp(h));
+                    boundary.setNodeDepth(i, simd::log(limit * trigger / (K * K)));
+                }
+            }
+
+            // Everything in the boundary integrals but B itself is fixed across
+            // sweeps, including the Chebyshev polynomials at the quadrature points,
+            // so every sweep is a few passes over flat arrays
+            constexpr std::size_t kPoints = kNodes * kAloIntegration;
+            const GaussLegendre& inner = aloIntegrationRule();
+            std::array<std::array<double, kPoints>, kNodes + 1> chebyshev;
+            std::array<double, kPoints> numerator_weight;
+            std::array<double, kPoints> denominator_weight;
+            std::array<double, kPoints> inverse_vol;
+            std::array<double, kPoints> drift_term;
+            std::array<double, kPoints> vol_term;
+            std::array<double, kNodes> node_vol;
+            std::array<double, kNodes> node_drift;
+            std::array<double, kNodes> node_scale;
+
+            for (std::size_t i = 0; i < kNodes; ++i) {
+                const double tau = boundary.nodeTau(i);
+                const double sqrt_tau = std::sqrt(tau);
+                node_vol[i] = sigma * sqrt_tau;
+                node_drift[i] = drift * sqrt_tau / sigma;
+                node_scale[i] = K * simd::exp(-(r - q) * tau);
+
+                for (std::size_t j = 0; j < kAloIntegration; ++j) {
+                    const std::size_t point = i * kAloIntegration + j;
+                    const double z = 0.5 * sqrt_tau * (1.0 + inner.nodes[j]);
+                    const double u = tau - z * z;
+                    const double weight = inner.weights[j] * sqrt_tau * z;
+                    numerator_weight[point] = r * weight * simd::exp(r * u);
+                    denominator_weight[point] = q * weight * simd::exp(q * u);
+                    inverse_vol[point] = 1.0 / (sigma * z);
+                    drift_term[point] = drift * z / sigma;
+                    vol_term[point] = sigma * z;
+
+                    const double x = boundary.coordinate(u);
+                    chebyshev[0][point] = 1.0;
+                    chebyshev[1][point] = x;
+                    for (std::size_t k = 2; k <= kNodes; ++k) {
+                        chebyshev[k][point] = 2.0 * x * chebyshev[k - 1][point] - chebyshev[k - 2][point];
+                    }
+                }
+            }
+
+            std::array<double, kPoints> squared_depth;
+            std::array<double, kPoints> cdf_plus;
+            std::array<double, kPoints> cdf_minus;
+            std::array<double, kNodes> updated;
+            for (std::size_t sweep = 0; sweep < kAloIterations; ++sweep) {
+                boundary.fit();
+                squared_depth.fill(0.0);
+                for (std::size_t k = 0; k <= kNodes; ++k) {
+                    const double c = boundary.coefficient(k);
+                    for (std::size_t point = 0; point < kPoints; ++point) {
+                        squared_depth[point] += c * chebyshev[k][point];
+                    }
+                }
+                for (std::size_t i = 0; i < kNodes; ++i) {
+                    const double node_depth = boundary.nodeDepth(i);
+                    for (std::size_t point = i * kAloIntegration; point < (i + 1) * kAloIntegration; ++point) {
+                        const double h = squared_depth[point];
+                        const double dp = (std::sqrt(h > 0.0 ? h : 0.0) - node_depth) * inverse_vol[point]
+                                          + drift_term[point];
+                        cdf_plus[point] = dp;
+                        cdf_minus[point] = dp - vol_term[point];
+                    }
+                }
+                normalCDF(cdf_plus, cdf_plus);
+                normalCDF(cdf_minus, cdf_minus);
+
+                for (std::size_t i = 0; i < kNodes; ++i) {
+                    const double d_plus = (log_limit_strike - boundary.nodeDepth(i)) / node_vol[i] + node_drift[i];
+                    double numerator = normalCDF(d_plus - node_vol[i]);
+                    double denominator = normalCDF(d_plus);
+                    for (std::size_t point = i * kAloIntegration; point < (i + 1) * kAloIntegration; ++point) {
+                        numerator += numerator_weight[point] * cdf_minus[point];
+                        denominator += denominator_weight[point] * cdf_plus[point];
+                    }
+                    updated[i] = node_scale[i] * numerator / denominator;
+                }
+                for (std::size_t i = 0; i < kNodes; ++i) {
+                    boundary.setNodeDepth(i, simd::log(limit / updated[i]));
+                }
+            }
+            boundary.fit();
+
+            const double log_spot_limit = simd::log(S / limit);
+            if (log_spot_limit + boundary.nodeDepth(0) <= 0.0) {
+                return K - S;
+            }
+
+            const GaussLegendre& outer = aloPricingRule();
+            const double sqrt_t = std::sqrt(T);
+            std::array<double, kAloPricing> rate_weight;
+            std::array<double, kAloPricing> yield_weight;
+            std::array<double, kAloPricing> cdf_rate;
+            std::array<double, kAloPricing> cdf_yield;
+            for (std::size_t j = 0; j < kAloPricing; ++j) {
+                const double z = 0.5 * sqrt_t * (1.0 + outer.nodes[j]);
+                const double s = z * z;
+                const double weight = outer.weights[j] * sqrt_t * z;
+                const double dp = (log_spot_limit + boundary.depth(T - s)) / (sigma * z) + drift * z / sigma;
+
+                rate_weight[j] = weight * r * K * simd::exp(-r * s);
+                yield_weight[j] = weight * q * S * simd::exp(-q * s);
+                cdf_rate[j] = sigma * z - dp;
+                cdf_yield[j] = -dp;
+            }
+            normalCDF(cdf_rate, cdf_rate);
+            normalCDF(cdf_yield, cdf_yield);
+
+            double premium = 0.0;
+            for (std::size_t j = 0; j < kAloPricing; ++j) {
+                premium += rate_weight[j] * cdf_rate[j] - yield_weight[j] * cdf_yield[j];
+            }
+            return std::max(european + premium, K - S);
+        }
+
+        void andersenLakeOffengendenChain(const double* spot, const double* strike, const double* expiry,
+                                          const double* rate, const double* volatility, const double* dividend,
+                                          const OptionType* type, double* out, const std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const bool call = type[i] == OptionType::Call;
+                const double S = call ? strike[i] : spot[i];
+                const double K = call ? spot[i] : strike[i];
+                const double r = call ? dividend[i] : rate[i];
+                const double q = call ? rate[i] : dividend[i];
+
+                out[i] = andersenLakeOffengendenPut(S, K, expiry[i], r, q, volatility[i]);
+            }
+        }
+
+        // Scenario s of contract i of a block of count contracts sits at lane s * count + i
+        struct ScenarioBlock {
+            double spot[kScenarios * kGreekBlock];
+            double strike[kScenarios * kGreekBlock];
+            double expiry[kScenarios * kGreekBlock];
+            double rate[kScenarios * kGreekBlock];
+            double volatility[kScenarios * kGreekBlock];
+            double dividend[kScenarios * kGreekBlock];
+            OptionType type[kScenarios * kGreekBlock];
+            double price[kScenarios * kGreekBlock];
+        };
+
+        void setScenarios(ScenarioBlock& block, const std::size_t i, const std::size_t count,
+                          const double S, const double K, const double T, const double r,
+                          const double sigma, const double q, const OptionType type, const double bump) {
+            const double spots[kScenarios] = {S, S * (1.0 + bump), S * (1.0 - bump), S, S, S, S, S, S};
+            const double expiries[kScenarios] = {T, T, T, T * (1.0 + bump), T * (1.0 - bump), T, T, T, T};
+            const double vols[kScenarios] = {sigma, sigma, sigma, sigma, sigma, sigma + bump, sigma - bump, sigma, sigma};
+            const double rates[kScenarios] = {r, r, r, r, r, r, r, r + bump, r - bump};
+
+            for (std::size_t s = 0; s < kScenarios; ++s) {
+                const std::size_t lane = s * count + i;
+                block.spot[lane] = spots[s];
+                block.strike[lane] = K;
+                block.expiry[lane] = expiries[s];
+                block.rate[lane] = rates[s];
+                block.volatility[lane] = vols[s];
+                block.dividend[lane] = q;
+                block.type[lane] = type;
+            }
+        }
+
+        // Central differences in the units of calculateAll: theta per calendar
+        // day, vega and rho per 1% move
+        PricingResult scenarioGreeks(const ScenarioBlock& block, const std::size_t i, const std::size_t count,
+                                     const double S, const double T, const double bump) {
+            const auto price = [&](const std::size_t s) { return block.price[s * count + i]; };
+            const double h_spot = S * bump;
+            const double h_expiry = T * bump;
+
+            PricingResult result;
+            result.price = price(0);
+            result.delta = (price(1) - price(2)) / (2.0 * h_spot);
+            result.gamma = (price(1) - 2.0 * price(0) + price(2)) / (h_spot * h_spot);
+            result.theta = -(price(3) - price(4)) / (2.0 * h_expiry) / 365.0;
+            result.vega = (price(5) - price(6)) / (2.0 * bump) / 100.0;
+            result.rho = (price(7) - price(8)) / (2.0 * bump) / 100.0;
+            return result;
+        }
+    } // namespace
+
+    AmericanApproximationEngine::AmericanApproximationEngine(const AmericanApproximation method)
+        : method_(method) {}
+
+    double AmericanApproximationEngine::calculate(const OptionParameters& option) const {
+        PRICER_METRICS_TIMER(MetricsEngine::AmericanApproximation);
+        const double S = option.getSpot();
+        const double K = option.getStrike();
+        const double T = option.getExpiry();
+        const double r = option.getRate();
+        const double sigma = option.getVolatility();
+        const double q = option.getDividend();
+        const OptionType type = option.getType();
+
+        double price = 0.0;
+        priceChain(&S, &K, &T, &r, &sigma, &q, &type, &price, 1);
+        return price;
+    }
+
+    double AmericanApproximationEngine::calculateDelta(const OptionParameters& option) const {
+        return calculateAll(option).delta;
+    }
+
+    double AmericanApproximationEngine::calculateGamma(const OptionParameters& option) const {
+        return calculateAll(option).gamma;
+    }
+
+    double AmericanApproximationEngine::calculateTheta(const OptionParameters& option) const {
+        return calculateAll(option).theta;
+    }
+
+    double AmericanApproximationEngine::calculateVega(const OptionParameters& option) const {
+        return calculateAll(option).vega;
+    }
+
+    double AmericanApproximationEngine::calculateRho(const OptionParameters& option) const {
+        return calculateAll(option).rho;
+    }
+
+    PricingResult AmericanApproximationEngine::calculateAll(const OptionParameters& option) const {
+        PRICER_METRICS_TIMER(MetricsEngine::AmericanApproximation);
+        ScenarioBlock block;
+        setScenarios(block, 0, 1, option.getSpot(), option.getStrike(), option.getExpiry(),
+                     option.getRate(), option.getVolatility(), option.getDividend(),
+                     option.getType(), kBump);
+        priceChain(block.spot, block.strike, block.expiry, block.rate, block.volatility,
+                   block.dividend, block.type, block.price, kScenarios);
+        return scenarioGreeks(block, 0, 1, option.getSpot(), option.getExpiry(), kBump);
+    }
+
+    void AmericanApproximationEngine::priceBatch(const std::span<const double> spot,
+                                                 const std::span<const double> strike,
+                                                 const std::span<const double> expiry,
+                                                 const std::span<const double> rate,
+                                                 const std::span<const double> volatility,
+                                                 const std::span<const double> dividend,
+                                                 const std::span<const OptionType> type,
+                                                 const std::span<double> out) const {
+        PRICER_METRICS_TIMER(MetricsEngine::AmericanApproximation, out.size());
+        const std::size_t n = out.size();
+        if (spot.size() != n || strike.size() != n || expiry.size() != n || rate.size() != n
+            || volatility.size() != n || dividend.size() != n || type.size() != n) {
+            throw std::invalid_argument("Batch inputs must all have the same length");
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (expiry[i] <= 0.0) {
+                throw std::invalid_argument("Time to expiry must be positive");
+            }
+            if (volatility[i] <= 0.0) {
+                throw std::invalid_argument("Volatility must be positive");
+            }
+            if (spot[i] <= 0.0 || strike[i] <= 0.0) {
+                throw std::invalid_argument("Spot and strike prices must be positive");
+            }
+        }
+
+        const std::size_t chunk = method_ == AmericanApproximation::AndersenLakeOffengenden
+                                      ? kAloBatchChunk : kBatchChunk;
+        if (n <= chunk) {
+            priceChain(spot.data(), strike.data(), expiry.data(), rate.data(),
+                       volatility.data(), dividend.data(), type.data(), out.data(), n);
+            return;
+        }
+
+        ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+        pool.parallelFor((n + chunk - 1) / chunk, [&](const std::size_t index) {
+            const std::size_t begin = index * chunk;
+            const std::size_t count = std::min(chunk, n - begin);
+            priceChain(spot.data() + begin, strike.data() + begin, expiry.data() + begin,
+                       rate.data() + begin, volatility.data() + begin, dividend.data() + begin,
+                       type.data() + begin, out.data() + begin, count);
+        });
+    }
+
+    void AmericanApproximationEngine::priceBatch(const ContractBatch& batch, const std::span<double> out) const {
+        priceBatch(batch.spots(), batch.strikes(), batch.expiries(), batch.rates(),
+                   batch.volatilities(), batch.dividends(), batch.types(), out);
+    }
+
+    void AmericanApproximationEngine::calculateAllBatch(const ContractBatch& batch,
+                                                        const std::size_t begin,
+                                                        const std::span<PricingResult> out) const {
+        PRICER_METRICS_TIMER(MetricsEngine::AmericanApproximation, out.size());
+        if (begin + out.size() > batch.size()) {
+            throw std::out_of_range("Batch range exceeds the batch size");
+        }
+
+        ScenarioBlock block;
+
+        for (std::size_t offset = 0; offset < out.size(); offset += kGreekBlock) {
+            const std::size_t first = begin + offset;
+            const std::size_t count = std::min(kGreekBlock, out.size() - offset);
+            for (std::size_t i = 0; i < count; ++i) {
+                setScenarios(block, i, count, batch.spots()[first + i], batch.strikes()[first + i],
+                             batch.expiries()[first + i], batch.rates()[first + i],
+                             batch.volatilities()[first + i], batch.dividends()[first + i],
+                             batch.types()[first + i], kBump);
+            }
+
+            priceChain(block.spot, block.strike, block.expiry, block.rate, block.volatility,
+                       block.dividend, block.type, block.price, kScenarios * count);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                out[offset + i] = scenarioGreeks(block, i, count, batch.spots()[first + i],
+                                                 batch.expiries()[first + i], kBump);
+            }
+        }
+    }
+
+    void AmericanApproximationEngine::priceChain(const double* spot, const double* strike, const double* expiry,
+                                                 const double* rate, const double* volatility, const double* dividend,
+                                                 const OptionType* type, double* out, const std::size_t n) const {
+        switch (method_) {
+            case AmericanApproximation::BjerksundStensland:
+                bjerksundStenslandChain(spot, strike, expiry, rate, volatility, dividend, type, out, n);
+                break;
+            case AmericanApproximation::BaroneAdesiWhaley:
+                baroneAdesiWhaleyChain(spot, strike, expiry, rate, volatility, dividend, type, out, n);
+                break;
+            case AmericanApproximation::AndersenLakeOffengenden:
+                andersenLakeOffengendenChain(spot, strike, expiry, rate, volatility, dividend, type, out, n);
+                break;
+        }
+    }
+
+} // namespace pricer
@@ -0,0 +1,42 @@
+#include "pricer/async.h"
+#include "pricer/thread_pool.h"
+#include <exception>
+#include <utility>
+
+namespace pricer {
+
+PricingJob priceAsync(std::shared_ptr<const PricingEngine> engine,
+                      const OptionParameters& option,
+                      ProgressCallback progress,
+                      std::function<void()> finished,
+                      ThreadPool* pool) {
+    if (!engine) {
+        throw std::invalid_argument("priceAsync needs an engine");
+    }
+
+    PricingJob job;
+    auto control = std::make_shared<const JobControl>(JobControl{job.token, std::move(progress)});
+    // A promise rather than the task's own future, so finished runs once
+    // the result is already visible to whoever it notifies
+    auto promise = std::make_shared<std::promise<PricingResult>>();
+    job.result = promise->get_future().share();
+
+    ThreadPool& target = pool ? *pool : ThreadPool::global();
+    (void)target.submit([engine = std::move(engine), option, control, promise, finished = std::move(finished)] {
+        {
+            async::ScopedJob scope(control.get());
+            try {
+                async::checkpoint();
+                promise->set_value(engine->calculateAll(option));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        }
+        if (finished) {
+            finished();
+        }
+    });
+    return job;
+}
+
+} // namespace pricer
@@ -0,0 +1,509 @@
+#include "pricer/batch_io.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <ostream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PRICER_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PRICER_HAS_MMAP 0
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace pricer {
+
+namespace {
+    constexpr char kContractMagic[4] = {'O', 'P', 'C', 'B'};
+    constexpr char kResultMagic[4] = {'O', 'P', 'R', 'B'};
+    constexpr std::uint32_t kVersion = 1;
+    constexpr std::size_t kHeaderBytes = sizeof(kContractMagic) + sizeof(kVersion);
+    constexpr std::size_t kContractDoubles = 6;
+    constexpr std::size_t kResultDoubles = 7;
+
+    constexpr std::string_view kColumnNames[] = {
+        "type", "strike", "expiry", "spot", "rate", "volatility", "dividend", "exercise"};
+    constexpr std::size_t kRequiredColumns = 6;  // type ... volatility
+
+    // Rows of a uint8 column rounded up to whole doubles
+    std::size_t padded(const std::size_t rows) {
+        return (rows + 7) / 8 * 8;
+    }
+
+    std::size_t contractBlockBytes(const std::size_t rows) {
+        return kContractDoubles * sizeof(double) * rows + 2 * padded(rows);
+    }
+
+    template <typename T>
+    T load(const char* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void append(std::string& buffer, const T& value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void appendHeader(std::string& buffer, const char (&magic)[4]) {
+        buffer.append(magic, sizeof(magic));
+        append(buffer, kVersion);
+    }
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool equalsIgnoreCase(const std::string_view a, const std::string_view b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const char x, const char y) {
+            return (x >= 'A' && x <= 'Z' ? x - 'A' + 'a' : x) == y;
+        });
+    }
+
+    // The next line of contents from offset, without its line break
+    std::string_view nextLine(const std::string_view contents, std::size_t& offset) {
+        const std::size_t end = std::min(contents.find('\n', offset), contents.size());
+        const std::string_view line = contents.substr(offset, end - offset);
+        offset = std::min(end + 1, contents.size());
+        return line;
+    }
+
+    [[noreturn]] void malformed(const std::size_t line, const std::string& what) {
+        throw std::runtime_error("Malformed contract on line " + std::to_string(line) + ": " + what);
+    }
+
+    [[noreturn]] void malformed(const std::size_t line, const std::string_view field, const std::string_view what) {
+        std::string message = "'";
+        message.append(field).append("' ").append(what);
+        malformed(line, message);
+    }
+
+    double parseNumber(const std::string_view field, const std::size_t line) {
+        double value = 0.0;
+        const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+        if (error != std::errc() || end != field.data() + field.size()) {
+            malformed(line, field, "is not a number");
+        }
+        return value;
+    }
+
+    OptionType parseType(const std::string_view field, const std::size_t line) {
+        if (equalsIgnoreCase(field, "call") || equalsIgnoreCase(field, "c")) {
+            return OptionType::Call;
+        }
+        if (equalsIgnoreCase(field, "put") || equalsIgnoreCase(field, "p")) {
+            return OptionType::Put;
+        }
+        malformed(line, field, "is not call or put");
+    }
+
+    ExerciseStyle parseExercise(const std::string_view field, const std::size_t line) {
+        if (field.empty() || equalsIgnoreCase(field, "european") || equalsIgnoreCase(field, "e")) {
+            return ExerciseStyle::European;
+        }
+        if (equalsIgnoreCase(field, "american") || equalsIgnoreCase(field, "a")) {
+            return ExerciseStyle::American;
+        }
+        malformed(line, field, "is not european or american");
+    }
+
+    std::array<double, kResultDoubles> resultFields(const PricingResult& r) {
+        return {r.price, r.delta, r.gamma, r.theta, r.vega, r.rho, r.std_error};
+    }
+
+    void appendNumber(std::string& buffer, const double value) {
+        char text[32];
+        const auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+        buffer.append(text, error == std::errc() ? end : text);
+    }
+}
+
+MappedFile::MappedFile(const std::string& path) {
+#if PRICER_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Cannot map " + path);
+        }
+        // The file is read front to back once
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+        mapped_ = true;
+    } else {
+        ::close(fd);
+    }
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if PRICER_HAS_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+BatchFormat detectContractFormat(const std::string_view contents) {
+    const bool binary = contents.size() >= sizeof(kContractMagic)
+                        && std::memcmp(contents.data(), kContractMagic, sizeof(kContractMagic)) == 0;
+    return binary ? BatchFormat::Binary : BatchFormat::Csv;
+}
+
+ContractReader::ContractReader(const std::string_view contents)
+    : contents_(contents), format_(detectContractFormat(contents)) {
+    if (format_ == BatchFormat::Csv) {
+        readCsvHeader();
+        return;
+    }
+    if (contents_.size() < kHeaderBytes || load<std::uint32_t>(contents_.data() + sizeof(kContractMagic)) != kVersion) {
+        throw std::runtime_error("Unsupported binary contract file version");
+    }
+    offset_ = kHeaderBytes;
+}
+
+void ContractReader::readCsvHeader() {
+    if (contents_.empty()) {
+        throw std::runtime_error("Contract file is empty");
+    }
+    const std::string_view header = nextLine(contents_, offset_);
+    line_ = 1;
+
+    bool found[kNumColumns] = {};
+    for (std::size_t begin = 0; begin <= header.size();) {
+        const std::size_t end = std::min(header.find(',', begin), header.size());
+        const std::string_view name = trim(header.substr(begin, end - begin));
+        std::size_t column = kNumColumns;
+        for (std::size_t c = 0; c < kNumColumns; ++c) {
+            if (equalsIgnoreCase(name, kColumnNames[c])) {
+                column = c;
+            }
+        }
+        if (column < kNumColumns && found[column]) {
+            throw std::runtime_error("CSV header repeats the column '" + std::string(name) + "'");
+        }
+        if (column < kNumColumns) {
+            found[column] = true;
+        }
+        field_columns_.push_back(column);
+        begin = end + 1;
+    }
+
+    for (std::size_t c = 0; c < kRequiredColumns; ++c) {
+        if (!found[c]) {
+            throw std::runtime_error("CSV header has no '" + std::string(kColumnNames[c]) + "' column");
+        }
+    }
+}
+
+bool ContractReader::next(ContractBatch& batch, const std::size_t max_rows) {
+    batch.clear();
+    return format_ == BatchFormat::Csv ? nextCsv(batch, max_rows) : nextBinary(batch, max_rows);
+}
+
+bool ContractReader::nextCsv(ContractBatch& batch, const std::size_t max_rows) {
+    while (batch.size() < max_rows && offset_ < contents_.size()) {
+        const std::string_view line = nextLine(contents_, offset_);
+        ++line_;
+        if (trim(line).empty()) {
+            continue;
+        }
+
+        std::array<std::string_view, kNumColumns> values{};
+        std::size_t field = 0;
+        for (std::size_t begin = 0; begin <= line.size(); ++field) {
+            const std::size_t end = std::min(line.find(',', begin), line.size());
+            if (field < field_columns_.size() && field_columns_[field] < kNumColumns) {
+                values[field_columns_[field]] = trim(line.substr(begin, end - begin));
+            }
+            begin = end + 1;
+        }
+        if (field < field_columns_.size()) {
+            malformed(line_, "expected " + std::to_string(field_columns_.size()) + " fields, found "
+                             + std::to_string(field));
+        }
+
+        const ContractSpec contract{parseNumber(values[kStrike], line_),
+                                    parseNumber(values[kExpiry], line_),
+                                    parseType(values[kType], line_),
+                                    parseExercise(values[kExercise], line_)};
+        const MarketState market{parseNumber(values[kSpot], line_),
+                                 parseNumber(values[kRate], line_),
+                                 parseNumber(values[kVolatility], line_),
+                                 values[kDividend].empty() ? 0.0 : parseNumber(values[kDividend], line_)};
+        try {
+            batch.add(contract, market);
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Line " + std::to_string(line_) + ": " + e.what());
+        }
+    }
+    return !batch.empty();
+}
+
+bool ContractReader::nextBinary(ContractBatch& batch, const std::size_t max_rows) {
+    while (batch.size() < max_rows) {
+        if (block_read_ == block_rows_) {
+            if (offset_ == contents_.size()) {
+                break;
+            }
+            if (contents_.size() - offset_ < sizeof(std::uint64_t)) {
+                throw std::runtime_error("Truncated block header in binary contract file");
+            }
+            const auto rows = static_cast<std::size_t>(load<std::uint64_t>(contents_.data() + offset_));
+            block_offset_ = offset_ + sizeof(std::uint64_t);
+            if (rows > (contents_.size() - block_offset_) / (kContractDoubles * sizeof(double))
+                || contractBlockBytes(rows) > contents_.size() - block_offset_) {
+                throw std::runtime_error("Truncated block " + std::to_string(block_) + " in binary contract file");
+            }
+            offset_ = block_offset_ + contractBlockBytes(rows);
+            block_rows_ = rows;
+            block_read_ = 0;
+            ++block_;
+            continue;
+        }
+
+        const std::size_t count = std::min(max_rows - batch.size(), block_rows_ - block_read_);
+        const char* column = contents_.data() + block_offset_;
+        const std::size_t stride = block_rows_ * sizeof(double);
+        const char* types = column + kContractDoubles * stride;
+        const char* exercises = types + padded(block_rows_);
+        for (std::size_t i = block_read_; i < block_read_ + count; ++i) {
+            auto value = [&](const std::size_t c) { return load<double>(column + c * stride + i * sizeof(double)); };
+            const auto type = static_cast<std::uint8_t>(types[i]);
+            const auto exercise = static_cast<std::uint8_t>(exercises[i]);
+            if (type > 1 || exercise > 1) {
+                throw std::runtime_error("Invalid type or exercise in block " + std::to_string(block_ - 1)
+                                         + ", row " + std::to_string(i));
+            }
+            try {
+                batch.add({value(0), value(1), type == 0 ? OptionType::Call : OptionType::Put,
+                           exercise == 0 ? ExerciseStyle::European : ExerciseStyle::American},
+                          {value(2), value(3), value(4), value(5)});
+            } catch (const std::invalid_argument& e) {
+                throw std::invalid_argument("Block " + std::to_string(block_ - 1) + ", row "
+                                            + std::to_string(i) + ": " + e.what());
+            }
+        }
+        block_read_ += count;
+    }
+    return !batch.empty();
+}
+
+ResultWriter::ResultWriter(std::ostream& out, const BatchFormat format)
+    : out_(out), format_(format) {
+    if (format_ == BatchFormat::Csv) {
+        buffer_ = "price,delta,gamma,theta,vega,rho,std_error\n";
+    } else {
+        appendHeader(buffer_, kResultMagic);
+    }
+    flush(buffer_);
+}
+
+void ResultWriter::write(const std::span<const PricingResult> results) {
+    buffer_.clear();
+    if (format_ == BatchFormat::Csv) {
+        formatCsv(results, buffer_);
+    } else {
+        append(buffer_, static_cast<std::uint64_t>(results.size()));
+        for (std::size_t k = 0; k < kResultDoubles; ++k) {
+            for (const PricingResult& result : results) {
+                append(buffer_, resultFields(result)[k]);
+            }
+        }
+    }
+    flush(buffer_);
+}
+
+void ResultWriter::formatCsv(const std::span<const PricingResult> results, std::string& text) {
+    for (const PricingResult& result : results) {
+        const auto values = resultFields(result);
+        for (std::size_t k = 0; k < values.size(); ++k) {
+            appendNumber(text, values[k]);
+            text.push_back(k + 1 < values.size() ? ',' : '\n');
+        }
+    }
+}
+
+void ResultWriter::writeCsv(const std::span<const std::string> rows) {
+    if (format_ != BatchFormat::Csv) {
+        throw std::logic_error("writeCsv needs a CSV writer");
+    }
+    for (const std::string& text : rows) {
+        flush(text);
+    }
+}
+
+void ResultWriter::flush(const std::string_view bytes) {
+    out_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!out_) {
+        throw std::runtime_error("Failed to write results");
+    }
+}
+
+void writeContracts(std::ostream& out, const ContractBatch& batch, const BatchFormat format) {
+    std::string buffer;
+    const std::size_t n = batch.size();
+
+    if (format == BatchFormat::Csv) {
+        buffer = "type,strike,expiry,spot,rate,volatility,dividend,exercise\n";
+        for (std::size_t i = 0; i < n; ++i) {
+            const ContractSpec contract = batch.contract(i);
+            const MarketState market = batch.market(i);
+            buffer += contract.type == OptionType::Call ? "call," : "put,";
+            for (const double value : {contract.strike, contract.expiry, market.spot,
+                                       market.rate, market.volatility, market.dividend}) {
+                appendNumber(buffer, value);
+                buffer.push_back(',');
+            }
+            buffer += contract.exercise == ExerciseStyle::American ? "american\n" : "european\n";
+        }
+    } else {
+        appendHeader(buffer, kContractMagic);
+        append(buffer, static_cast<std::uint64_t>(n));
+        for (const auto column : {batch.strikes(), batch.expiries(), batch.spots(),
+                                  batch.rates(), batch.volatilities(), batch.dividends()}) {
+            buffer.append(reinterpret_cast<const char*>(column.data()), column.size_bytes());
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer.push_back(batch.types()[i] == OptionType::Call ? '\0' : '\1');
+        }
+        buffer.append(padded(n) - n, '\0');
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer.push_back(batch.exercises()[i] == ExerciseStyle::European ? '\0' : '\1');
+        }
+        buffer.append(padded(n) - n, '\0');
+    }
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write contracts");
+    }
+}
+
+BatchFilePricer::BatchFilePricer(std::shared_ptr<ThreadPool> pool)
+    : thread_pool_(std::move(pool)) {
+}
+
+void BatchFilePricer::setChunkRows(const std::size_t rows) {
+    if (rows == 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+    chunk_rows_ = rows;
+}
+
+void BatchFilePricer::setTaskSize(const std::size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Task size must be positive");
+    }
+    task_size_ = size;
+}
+
+BatchRunStats BatchFilePricer::price(const PricingEngine& engine,
+                                     const std::string_view contents,
+                                     std::ostream& out,
+                                     const BatchFormat format) const {
+    const auto start = std::chrono::steady_clock::now();
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    ContractReader reader(contents);
+    ResultWriter writer(out, format);
+
+    // Chunk c is parsed, priced and written in slot c % 3
+    struct Slot {
+        ContractBatch contracts;
+        std::vector<PricingResult> results;
+        std::vector<std::string> rows;  // CSV text of each pricing task
+    };
+    const bool csv = format == BatchFormat::Csv;
+    std::array<Slot, 3> slots;
+    auto parse = [&reader, rows = chunk_rows_](Slot& slot) { return reader.next(slot.contracts, rows); };
+
+    BatchRunStats stats;
+    std::future<bool> parsed = pool.submit([&] { return parse(slots[0]); });
+    std::future<void> written;
+    try {
+        for (std::size_t chunk = 0; parsed.get(); ++chunk) {
+            Slot& slot = slots[chunk % 3];
+
+            // The next slot last held chunk - 2, which has been written
+            parsed = pool.submit([&parse, &next = slots[(chunk + 1) % 3]] { return parse(next); });
+
+            const std::size_t n = slot.contracts.size();
+            const std::size_t tasks = (n + task_size_ - 1) / task_size_;
+            slot.results.resize(n);
+            slot.rows.resize(csv ? tasks : 0);
+            pool.parallelFor(tasks, [&](const std::size_t t) {
+                const std::size_t begin = t * task_size_;
+                const auto results = std::span(slot.results).subspan(begin, std::min(task_size_, n - begin));
+                engine.calculateAllBatch(slot.contracts, begin, results);
+                if (csv) {
+                    slot.rows[t].clear();
+                    ResultWriter::formatCsv(results, slot.rows[t]);
+                }
+            });
+
+            if (written.valid()) {
+                written.get();
+            }
+            written = pool.submit([&writer, &slot, csv] {
+                if (csv) {
+                    writer.writeCsv(slot.rows);
+                } else {
+                    writer.write(slot.results);
+                }
+            });
+            stats.contracts += n;
+            ++stats.chunks;
+        }
+        if (written.valid()) {
+            written.get();
+        }
+    } catch (...) {
+        // Stages still queued refer to this frame
+        if (parsed.valid()) {
+            parsed.wait();
+        }
+        if (written.valid()) {
+            written.wait();
+        }
+        throw;
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace pricer
@@ -1,11 +1,126 @@
 #include "pricer/binomial.h"
+#include "pricer/async.h"
+#include "pricer/metrics.h"
+#include "vanilla_kernel.h"
+#include "vector_math.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
-#include <iostream>
-#include <ostream>
+#include <deque>
 #include <stdexcept>
 
 namespace pricer {
 
+namespace {
+    // One backward step over the nodes [0, count) of a rolling layer:
+    // values[j] <- pd * values[j] + pu * values[j + 1]. Every read of
+    // values[j + 1] happens before its own update, so the loop vectorizes.
+    PRICER_SIMD_CLONES
+    void inductEuropean(double* values, const std::size_t count, const double pu, const double pd) {
+        for (std::size_t j = 0; j < count; ++j) {
+            values[j] = pd * values[j] + pu * values[j + 1];
+        }
+    }
+
+    // As above with early exercise against max(w * (S - K), 0), w = +1 call / -1 put
+    PRICER_SIMD_CLONES
+    void inductAmerican(double* values, const double* spots, const std::size_t count,
+                        const double pu, const double pd, const double w, const double strike) {
+        for (std::size_t j = 0; j < count; ++j) {
+            const double continuation = pd * values[j] + pu * values[j + 1];
+            const double exercise = std::max(w * (spots[j] - strike), 0.0);
+            values[j] = std::max(continuation, exercise);
+        }
+    }
+
+    // The lattice is extended two steps into the past (Pelsser & Vorst 1994),
+    // so layer 2 holds today's nodes S u^2, S, S d^2 and the price is V(2, 1).
+    // Theta is centred on today from V(0, 0) and V(4, 2), which share the
+    // spot; a one-step tree has no layer 4 and falls back to V(2, 1).
+    template <typename Spot, typename Value>
+    PricingResult latticeGreeks(const Spot& spot, const Value& value, const size_t steps, const double dt) {
+        PricingResult result;
+        result.price = value(2, 1);
+        result.delta = (value(2, 2) - value(2, 0)) / (spot(2, 2) - spot(2, 0));
+
+        const double delta_up = (value(2, 2) - value(2, 1)) / (spot(2, 2) - spot(2, 1));
+        const double delta_down = (value(2, 1) - value(2, 0)) / (spot(2, 1) - spot(2, 0));
+        result.gamma = (delta_up - delta_down) / ((spot(2, 2) - spot(2, 0)) / 2.0);
+
+        const size_t layer = steps >= 2 ? 4 : 2;
+        result.theta = (value(layer, layer / 2) - value(0, 0)) / (static_cast<double>(layer) * dt) / 365.0;
+
+        return result;
+    }
+
+    // Richardson extrapolation of the lattice price and Greeks between the
+    // N-step tree in coarse and the 2N-step tree in fine
+    void extrapolate(PricingResult& coarse, const PricingResult& fine) {
+        coarse.price = 2.0 * fine.price - coarse.price;
+        coarse.delta = 2.0 * fine.delta - coarse.delta;
+        coarse.gamma = 2.0 * fine.gamma - coarse.gamma;
+        coarse.theta = 2.0 * fine.theta - coarse.theta;
+    }
+
+    // Absolute volatility and rate bump of vega and rho
+    constexpr double kBump = 0.0001;
+
+    // Calls body(type, style, indices) once per (option type, exercise style)
+    // group of the contracts [begin, begin + count), with the indices relative
+    // to begin and the type and style as compile-time constants
+    template <typename Body>
+    void forEachGroup(const ContractBatch& batch, const size_t begin, const size_t count, Body&& body) {
+        std::array<std::vector<size_t>, 4> groups;
+        for (size_t i = 0; i < count; ++i) {
+            const bool put = batch.types()[begin + i] == OptionType::Put;
+            const bool american = batch.exercises()[begin + i] == ExerciseStyle::American;
+            groups[2 * put + american].push_back(i);
+        }
+
+        for (size_t g = 0; g < groups.size(); ++g) {
+            if (groups[g].empty()) {
+                continue;
+            }
+            const OptionType type = g / 2 ? OptionType::Put : OptionType::Call;
+            const ExerciseStyle exercise = g % 2 ? ExerciseStyle::American : ExerciseStyle::European;
+            vanilla::dispatch(type, exercise, [&](const auto type_constant, const auto style_constant) {
+                body(type_constant, style_constant, groups[g]);
+            });
+        }
+    }
+}
+
+// Spot lattices shared by the contracts of one batch task. An entry is keyed
+// by every input its nodes depend on, so contracts on another spot,
+// volatility or time step get their own.
+class BinomialTreeEngine::LatticeCache {
+public:
+    const SpotLattice& get(const OptionParameters& option, const size_t layers, const double dt,
+                           const bool american) {
+        for (const Entry& entry : entries_) {
+            if (entry.spot == option.getSpot() && entry.volatility == option.getVolatility()
+                && entry.dt == dt && entry.layers == layers && entry.american == american) {
+                return entry.lattice;
+            }
+        }
+        entries_.push_back({option.getSpot(), option.getVolatility(), dt, layers, american,
+                            buildSpotLattice(option, layers, dt, american)});
+        return entries_.back().lattice;
+    }
+
+private:
+    struct Entry {
+        double spot;
+        double volatility;
+        double dt;
+        size_t layers;
+        bool american;
+        SpotLattice lattice;
+    };
+
+    std::deque<Entry> entries_;
+};
+
 BinomialTreeEngine::BinomialTreeEngine(size_t num_steps, bool use_bbs)
     : num_steps_(num_steps)
     , use_bbs_(use_bbs) {
@@ -14,44 +129,143 @@ BinomialTreeEngine::BinomialTreeEngine(size_t num_steps, bool use_bbs)
     }
 }
 
-double BinomialTreeEngine::calculate(const Option& option) const {
-    double value = calculateWithParameters(option, num_steps_);
-
+double BinomialTreeEngine::calculate(const OptionParameters& option) const {
+    PRICER_METRICS_TIMER(MetricsEngine::BinomialTree);
     if (use_bbs_) {
-        value = applyBBSExtrapolation(option, value);
+        const auto [coarse, fine] = calculateLatticePair(option);
+        return 2.0 * fine.price - coarse.price;
     }
 
-    return value;
+    return calculateWithParameters(option, num_steps_);
 }
 
-double BinomialTreeEngine::calculateWithParameters(const Option& option, size_t steps) const {
-    // Store original number of steps
-    const size_t original_steps = num_steps_;
-    const_cast<BinomialTreeEngine*>(this)->num_steps_ = steps;
+double BinomialTreeEngine::calculateWithParameters(const OptionParameters& option, size_t steps) const {
+    return calculateLattice(option, steps).price;
+}
+
+PricingResult BinomialTreeEngine::calculateLattice(const OptionParameters& option, size_t steps) const {
+    return vanilla::dispatch(option.getType(), option.getExercise(), [&](const auto type, const auto style) {
+        return calculateLatticeKernel<decltype(type)::value, decltype(style)::value>(option, steps);
+    });
+}
+
+template <OptionType Type, ExerciseStyle Style>
+PricingResult BinomialTreeEngine::calculateLatticeKernel(const OptionParameters& option, size_t steps,
+                                                         LatticeCache* cache) const {
+    const double dt = option.getExpiry() / steps;
+    const size_t layers = steps + kExtraLayers;
+    PRICER_METRICS_ADD(MetricsEngine::BinomialTree, MetricsCounter::Nodes, (layers + 1) * (layers + 2) / 2);
+
+    if (storage_ == TreeStorage::Rolling) {
+        constexpr bool american = Style == ExerciseStyle::American;
+        if (cache) {
+            return calculateRollingLattice<Type, Style>(option, cache->get(option, layers, dt, american), dt);
+        }
+        return calculateRollingLattice<Type, Style>(option, buildSpotLattice(option, layers, dt, american), dt);
+    }
 
     // Build price tree
-    const auto price_tree = buildPriceTree(option);
+    const auto price_tree = buildPriceTree(option, layers, dt);
 
     // Calculate option values
-    const bool is_american = dynamic_cast<const AmericanOption*>(&option) != nullptr;
-    const auto option_values = calculateOptionValues(option, price_tree, is_american);
+    const auto option_values = calculateOptionValues<Type, Style>(option, price_tree, layers, dt);
+
+    auto spot = [&](size_t step, size_t node) { return price_tree[getIndex(step, node)]; };
+    auto value = [&](size_t step, size_t node) { return option_values[getIndex(step, node)]; };
+    return latticeGreeks(spot, value, steps, dt);
+}
+
+BinomialTreeEngine::SpotLattice BinomialTreeEngine::buildSpotLattice(const OptionParameters& option,
+                                                                      const size_t layers, const double dt,
+                                                                      const bool american) {
+    auto [u, d, p] = calculateParameters(option, dt);
+    SpotLattice lattice{u, d, std::vector<double>(2 * layers + 1), {}};
+
+    // ladder[layers + m] = S u^m, grown outwards from the spot by repeated
+    // multiplication, so no node needs a pow
+    std::vector<double>& ladder = lattice.ladder;
+    ladder[layers] = option.getSpot();
+    for (size_t m = 1; m <= layers; ++m) {
+        ladder[layers + m] = ladder[layers + m - 1] * u;
+        ladder[layers - m] = ladder[layers - m + 1] * d;
+    }
 
-    // Restore original number of steps
-    const_cast<BinomialTreeEngine*>(this)->num_steps_ = original_steps;
+    // Node j of layer i sits at S u^(2j - i): rung 2j + (layers - i) of the
+    // ladder, i.e. element j + (layers - i) / 2 of the rungs with the parity
+    // of layers - i. Splitting the parities keeps every layer contiguous.
+    if (american) {
+        for (size_t parity = 0; parity < 2; ++parity) {
+            lattice.levels[parity].resize(layers + 1 - parity);
+            for (size_t k = 0; k < lattice.levels[parity].size(); ++k) {
+                lattice.levels[parity][k] = ladder[2 * k + parity];
+            }
+        }
+    }
 
-    // Return root node value
-    return option_values[0];
+    return lattice;
 }
 
-std::vector<double> BinomialTreeEngine::buildPriceTree(const Option& option) const {
-    const double dt = option.getExpiry() / num_steps_;
+template <OptionType Type, ExerciseStyle Style>
+PricingResult BinomialTreeEngine::calculateRollingLattice(const OptionParameters& option,
+                                                          const SpotLattice& lattice, const double dt) const {
+    const double u = lattice.up;
+    const double d = lattice.down;
+    const double p = (std::exp((option.getRate() - option.getDividend()) * dt) - d) / (u - d);
+    const double df = std::exp(-option.getRate() * dt);
+    const double pu = df * p;
+    const double pd = df * (1.0 - p);
+    const double strike = option.getStrike();
+    constexpr bool is_american = Style == ExerciseStyle::American;
+
+    const std::vector<double>& ladder = lattice.ladder;
+    const size_t layers = ladder.size() / 2;
+    auto spot = [&](size_t step, size_t node) { return ladder[layers + 2 * node - step]; };
+    const std::vector<double>* levels = lattice.levels;
+
+    std::vector<double> values(layers + 1);
+    for (size_t node = 0; node <= layers; ++node) {
+        values[node] = vanilla::intrinsic<Type>(ladder[2 * node], strike);
+    }
+
+    // Keep the layers the Greeks read as the induction passes them
+    double layer2[3] = {};
+    double layer4_middle = 0.0;
+    auto capture = [&](const size_t step) {
+        if (step == 4) {
+            layer4_middle = values[2];
+        } else if (step == 2) {
+            std::copy_n(values.begin(), 3, layer2);
+        }
+    };
+
+    capture(layers);
+    for (size_t step = layers - 1; step != size_t(-1); --step) {
+        async::checkpoint();
+        if constexpr (is_american) {
+            const size_t back = layers - step;
+            inductAmerican(values.data(), levels[back % 2].data() + back / 2, step + 1, pu, pd,
+                           vanilla::kPhi<Type>, strike);
+        } else {
+            inductEuropean(values.data(), step + 1, pu, pd);
+        }
+        capture(step);
+    }
+
+    auto value = [&](size_t step, size_t node) {
+        return step == 0 ? values[0] : step == 2 ? layer2[node] : layer4_middle;
+    };
+    return latticeGreeks(spot, value, layers - kExtraLayers, dt);
+}
+
+std::vector<double> BinomialTreeEngine::buildPriceTree(const OptionParameters& option, const size_t steps,
+                                                       const double dt) const {
     auto [u, d, p] = calculateParameters(option, dt);
 
-    std::vector<double> price_tree((num_steps_ + 1) * (num_steps_ + 2) / 2);
+    std::vector<double> price_tree((steps + 1) * (steps + 2) / 2);
     double S = option.getSpot();
 
     // Build tree from bottom to top
-    for (size_t step = 0; step <= num_steps_; ++step) {
+    for (size_t step = 0; step <= steps; ++step) {
         for (size_t node = 0; node <= step; ++node) {
             // Calculate price at this node
             price_tree[getIndex(step, node)] = S * std::pow(u, node) * std::pow(d, step - node);
@@ -61,25 +275,27 @@ std::vector<double> BinomialTreeEngine::buildPriceTree(const Option& option) con
     return price_tree;
 }
 
+template <OptionType Type, ExerciseStyle Style>
 std::vector<double> BinomialTreeEngine::calculateOptionValues(
-    const Option& option,
+    const OptionParameters& option,
     const std::vector<double>& price_tree,
-    bool american) const {
+    const size_t steps,
+    const double dt) const {
 
-    const double dt = option.getExpiry() / num_steps_;
     auto [u, d, p] = calculateParameters(option, dt);
     const double df = std::exp(-option.getRate() * dt);
-
-    std::vector<double> values((num_steps_ + 1) * (num_steps_ + 2) / 2);
+    const double strike = option.getStrike();
+    std::vector<double> values((steps + 1) * (steps + 2) / 2);
 
     // Initialize terminal values
-    for (size_t node = 0; node <= num_steps_; ++node) {
-        values[getIndex(num_steps_, node)] =
-            calculatePayoff(option, price_tree[getIndex(num_steps_, node)]);
+    for (size_t node = 0; node <= steps; ++node) {
+        values[getIndex(steps, node)] =
+            vanilla::intrinsic<Type>(price_tree[getIndex(steps, node)], strike);
     }
 
     // Work backwards through the tree
-    for (size_t step = num_steps_ - 1; step != size_t(-1); --step) {
+    for (size_t step = steps - 1; step != size_t(-1); --step) {
+        async::checkpoint();
         for (size_t node = 0; node <= step; ++node) {
             // Get option value from backwards induction
             double continuation = df * (
@@ -87,9 +303,9 @@ std::vector<double> BinomialTreeEngine::calculateOptionValues(
                 (1 - p) * values[getIndex(step + 1, node)]
             );
 
-            if (american) {
+            if constexpr (Style == ExerciseStyle::American) {
                 // Check for early exercise
-                double exercise = calculatePayoff(option, price_tree[getIndex(step, node)]);
+                double exercise = vanilla::intrinsic<Type>(price_tree[getIndex(step, node)], strike);
                 values[getIndex(step, node)] = std::max(continuation, exercise);
             } else {
                 values[getIndex(step, node)] = continuation;
@@ -101,7 +317,7 @@ std::vector<double> BinomialTreeEngine::calculateOptionValues(
 }
 
 std::tuple<double, double, double> BinomialTreeEngine::calculateParameters(
-    const Option& option,
+    const OptionParameters& option,
     const double dt) {
     const double sigma = option.getVolatility();
     const double r = option.getRate();
@@ -117,116 +333,168 @@ std::tuple<double, double, double> BinomialTreeEngine::calculateParameters(
     return {u, d, p};
 }
 
-double BinomialTreeEngine::applyBBSExtrapolation(
-    const Option& option,
-    const double value) const {
+std::pair<PricingResult, PricingResult> BinomialTreeEngine::calculateLatticePair(
+    const OptionParameters& option) const {
 
-    // Calculate with double the steps
-    const size_t double_steps = 2 * num_steps_;
-    const double value2 = calculateWithParameters(option, double_steps);
+    // The two trees share nothing, so the finer one runs on the pool meanwhile
+    const size_t steps[] = {num_steps_, 2 * num_steps_};
+    PricingResult results[2];
 
-    // Apply Richardson extrapolation
-    return 2.0 * value2 - value;
-}
-
-double BinomialTreeEngine::calculatePayoff(
-    const Option& option,
-    const double spot_price) {
-    const double strike = option.getStrike();
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    const JobControl* job = async::currentJob();
+    pool.parallelFor(2, [&](const size_t i) {
+        const async::ScopedJob scope(job);
+        results[i] = calculateLattice(option, steps[i]);
+    });
 
-    if (option.getType() == OptionType::Call) {
-        return std::max(spot_price - strike, 0.0);
-    } else {
-        return std::max(strike - spot_price, 0.0);
-    }
+    return {results[0], results[1]};
 }
 
 size_t BinomialTreeEngine::getIndex(size_t step, size_t node) {
     return (step * (step + 1)) / 2 + node;
 }
 
-double BinomialTreeEngine::calculateDelta(const Option& option) const {
-    const double h = 0.01 * option.getSpot();
-    double spot = option.getSpot();
-
-    const_cast<Option&>(option).setSpot(spot + h);
-    double up_price = calculate(option);
-
-    const_cast<Option&>(option).setSpot(spot - h);
-    double down_price = calculate(option);
-
-    const_cast<Option&>(option).setSpot(spot);
+PricingResult BinomialTreeEngine::calculateLatticeGreeks(const OptionParameters& option) const {
+    if (!use_bbs_) {
+        return calculateLattice(option, num_steps_);
+    }
 
-    return (up_price - down_price) / (2.0 * h);
+    // Extrapolate the lattice Greeks the same way as the price
+    auto [result, fine] = calculateLatticePair(option);
+    extrapolate(result, fine);
+    return result;
 }
 
-double BinomialTreeEngine::calculateGamma(const Option& option) const {
-    const double h = 0.01 * option.getSpot();
-    double spot = option.getSpot();
-
-    const_cast<Option&>(option).setSpot(spot + h);
-    double up_price = calculate(option);
-
-    const_cast<Option&>(option).setSpot(spot - h);
-    double down_price = calculate(option);
+double BinomialTreeEngine::calculateDelta(const OptionParameters& option) const {
+    return calculateLatticeGreeks(option).delta;
+}
 
-    const_cast<Option&>(option).setSpot(spot);
-    double mid_price = calculate(option);
+double BinomialTreeEngine::calculateGamma(const OptionParameters& option) const {
+    return calculateLatticeGreeks(option).gamma;
+}
 
-    return (up_price - 2.0 * mid_price + down_price) / (h * h);
+double BinomialTreeEngine::calculateTheta(const OptionParameters& option) const {
+    return calculateLatticeGreeks(option).theta;
 }
 
-    double BinomialTreeEngine::calculateTheta(const Option& option) const {
-    // More robust theta calculation
-    const double h = 1.0 / 365.0;  // Trading days in a year
-    const double expiry = option.getExpiry();
+double BinomialTreeEngine::calculateVega(const OptionParameters& option) const {
+    const double h = kBump;
+    const double vol = option.getVolatility();
 
-    // Slightly different approach to calculating price change
-    double original_price = calculateWithParameters(option, num_steps_);
+    const double up_price = calculate(option.withVolatility(vol + h));
+    const double down_price = calculate(option.withVolatility(vol - h));
 
-    // Use forward and backward pricing
-    const_cast<Option&>(option).setExpiry(expiry - h);
-    const double backward_price = calculateWithParameters(option, num_steps_);
+    // Per 1% change in volatility
+    return (up_price - down_price) / (2.0 * h) / 100.0;
+}
 
-    const_cast<Option&>(option).setExpiry(expiry + h);
-    const double forward_price = calculateWithParameters(option, num_steps_);
+double BinomialTreeEngine::calculateRho(const OptionParameters& option) const {
+    const double h = kBump;
+    const double rate = option.getRate();
 
-    // Restore original expiry
-    const_cast<Option&>(option).setExpiry(expiry);
+    const double up_price = calculate(option.withRate(rate + h));
+    const double down_price = calculate(option.withRate(rate - h));
 
-    // Central difference method
-    return (forward_price - backward_price) / (2.0 * h);
+    // Per 1% change in rate
+    return (up_price - down_price) / (2.0 * h) / 100.0;
 }
 
+PricingResult BinomialTreeEngine::calculateAll(const OptionParameters& option) const {
+    PRICER_METRICS_TIMER(MetricsEngine::BinomialTree);
+    // The price is final once the lattice is done; the bumped trees only add vega and rho
+    PricingResult result = calculateLatticeGreeks(option);
+    async::report({1.0 / 3.0, true, result});
+    result.vega = calculateVega(option);
+    async::report({2.0 / 3.0, true, result});
+    result.rho = calculateRho(option);
+    async::report({1.0, true, result});
+    return result;
+}
 
-double BinomialTreeEngine::calculateVega(const Option& option) const {
-    const double h = 0.0001;
-    const double vol = option.getVolatility();
-
-    const_cast<Option&>(option).setVolatility(vol + h);
-    const double up_price = calculate(option);
-
-    const_cast<Option&>(option).setVolatility(vol - h);
-    const double down_price = calculate(option);
+template <OptionType Type, ExerciseStyle Style>
+PricingResult BinomialTreeEngine::calculateContract(const OptionParameters& option, const bool greeks,
+                                                    LatticeCache& cache) const {
+    auto lattice = [&](const OptionParameters& contract) {
+        PricingResult result = calculateLatticeKernel<Type, Style>(contract, num_steps_, &cache);
+        if (use_bbs_) {
+            extrapolate(result, calculateLatticeKernel<Type, Style>(contract, 2 * num_steps_, &cache));
+        }
+        return result;
+    };
 
-    const_cast<Option&>(option).setVolatility(vol);
+    PricingResult result = lattice(option);
+    if (!greeks) {
+        return result;
+    }
 
-    return (up_price - down_price) / (2.0 * h);
+    // Per 1% change in volatility and rate
+    const double vol = option.getVolatility();
+    const double rate = option.getRate();
+    result.vega = (lattice(option.withVolatility(vol + kBump)).price
+                   - lattice(option.withVolatility(vol - kBump)).price) / (2.0 * kBump) / 100.0;
+    result.rho = (lattice(option.withRate(rate + kBump)).price
+                  - lattice(option.withRate(rate - kBump)).price) / (2.0 * kBump) / 100.0;
+    return result;
 }
 
-double BinomialTreeEngine::calculateRho(const Option& option) const {
-    const double h = 0.0001;
-    double rate = option.getRate();
+void BinomialTreeEngine::priceBatch(const ContractBatch& batch, const std::span<double> out) const {
+    PRICER_METRICS_TIMER(MetricsEngine::BinomialTree, out.size());
+    if (out.size() != batch.size()) {
+        throw std::invalid_argument("Batch inputs must all have the same length");
+    }
 
-    const_cast<Option&>(option).setRate(rate + h);
-    double up_price = calculate(option);
+    calculateBatch(batch, 0, batch.size(), [&](const size_t i, const PricingResult& result) {
+        out[i] = result.price;
+    }, false);
+}
 
-    const_cast<Option&>(option).setRate(rate - h);
-    double down_price = calculate(option);
+void BinomialTreeEngine::calculateAllBatch(const ContractBatch& batch,
+                                           const std::size_t begin,
+                                           const std::span<PricingResult> out) const {
+    PRICER_METRICS_TIMER(MetricsEngine::BinomialTree, out.size());
+    if (begin + out.size() > batch.size()) {
+        throw std::out_of_range("Batch range exceeds the batch size");
+    }
 
-    const_cast<Option&>(option).setRate(rate);
+    calculateBatch(batch, begin, out.size(), [&](const size_t i, const PricingResult& result) {
+        out[i] = result;
+    }, true);
+}
 
-    return (up_price - down_price) / (2.0 * h);
+void BinomialTreeEngine::calculateBatch(const ContractBatch& batch, const size_t begin, const size_t count,
+                                        const std::function<void(size_t, const PricingResult&)>& store,
+                                        const bool greeks) const {
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    const std::span<const std::uint32_t> terms = batch.termIndices();
+    const std::span<const double> volatilities = batch.volatilities();
+
+    forEachGroup(batch, begin, count, [&](const auto type, const auto style, std::vector<size_t>& indices) {
+        // Contracts on one underlying, expiry and volatility share their spot
+        // lattices, so each task takes a run of them, capped to keep the pool busy
+        std::stable_sort(indices.begin(), indices.end(), [&](const size_t a, const size_t b) {
+            return std::pair(terms[begin + a], volatilities[begin + a])
+                   < std::pair(terms[begin + b], volatilities[begin + b]);
+        });
+
+        std::vector<size_t> runs{0};
+        for (size_t k = 1; k < indices.size(); ++k) {
+            const size_t a = begin + indices[k - 1];
+            const size_t b = begin + indices[k];
+            if (terms[a] != terms[b] || volatilities[a] != volatilities[b] || k - runs.back() == kLatticeRun) {
+                runs.push_back(k);
+            }
+        }
+        runs.push_back(indices.size());
+
+        pool.parallelFor(runs.size() - 1, [&](const size_t run) {
+            LatticeCache cache;
+            for (size_t k = runs[run]; k < runs[run + 1]; ++k) {
+                const size_t i = indices[k];
+                store(i, calculateContract<decltype(type)::value, decltype(style)::value>(
+                             {batch.contract(begin + i), batch.market(begin + i)}, greeks, cache));
+            }
+        });
+    });
 }
 
-} // namespace pricer
\ No newline at end of file
+} // namespace pricer
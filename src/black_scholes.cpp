@@ -2,22 +2,129 @@
 // Created by Yusufu Shehu on 18/01/2025.
 //
 #include "pricer/black_scholes.h"
+#include "pricer/metrics.h"
+#include "pricer/trace.h"
+#include "vector_math.h"
+#include <algorithm>
 #include <cmath>
-#include <iomanip>
+#include <cstdint>
 #include <stdexcept>
-#include <iostream>
 
 namespace pricer {
     namespace {
-        // Helper function for debug output
-        void debugPrint(const std::string& label, double value) {
-            std::cout << std::setw(30) << std::left << label << " = "
-                      << std::fixed << std::setprecision(6) << value << std::endl;
+        constexpr const char* kTraceName = "BlackScholes";
+
+        // Contracts per call of the Greek kernel, sized for stack scratch arrays
+        constexpr std::size_t kGreekBlock = 256;
+
+        // Expiry terms of a block of contracts, gathered into contiguous rows
+        // so the kernels read them like the batch's own arrays
+        struct TermBlock {
+            double sqrt_expiry[kGreekBlock];
+            double rate_discount[kGreekBlock];
+            double dividend_discount[kGreekBlock];
+            double log_forward[kGreekBlock];
+
+            void gather(const std::uint32_t* term, const ExpiryTerms* terms, const std::size_t n) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const ExpiryTerms& shared = terms[term[i]];
+                    sqrt_expiry[i] = shared.sqrt_expiry;
+                    rate_discount[i] = shared.rate_discount;
+                    dividend_discount[i] = shared.dividend_discount;
+                    log_forward[i] = shared.log_forward;
+                }
+            }
+        };
+
+        // Fused chain kernel: every contract takes the same instruction stream,
+        // so the loop vectorizes across contracts.
+        // price = w * (S e^{-qT} N(w d1) - K e^{-rT} N(w d2)), w = +1 call / -1 put
+        PRICER_SIMD_CLONES
+        void priceChain(const double* spot, const double* strike, const double* expiry,
+                        const double* rate, const double* volatility, const double* dividend,
+                        const OptionType* type, double* out, const std::size_t n,
+                        const NormalAccuracy accuracy) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double S = spot[i];
+                const double K = strike[i];
+                const double T = expiry[i];
+                const double r = rate[i];
+                const double sigma = volatility[i];
+                const double q = dividend[i];
+
+                const double vol_sqrt_t = sigma * std::sqrt(T);
+                const double d1 = (simd::log(S / K) + (r - q + sigma * sigma / 2.0) * T) / vol_sqrt_t;
+                const double d2 = d1 - vol_sqrt_t;
+                const double w = type[i] == OptionType::Call ? 1.0 : -1.0;
+
+                out[i] = w * (S * simd::exp(-q * T) * simd::normalCDF(w * d1, accuracy)
+                              - K * simd::exp(-r * T) * simd::normalCDF(w * d2, accuracy));
+            }
+        }
+
+        // priceChain for at most kGreekBlock contracts of a ContractBatch,
+        // with the discount factors, sqrt(T) and forward from the batch's
+        // shared expiry terms; d1 = (ln(F / K) + sigma^2 T / 2) / (sigma sqrt(T))
+        PRICER_SIMD_CLONES
+        void priceChainTerms(const double* spot, const double* strike, const double* volatility,
+                             const OptionType* type, const TermBlock& terms, double* out,
+                             const std::size_t n, const NormalAccuracy accuracy) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double K = strike[i];
+
+                const double vol_sqrt_t = volatility[i] * terms.sqrt_expiry[i];
+                const double d1 = (terms.log_forward[i] - simd::log(K)) / vol_sqrt_t + 0.5 * vol_sqrt_t;
+                const double d2 = d1 - vol_sqrt_t;
+                const double w = type[i] == OptionType::Call ? 1.0 : -1.0;
+
+                out[i] = w * (spot[i] * terms.dividend_discount[i] * simd::normalCDF(w * d1, accuracy)
+                              - K * terms.rate_discount[i] * simd::normalCDF(w * d2, accuracy));
+            }
+        }
+
+        // Price and Greeks of ContractBatch contracts in the units of
+        // calculateAll, one output row per field so the stores stay contiguous
+        PRICER_SIMD_CLONES
+        void greekChain(const double* spot, const double* strike, const double* expiry,
+                        const double* rate, const double* volatility, const double* dividend,
+                        const OptionType* type, const TermBlock& terms, double (*out)[kGreekBlock],
+                        const std::size_t n, const NormalAccuracy accuracy) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double S = spot[i];
+                const double K = strike[i];
+                const double T = expiry[i];
+                const double r = rate[i];
+                const double sigma = volatility[i];
+                const double q = dividend[i];
+
+                const double sqrt_t = terms.sqrt_expiry[i];
+                const double vol_sqrt_t = sigma * sqrt_t;
+                const double d1 = (terms.log_forward[i] - simd::log(K)) / vol_sqrt_t + 0.5 * vol_sqrt_t;
+                const double d2 = d1 - vol_sqrt_t;
+                const double w = type[i] == OptionType::Call ? 1.0 : -1.0;
+
+                const double df_q = terms.dividend_discount[i];
+                const double spot_pv = S * df_q;
+                const double strike_pv = K * terms.rate_discount[i];
+                const double pdf_d1 = simd::normalPDF(d1);
+                const double nd1 = simd::normalCDF(w * d1, accuracy);
+                const double nd2 = simd::normalCDF(w * d2, accuracy);
+                const double common_term = -(spot_pv * pdf_d1 * sigma) / (2.0 * sqrt_t);
+
+                out[0][i] = w * (spot_pv * nd1 - strike_pv * nd2);
+                out[1][i] = w * df_q * nd1;
+                out[2][i] = df_q * pdf_d1 / (S * vol_sqrt_t);
+                out[3][i] = (common_term - w * (r * strike_pv * nd2 - q * spot_pv * nd1)) / 365.0;
+                out[4][i] = spot_pv * pdf_d1 * sqrt_t / 100.0;
+                out[5][i] = w * strike_pv * T * nd2 / 100.0;
+            }
         }
 
     }
 
-    double BlackScholesPricingEngine::calculate(const Option& option) const {
+    double BlackScholesPricingEngine::calculate(const OptionParameters& option) const {
+        PRICER_METRICS_TIMER(MetricsEngine::BlackScholes);
+
         // Extract parameters from the option
         const double S = option.getSpot();
         const double K = option.getStrike();
@@ -26,47 +133,44 @@ namespace pricer {
         const double sigma = option.getVolatility();
         const double q = option.getDividend();
 
-        std::cout << "\nBlack-Scholes Calculation:" << std::endl;
-        std::cout << "=========================" << std::endl;
-        debugPrint("Spot (S)", S);
-        debugPrint("Strike (K)", K);
-        debugPrint("Time (T)", T);
-        debugPrint("Rate (r)", r);
-        debugPrint("Volatility (σ)", sigma);
-        debugPrint("Dividend (q)", q);
+        PRICER_TRACE(kTraceName, "Spot (S)", S);
+        PRICER_TRACE(kTraceName, "Strike (K)", K);
+        PRICER_TRACE(kTraceName, "Time (T)", T);
+        PRICER_TRACE(kTraceName, "Rate (r)", r);
+        PRICER_TRACE(kTraceName, "Volatility (σ)", sigma);
+        PRICER_TRACE(kTraceName, "Dividend (q)", q);
 
         // Calculate d1 and d2
         const double d1 = calculateD1(S, K, r, q, sigma, T);
         const double d2 = calculateD2(d1, sigma, T);
 
-        debugPrint("d1", d1);
-        debugPrint("d2", d2);
-        debugPrint("N(d1)", normalCDF(d1));
-        debugPrint("N(d2)", normalCDF(d2));
-        debugPrint("n(d1)", normalPDF(d1));
-        debugPrint("n(d2)", normalPDF(d2));
+        PRICER_TRACE(kTraceName, "d1", d1);
+        PRICER_TRACE(kTraceName, "d2", d2);
+        PRICER_TRACE(kTraceName, "N(d1)", normalCDF(d1));
+        PRICER_TRACE(kTraceName, "N(d2)", normalCDF(d2));
+        PRICER_TRACE(kTraceName, "n(d1)", normalPDF(d1));
+        PRICER_TRACE(kTraceName, "n(d2)", normalPDF(d2));
 
         double price;
         if (option.getType() == OptionType::Call) {
             const double term1 = S * std::exp(-q * T) * normalCDF(d1);
             const double term2 = K * std::exp(-r * T) * normalCDF(d2);
-            debugPrint("Call Option Term 1", term1);
-            debugPrint("Call Option Term 2", term2);
+            PRICER_TRACE(kTraceName, "Call Option Term 1", term1);
+            PRICER_TRACE(kTraceName, "Call Option Term 2", term2);
             price = term1 - term2;
         } else {  // Put option
             const double term1 = K * std::exp(-r * T) * normalCDF(-d2);
             const double term2 = S * std::exp(-q * T) * normalCDF(-d1);
-            debugPrint("Put Option Term 1", term1);
-            debugPrint("Put Option Term 2", term2);
+            PRICER_TRACE(kTraceName, "Put Option Term 1", term1);
+            PRICER_TRACE(kTraceName, "Put Option Term 2", term2);
             price = term1 - term2;
         }
 
-        debugPrint("Final Price", price);
-        std::cout << "=========================\n" << std::endl;
+        PRICER_TRACE(kTraceName, "Final Price", price);
         return price;
     }
 
-    double BlackScholesPricingEngine::calculateDelta(const Option& option) const {
+    double BlackScholesPricingEngine::calculateDelta(const OptionParameters& option) const {
         const double S = option.getSpot();
         const double K = option.getStrike();
         const double T = option.getExpiry();
@@ -79,7 +183,7 @@ namespace pricer {
 
         return exp_term * (option.getType() == OptionType::Call ? normalCDF(d1) : normalCDF(d1) - 1.0);
     }
-double BlackScholesPricingEngine::calculateGamma(const Option& option) const {
+double BlackScholesPricingEngine::calculateGamma(const OptionParameters& option) const {
     const double S = option.getSpot();
     const double K = option.getStrike();
     const double T = option.getExpiry();
@@ -93,7 +197,7 @@ double BlackScholesPricingEngine::calculateGamma(const Option& option) const {
     return exp(-q * T) * normalPDF(d1) / (S * sigma * sqrt(T));
 }
 
-double BlackScholesPricingEngine::calculateTheta(const Option& option) const {
+double BlackScholesPricingEngine::calculateTheta(const OptionParameters& option) const {
     const double S = option.getSpot();
     const double K = option.getStrike();
     const double T = option.getExpiry();
@@ -118,7 +222,7 @@ double BlackScholesPricingEngine::calculateTheta(const Option& option) const {
     }
 }
 
-    double BlackScholesPricingEngine::calculateVega(const Option& option) const {
+    double BlackScholesPricingEngine::calculateVega(const OptionParameters& option) const {
         const double S = option.getSpot();
         const double K = option.getStrike();
         const double T = option.getExpiry();
@@ -138,7 +242,7 @@ double BlackScholesPricingEngine::calculateTheta(const Option& option) const {
     }
 
 
-    double BlackScholesPricingEngine::calculateRho(const Option& option) const {
+    double BlackScholesPricingEngine::calculateRho(const OptionParameters& option) const {
         const double S = option.getSpot();
         const double K = option.getStrike();
         const double T = option.getExpiry();
@@ -169,6 +273,159 @@ double BlackScholesPricingEngine::calculateTheta(const Option& option) const {
     }
 
 
+    PricingResult BlackScholesPricingEngine::calculateAll(const OptionParameters& option) const {
+        PRICER_METRICS_TIMER(MetricsEngine::BlackScholes);
+        const double S = option.getSpot();
+        const double K = option.getStrike();
+        const double T = option.getExpiry();
+        const double r = option.getRate();
+        const double sigma = option.getVolatility();
+        const double q = option.getDividend();
+
+        // Everything below shares one d1/d2, one density and one pair of discount factors
+        const double d1 = calculateD1(S, K, r, q, sigma, T);
+        const double d2 = calculateD2(d1, sigma, T);
+        const double sqrt_t = std::sqrt(T);
+        const double df_q = std::exp(-q * T);
+        const double spot_pv = S * df_q;
+        const double strike_pv = K * std::exp(-r * T);
+        const double pdf_d1 = normalPDF(d1);
+        const double common_term = -(spot_pv * pdf_d1 * sigma) / (2 * sqrt_t);
+
+        PRICER_TRACE(kTraceName, "d1", d1);
+        PRICER_TRACE(kTraceName, "d2", d2);
+
+        PricingResult result;
+        result.gamma = df_q * pdf_d1 / (S * sigma * sqrt_t);
+        result.vega = spot_pv * pdf_d1 * sqrt_t / 100.0;
+
+        if (option.getType() == OptionType::Call) {
+            const double nd1 = normalCDF(d1);
+            const double nd2 = normalCDF(d2);
+            result.price = spot_pv * nd1 - strike_pv * nd2;
+            result.delta = df_q * nd1;
+            result.theta = (common_term - r * strike_pv * nd2 + q * spot_pv * nd1) / 365.0;
+            result.rho = strike_pv * T * nd2 / 100.0;
+        } else {
+            const double nmd1 = normalCDF(-d1);
+            const double nmd2 = normalCDF(-d2);
+            result.price = strike_pv * nmd2 - spot_pv * nmd1;
+            result.delta = -df_q * nmd1;
+            result.theta = (common_term + r * strike_pv * nmd2 - q * spot_pv * nmd1) / 365.0;
+            result.rho = -strike_pv * T * nmd2 / 100.0;
+        }
+
+        PRICER_TRACE(kTraceName, "Final Price", result.price);
+        return result;
+    }
+
+    void BlackScholesPricingEngine::priceBatch(const std::span<const double> spot,
+                                               const std::span<const double> strike,
+                                               const std::span<const double> expiry,
+                                               const std::span<const double> rate,
+                                               const std::span<const double> volatility,
+                                               const std::span<const double> dividend,
+                                               const std::span<const OptionType> type,
+                                               const std::span<double> out) const {
+        PRICER_METRICS_TIMER(MetricsEngine::BlackScholes, out.size());
+        const std::size_t n = out.size();
+        if (spot.size() != n || strike.size() != n || expiry.size() != n || rate.size() != n
+            || volatility.size() != n || dividend.size() != n || type.size() != n) {
+            throw std::invalid_argument("Batch inputs must all have the same length");
+        }
+
+        // Same preconditions as the scalar path, checked up front so the kernel stays branch-free
+        for (std::size_t i = 0; i < n; ++i) {
+            if (expiry[i] <= 0.0) {
+                throw std::invalid_argument("Time to expiry must be positive");
+            }
+            if (volatility[i] <= 0.0) {
+                throw std::invalid_argument("Volatility must be positive");
+            }
+            if (spot[i] <= 0.0 || strike[i] <= 0.0) {
+                throw std::invalid_argument("Spot and strike prices must be positive");
+            }
+        }
+
+        if (n <= kBatchChunk) {
+            priceChain(spot.data(), strike.data(), expiry.data(), rate.data(),
+                       volatility.data(), dividend.data(), type.data(), out.data(), n, accuracy_);
+            return;
+        }
+
+        ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+        pool.parallelFor((n + kBatchChunk - 1) / kBatchChunk, [&](const std::size_t chunk) {
+            const std::size_t begin = chunk * kBatchChunk;
+            const std::size_t count = std::min(kBatchChunk, n - begin);
+            priceChain(spot.data() + begin, strike.data() + begin, expiry.data() + begin,
+                       rate.data() + begin, volatility.data() + begin, dividend.data() + begin,
+                       type.data() + begin, out.data() + begin, count, accuracy_);
+        });
+    }
+
+    void BlackScholesPricingEngine::priceBatch(const ContractBatch& batch, const std::span<double> out) const {
+        PRICER_METRICS_TIMER(MetricsEngine::BlackScholes, out.size());
+        const std::size_t n = out.size();
+        if (batch.size() != n) {
+            throw std::invalid_argument("Batch inputs must all have the same length");
+        }
+
+        // ContractBatch::add validated every contract
+        auto price = [&](const std::size_t begin, const std::size_t count) {
+            TermBlock terms;
+            for (std::size_t first = begin; first < begin + count; first += kGreekBlock) {
+                const std::size_t block = std::min(kGreekBlock, begin + count - first);
+                terms.gather(batch.termIndices().data() + first, batch.expiryTerms().data(), block);
+                priceChainTerms(batch.spots().data() + first, batch.strikes().data() + first,
+                                batch.volatilities().data() + first, batch.types().data() + first,
+                                terms, out.data() + first, block, accuracy_);
+            }
+        };
+
+        if (n <= kBatchChunk) {
+            price(0, n);
+            return;
+        }
+
+        ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+        pool.parallelFor((n + kBatchChunk - 1) / kBatchChunk, [&](const std::size_t chunk) {
+            const std::size_t begin = chunk * kBatchChunk;
+            price(begin, std::min(kBatchChunk, n - begin));
+        });
+    }
+
+    void BlackScholesPricingEngine::calculateAllBatch(const ContractBatch& batch,
+                                                      const std::size_t begin,
+                                                      const std::span<PricingResult> out) const {
+        PRICER_METRICS_TIMER(MetricsEngine::BlackScholes, out.size());
+        if (begin + out.size() > batch.size()) {
+            throw std::out_of_range("Batch range exceeds the batch size");
+        }
+
+        double fields[6][kGreekBlock];
+        TermBlock terms;
+
+        for (std::size_t offset = 0; offset < out.size(); offset += kGreekBlock) {
+            const std::size_t first = begin + offset;
+            const std::size_t count = std::min(kGreekBlock, out.size() - offset);
+            terms.gather(batch.termIndices().data() + first, batch.expiryTerms().data(), count);
+            greekChain(batch.spots().data() + first, batch.strikes().data() + first,
+                       batch.expiries().data() + first, batch.rates().data() + first,
+                       batch.volatilities().data() + first, batch.dividends().data() + first,
+                       batch.types().data() + first, terms, fields, count, accuracy_);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                PricingResult& result = out[offset + i];
+                result.price = fields[0][i];
+                result.delta = fields[1][i];
+                result.gamma = fields[2][i];
+                result.theta = fields[3][i];
+                result.vega = fields[4][i];
+                result.rho = fields[5][i];
+            }
+        }
+    }
+
     double BlackScholesPricingEngine::calculateD1(const double S, const double K, const double r,
                                                   const double q, const double sigma, const double T) {
         if (T <= 0.0) {
@@ -186,13 +443,12 @@ double BlackScholesPricingEngine::calculateD2(const double d1, const double sigm
     return d1 - sigma * sqrt(T);
 }
 
-    double BlackScholesPricingEngine::normalCDF(const double x) {
-        return std::erfc(-x/std::sqrt(2.0))/2.0;
+    double BlackScholesPricingEngine::normalCDF(const double x) const {
+        return simd::normalCDF(x, accuracy_);
     }
 
     double BlackScholesPricingEngine::normalPDF(const double x) {
-        static constexpr double sqrt2pi = 2.506628274631; // Pre-computed sqrt(2.0 * M_PI)
-        return std::exp(-x * x / 2.0) / sqrt2pi;
+        return simd::normalPDF(x);
     }
 
 } // namespace pricer
\ No newline at end of file
@@ -0,0 +1,164 @@
+//
+// Command-line pricing of whole contract files.
+//
+#include "pricer/american_approximation.h"
+#include "pricer/batch_io.h"
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/finite_difference.h"
+#include "pricer/monte_carlo.h"
+#include "pricer/thread_pool.h"
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void printUsage(std::ostream& out) {
+    out << "Usage: options_pricer_batch [options] <contracts> <results>\n"
+           "\n"
+           "Prices every contract of a CSV or binary contract file and writes the\n"
+           "price and Greeks of each, in input order.\n"
+           "\n"
+           "Options:\n"
+           "  --engine NAME    black-scholes (default), binomial, monte-carlo,\n"
+           "                   finite-difference or american-approximation\n"
+           "  --steps N        Tree steps, or time steps of Monte Carlo and finite difference\n"
+           "  --paths N        Monte Carlo paths\n"
+           "  --format FORMAT  csv or binary results (default: the format of the contracts)\n"
+           "  --chunk N        Contracts per pipeline chunk (default 65536)\n"
+           "  --threads N      Worker threads (default: one per core)\n"
+           "  --help           Show this message\n";
+}
+
+struct Settings {
+    std::string engine = "black-scholes";
+    std::size_t steps = 0;  // 0 for the engine's default
+    std::size_t paths = 100000;
+    std::string format;     // Empty for the format of the contracts
+    std::size_t chunk = 65536;
+    std::size_t threads = 0;
+    std::string input;
+    std::string output;
+};
+
+std::size_t parseCount(const std::string& option, const char* value) {
+    char* end = nullptr;
+    const unsigned long long count = std::strtoull(value, &end, 10);
+    if (end == value || *end != '\0' || count == 0) {
+        throw std::invalid_argument(option + " needs a positive integer");
+    }
+    return static_cast<std::size_t>(count);
+}
+
+std::shared_ptr<pricer::PricingEngine> createEngine(const Settings& settings) {
+    auto steps = [&](const std::size_t fallback) { return settings.steps > 0 ? settings.steps : fallback; };
+
+    if (settings.engine == "black-scholes") {
+        return pricer::makeBlackScholesPricingEngine();
+    }
+    if (settings.engine == "binomial") {
+        return pricer::makeBinomialTreeEngine(steps(1000));
+    }
+    if (settings.engine == "monte-carlo") {
+        return pricer::makeMonteCarloEngine(settings.paths, steps(252));
+    }
+    if (settings.engine == "finite-difference") {
+        return pricer::makeFiniteDifferenceEngine(200, steps(100));
+    }
+    if (settings.engine == "american-approximation") {
+        return pricer::makeAmericanApproximationEngine();
+    }
+    throw std::invalid_argument("Unknown engine '" + settings.engine + "'");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Settings settings;
+    try {
+        std::size_t positional = 0;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> const char* {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h") {
+                printUsage(std::cout);
+                return 0;
+            } else if (arg == "--engine") {
+                settings.engine = value();
+            } else if (arg == "--steps") {
+                settings.steps = parseCount(arg, value());
+            } else if (arg == "--paths") {
+                settings.paths = parseCount(arg, value());
+            } else if (arg == "--format") {
+                settings.format = value();
+                if (settings.format != "csv" && settings.format != "binary") {
+                    throw std::invalid_argument("--format must be csv or binary");
+                }
+            } else if (arg == "--chunk") {
+                settings.chunk = parseCount(arg, value());
+            } else if (arg == "--threads") {
+                settings.threads = parseCount(arg, value());
+            } else if (arg.rfind("--", 0) == 0) {
+                throw std::invalid_argument("Unknown option " + arg);
+            } else if (positional == 0) {
+                settings.input = arg;
+                ++positional;
+            } else if (positional == 1) {
+                settings.output = arg;
+                ++positional;
+            } else {
+                throw std::invalid_argument("Unexpected argument " + arg);
+            }
+        }
+        if (settings.input.empty() || settings.output.empty()) {
+            throw std::invalid_argument("Expected a contract file and a result file");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "options_pricer_batch: " << e.what() << "\n\n";
+        printUsage(std::cerr);
+        return 2;
+    }
+
+    try {
+        pricer::ThreadPool::setGlobalConfiguration(settings.threads);
+        const auto engine = createEngine(settings);
+
+        const pricer::MappedFile input(settings.input);
+        pricer::BatchFormat format = pricer::detectContractFormat(input.contents());
+        if (!settings.format.empty()) {
+            format = settings.format == "csv" ? pricer::BatchFormat::Csv : pricer::BatchFormat::Binary;
+        }
+
+        std::ofstream output(settings.output, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw std::runtime_error("Cannot open " + settings.output + " for writing");
+        }
+
+        pricer::BatchFilePricer file_pricer;
+        file_pricer.setChunkRows(settings.chunk);
+        const pricer::BatchRunStats stats = file_pricer.price(*engine, input.contents(), output, format);
+        output.close();
+        if (!output) {
+            throw std::runtime_error("Failed to write " + settings.output);
+        }
+
+        std::fprintf(stderr, "Priced %zu contracts in %zu chunks in %.3f s (%.0f contracts/s)\n",
+                     stats.contracts, stats.chunks, stats.seconds, stats.contractsPerSecond());
+    } catch (const std::exception& e) {
+        std::cerr << "options_pricer_batch: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "pricer/contract.h"
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace pricer {
+
+void validate(const ContractSpec& contract, const MarketState& market) {
+    if (contract.strike <= 0.0) {
+        throw std::invalid_argument("Strike price must be positive");
+    }
+    if (contract.expiry <= 0.0) {
+        throw std::invalid_argument("Time to expiry must be positive");
+    }
+    if (market.spot <= 0.0) {
+        throw std::invalid_argument("Spot price must be positive");
+    }
+    if (market.volatility <= 0.0) {
+        throw std::invalid_argument("Volatility must be positive");
+    }
+    if (market.dividend < 0.0) {
+        throw std::invalid_argument("Dividend yield cannot be negative");
+    }
+}
+
+void ContractBatch::add(const ContractSpec& contract, const MarketState& market) {
+    validate(contract, market);
+
+    strike_.push_back(contract.strike);
+    expiry_.push_back(contract.expiry);
+    type_.push_back(contract.type);
+    exercise_.push_back(contract.exercise);
+    spot_.push_back(market.spot);
+    rate_.push_back(market.rate);
+    volatility_.push_back(market.volatility);
+    dividend_.push_back(market.dividend);
+
+    const TermKey key{market.spot, market.rate, market.dividend, contract.expiry};
+    const auto [entry, inserted] = term_lookup_.try_emplace(key, static_cast<std::uint32_t>(terms_.size()));
+    if (inserted) {
+        const double T = contract.expiry;
+        terms_.push_back({std::sqrt(T),
+                          std::exp(-market.rate * T),
+                          std::exp(-market.dividend * T),
+                          std::log(market.spot) + (market.rate - market.dividend) * T});
+    }
+    term_index_.push_back(entry->second);
+}
+
+void ContractBatch::reserve(const std::size_t count) {
+    strike_.reserve(count);
+    expiry_.reserve(count);
+    type_.reserve(count);
+    exercise_.reserve(count);
+    spot_.reserve(count);
+    rate_.reserve(count);
+    volatility_.reserve(count);
+    dividend_.reserve(count);
+    term_index_.reserve(count);
+}
+
+void ContractBatch::clear() {
+    strike_.clear();
+    expiry_.clear();
+    type_.clear();
+    exercise_.clear();
+    spot_.clear();
+    rate_.clear();
+    volatility_.clear();
+    dividend_.clear();
+    term_index_.clear();
+    terms_.clear();
+    term_lookup_.clear();
+}
+
+std::size_t ContractBatch::TermKeyHash::operator()(const TermKey& key) const {
+    std::size_t seed = 0;
+    for (const double value : {key.spot, key.rate, key.dividend, key.expiry}) {
+        seed ^= std::hash<double>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+} // namespace pricer
@@ -0,0 +1,359 @@
+#include "pricer/finite_difference.h"
+#include "pricer/async.h"
+#include "pricer/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace pricer {
+
+namespace {
+    // Buffers of one solve, each of length nodes, carved out of one allocation
+    enum GridArray {
+        kSpot,      // Spot of each node
+        kLower,     // Operator L = 1/2 s^2 S^2 d2/dS2 + (r - q) S d/dS - r as a tridiagonal
+        kCentre,
+        kUpper,
+        kFactorLower,   // Thomas factorization of I - h L: elimination multipliers,
+        kFactorPivot,   // reciprocal pivots
+        kFactorUpper,   // and the normalized superdiagonal
+        kValue,
+        kRhs,
+        kPayoff,
+        kGridArrays
+    };
+
+    // Forward elimination of rows 0..n-1 against the factorization, then
+    // back substitution from row n - 1 down to 0. With a floor this is the
+    // Brennan-Schwartz sweep: exact for payoffs whose exercise region is
+    // reached first by the back substitution. Both recurrences carry their
+    // last value in a register, so each node costs one multiply-add of latency.
+    void sweep(double* const* grid, const std::size_t n, const bool floor) {
+        const double* factor_lower = grid[kFactorLower];
+        const double* pivot = grid[kFactorPivot];
+        const double* factor_upper = grid[kFactorUpper];
+        const double* payoff = grid[kPayoff];
+        double* rhs = grid[kRhs];
+        double* value = grid[kValue];
+
+        double y = rhs[0] * pivot[0];
+        rhs[0] = y;
+        for (std::size_t i = 1; i < n; ++i) {
+            y = rhs[i] * pivot[i] + factor_lower[i] * y;
+            rhs[i] = y;
+        }
+        double x = floor ? std::max(y, payoff[n - 1]) : y;
+        value[n - 1] = x;
+        for (std::size_t i = n - 1; i-- > 0;) {
+            x = rhs[i] - factor_upper[i] * x;
+            x = floor ? std::max(x, payoff[i]) : x;
+            value[i] = x;
+        }
+    }
+
+    // Projected SOR on (I - h L) x = rhs, x >= payoff, warm-started from value
+    void psor(double* const* grid, const std::size_t n, const double h, const double omega,
+              const double tolerance, const std::size_t max_iterations) {
+        const double* lower = grid[kLower];
+        const double* centre = grid[kCentre];
+        const double* upper = grid[kUpper];
+        const double* payoff = grid[kPayoff];
+        const double* rhs = grid[kRhs];
+        double* value = grid[kValue];
+
+        value[0] = rhs[0];
+        value[n - 1] = rhs[n - 1];
+        for (std::size_t iteration = 0; iteration < max_iterations; ++iteration) {
+            double change = 0.0;
+            for (std::size_t i = 1; i + 1 < n; ++i) {
+                const double gauss_seidel = (rhs[i] + h * (lower[i] * value[i - 1] + upper[i] * value[i + 1]))
+                                            / (1.0 - h * centre[i]);
+                const double x = std::max(value[i] + omega * (gauss_seidel - value[i]), payoff[i]);
+                change = std::max(change, std::abs(x - value[i]) / std::max(1.0, std::abs(x)));
+                value[i] = x;
+            }
+            if (change < tolerance) {
+                return;
+            }
+        }
+        throw std::runtime_error("PSOR did not converge");
+    }
+}
+
+FiniteDifferenceEngine::FiniteDifferenceEngine(size_t space_steps, size_t time_steps)
+    : space_steps_(space_steps)
+    , time_steps_(time_steps) {
+    setSpaceSteps(space_steps);
+    setTimeSteps(time_steps);
+}
+
+void FiniteDifferenceEngine::setSpaceSteps(const size_t steps) {
+    if (steps < 4) {
+        throw std::invalid_argument("Finite-difference grid needs at least 4 space steps");
+    }
+    space_steps_ = steps;
+}
+
+void FiniteDifferenceEngine::setTimeSteps(const size_t steps) {
+    if (steps == 0) {
+        throw std::invalid_argument("Number of time steps must be positive");
+    }
+    time_steps_ = steps;
+}
+
+PricingResult FiniteDifferenceEngine::solve(const OptionParameters& option) const {
+    return solve(option, option);
+}
+
+PricingResult FiniteDifferenceEngine::solve(const OptionParameters& option, const OptionParameters& layout) const {
+    const double K = option.getStrike();
+    const double T = option.getExpiry();
+    const double r = option.getRate();
+    const double q = option.getDividend();
+    const double sigma = option.getVolatility();
+    const double w = option.getType() == OptionType::Call ? 1.0 : -1.0;
+    const bool american = option.isAmerican();
+
+    // Grid: S = K + c sinh(xi) on a uniform xi axis, wide enough to hold
+    // kStdDevs standard deviations either side of spot and strike
+    const double S = layout.getSpot();
+    const double drift = (layout.getRate() - layout.getDividend()) * layout.getExpiry();
+    const double extent = kStdDevs * layout.getVolatility() * std::sqrt(layout.getExpiry());
+    const double low = std::min(S, K) * std::exp(std::min(drift, 0.0) - extent);
+    const double high = std::max(S, K) * std::exp(std::max(drift, 0.0) + extent);
+    // The cells around the strike scale with the width of the distribution
+    // rather than with the span, which grows exponentially in sigma sqrt(T)
+    const double c = kConcentration * K * layout.getVolatility() * std::sqrt(layout.getExpiry());
+
+    // Uniform xi over the whole span; the node nearest today's spot is moved onto it
+    const size_t n = space_steps_ + 1;
+    const double xi_low = std::asinh((low - K) / c);
+    const double xi_spot = std::asinh((S - K) / c);
+    const double xi_high = std::asinh((high - K) / c);
+    const double dxi = (xi_high - xi_low) / static_cast<double>(space_steps_);
+    const auto k = static_cast<size_t>(std::clamp(std::round((xi_spot - xi_low) / dxi),
+                                                  1.0, static_cast<double>(space_steps_ - 1)));
+
+    PRICER_METRICS_ADD(MetricsEngine::FiniteDifference, MetricsCounter::Nodes, n * time_steps_);
+
+    std::vector<double> storage(kGridArrays * n);
+    double* grid[kGridArrays];
+    for (size_t a = 0; a < kGridArrays; ++a) {
+        grid[a] = storage.data() + a * n;
+    }
+
+    // Calls run up the spot axis and puts down it, so the back substitution
+    // of each sweep always starts in the exercise region
+    double* spot = grid[kSpot];
+    for (size_t i = 0; i < n; ++i) {
+        const size_t node = w > 0.0 ? i : space_steps_ - i;
+        spot[i] = K + c * std::sinh(xi_low + dxi * static_cast<double>(node));
+    }
+    const size_t spot_node = w > 0.0 ? k : space_steps_ - k;
+    spot[spot_node] = S;
+
+    double* lower = grid[kLower];
+    double* centre = grid[kCentre];
+    double* upper = grid[kUpper];
+    for (size_t i = 1; i + 1 < n; ++i) {
+        // Three-point weights for the signed offsets to the neighbours
+        const double dm = spot[i - 1] - spot[i];
+        const double dp = spot[i + 1] - spot[i];
+        const double diffusion = 0.5 * sigma * sigma * spot[i] * spot[i];
+        const double convection = (r - q) * spot[i];
+
+        lower[i] = 2.0 * diffusion / (dm * (dm - dp)) - convection * dp / (dm * (dm - dp));
+        upper[i] = 2.0 * diffusion / (dp * (dp - dm)) - convection * dm / (dp * (dp - dm));
+
+        // Fall back to upwinding where central convection would make the scheme non-monotone
+        if (lower[i] < 0.0 || upper[i] < 0.0) {
+            lower[i] = 2.0 * diffusion / (dm * (dm - dp));
+            upper[i] = 2.0 * diffusion / (dp * (dp - dm));
+            if (convection * dp > 0.0) {
+                upper[i] += convection / dp;
+            } else {
+                lower[i] += convection / dm;
+            }
+        }
+        centre[i] = -lower[i] - upper[i] - r;
+    }
+
+    // Each step solves with I - h L: h is half the step for Crank-Nicolson
+    // and the whole half-step for the Rannacher implicit Euler half-steps,
+    // so both share the factorization of the step they belong to
+    double* factor_lower = grid[kFactorLower];
+    double* pivot = grid[kFactorPivot];
+    double* factor_upper = grid[kFactorUpper];
+    factor_lower[0] = 0.0;
+    pivot[0] = 1.0;
+    factor_upper[0] = 0.0;
+    double h = 0.0;
+    auto factor = [&](const double step_h) {
+        h = step_h;
+        for (size_t i = 1; i < n; ++i) {
+            const double diagonal = 1.0 - h * centre[i] + h * lower[i] * factor_upper[i - 1];
+            pivot[i] = 1.0 / diagonal;
+            factor_lower[i] = h * lower[i] * pivot[i];
+            factor_upper[i] = -h * upper[i] * pivot[i];
+        }
+    };
+
+    double* value = grid[kValue];
+    double* rhs = grid[kRhs];
+    double* payoff = grid[kPayoff];
+    for (size_t i = 0; i < n; ++i) {
+        payoff[i] = std::max(w * (spot[i] - K), 0.0);
+        value[i] = payoff[i];
+    }
+
+    // Average the payoff over the cell of the node nearest the strike, so
+    // the kink does not sit at an arbitrary point between nodes; a and b
+    // are how far the ends of the cell are in the money
+    size_t kink = 1;
+    for (size_t i = 2; i + 1 < n; ++i) {
+        kink = std::abs(spot[i] - K) < std::abs(spot[kink] - K) ? i : kink;
+    }
+    const double a = w * (0.5 * (spot[kink - 1] + spot[kink]) - K);
+    const double b = w * (0.5 * (spot[kink] + spot[kink + 1]) - K);
+    value[kink] = b <= 0.0 ? 0.0 : a >= 0.0 ? 0.5 * (a + b) : 0.5 * b * b / (b - a);
+
+    // Dirichlet values at the two ends: the discounted forward intrinsic,
+    // floored by the payoff for American options
+    auto boundary = [&](const size_t i, const double tau) {
+        const double european = std::max(w * (spot[i] * std::exp(-q * tau) - K * std::exp(-r * tau)), 0.0);
+        return american ? std::max(european, payoff[i]) : european;
+    };
+
+    auto step = [&](const double tau, const double length, const bool crank_nicolson) {
+        if (crank_nicolson) {
+            for (size_t i = 1; i + 1 < n; ++i) {
+                rhs[i] = value[i] + h * (lower[i] * value[i - 1] + centre[i] * value[i] + upper[i] * value[i + 1]);
+            }
+        } else {
+            std::copy(value + 1, value + n - 1, rhs + 1);
+        }
+        rhs[0] = boundary(0, tau + length);
+        rhs[n - 1] = boundary(n - 1, tau + length);
+
+        if (american && early_exercise_ == EarlyExercise::PSOR) {
+            psor(grid, n, h, kPsorRelaxation, kPsorTolerance, kPsorMaxIterations);
+        } else {
+            sweep(grid, n, american);
+        }
+    };
+
+    // American exercise boundaries move like sqrt(tau) near expiry, so
+    // their time steps are graded towards it as tau_m = T (m / M)^p and
+    // refactored each step; European steps are uniform and factored once
+    const double grading = american ? kAmericanGrading : 1.0;
+    auto level = [&](const size_t m) {
+        return T * std::pow(static_cast<double>(m) / static_cast<double>(time_steps_), grading);
+    };
+
+    // Spot-node values one and two steps before expiry, for theta
+    double previous[2] = {value[spot_node], value[spot_node]};
+    for (size_t m = 0; m < time_steps_; ++m) {
+        async::checkpoint();
+        const double tau = level(m);
+        const double dt = level(m + 1) - tau;
+        previous[1] = previous[0];
+        previous[0] = value[spot_node];
+        if (american || m == 0) {
+            factor(0.5 * dt);
+        }
+        if (m < rannacher_steps_) {
+            step(tau, 0.5 * dt, false);
+            step(tau + 0.5 * dt, 0.5 * dt, false);
+        } else {
+            step(tau, dt, true);
+        }
+    }
+
+    PricingResult result;
+    const double dm = spot[spot_node - 1] - S;
+    const double dp = spot[spot_node + 1] - S;
+    const double vm = value[spot_node - 1];
+    const double v0 = value[spot_node];
+    const double vp = value[spot_node + 1];
+    result.price = v0;
+    result.delta = -dp / (dm * (dm - dp)) * vm - (dm + dp) / (dm * dp) * v0 - dm / (dp * (dp - dm)) * vp;
+    result.gamma = 2.0 * (vm / (dm * (dm - dp)) + v0 / (dm * dp) + vp / (dp * (dp - dm)));
+
+    // dV/dt = -dV/dtau today (tau = T): the three-level backward difference on
+    // the possibly graded steps, or a one-sided one for a single step
+    const double h1 = T - level(time_steps_ - 1);
+    const double h2 = time_steps_ >= 2 ? level(time_steps_ - 1) - level(time_steps_ - 2) : 0.0;
+    const double dv_dtau = time_steps_ >= 2
+        ? (2.0 * h1 + h2) / (h1 * (h1 + h2)) * v0 - (h1 + h2) / (h1 * h2) * previous[0]
+          + h1 / (h2 * (h1 + h2)) * previous[1]
+        : (v0 - previous[0]) / h1;
+    result.theta = -dv_dtau / 365.0;
+
+    return result;
+}
+
+double FiniteDifferenceEngine::calculate(const OptionParameters& option) const {
+    PRICER_METRICS_TIMER(MetricsEngine::FiniteDifference);
+    return solve(option).price;
+}
+
+double FiniteDifferenceEngine::calculateDelta(const OptionParameters& option) const {
+    return solve(option).delta;
+}
+
+double FiniteDifferenceEngine::calculateGamma(const OptionParameters& option) const {
+    return solve(option).gamma;
+}
+
+double FiniteDifferenceEngine::calculateTheta(const OptionParameters& option) const {
+    return solve(option).theta;
+}
+
+double FiniteDifferenceEngine::calculateVega(const OptionParameters& option) const {
+    const double vol = option.getVolatility();
+
+    // Both bumps keep the unbumped grid, so the difference sees no regridding noise
+    const double up_price = solve(option.withVolatility(vol + kBump), option).price;
+    const double down_price = solve(option.withVolatility(vol - kBump), option).price;
+
+    // Per 1% change in volatility
+    return (up_price - down_price) / (2.0 * kBump) / 100.0;
+}
+
+double FiniteDifferenceEngine::calculateRho(const OptionParameters& option) const {
+    const double rate = option.getRate();
+
+    const double up_price = solve(option.withRate(rate + kBump), option).price;
+    const double down_price = solve(option.withRate(rate - kBump), option).price;
+
+    // Per 1% change in rate
+    return (up_price - down_price) / (2.0 * kBump) / 100.0;
+}
+
+PricingResult FiniteDifferenceEngine::calculateAll(const OptionParameters& option) const {
+    PRICER_METRICS_TIMER(MetricsEngine::FiniteDifference);
+    const double vol = option.getVolatility();
+    const double rate = option.getRate();
+    const OptionParameters scenarios[] = {
+        option,
+        option.withVolatility(vol + kBump), option.withVolatility(vol - kBump),
+        option.withRate(rate + kBump), option.withRate(rate - kBump)
+    };
+    PricingResult results[std::size(scenarios)];
+
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    const JobControl* job = async::currentJob();
+    pool.parallelFor(std::size(scenarios), [&](const size_t i) {
+        const async::ScopedJob scope(job);
+        results[i] = solve(scenarios[i], option);
+    });
+
+    PricingResult result = results[0];
+    result.vega = (results[1].price - results[2].price) / (2.0 * kBump) / 100.0;
+    result.rho = (results[3].price - results[4].price) / (2.0 * kBump) / 100.0;
+    return result;
+}
+
+} // namespace pricer
@@ -2,6 +2,8 @@
 #include "pricer/black_scholes.h"
 #include "pricer/monte_carlo.h"
 #include "pricer/binomial.h"
+#include "pricer/finite_difference.h"
+#include "pricer/american_approximation.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -17,6 +19,7 @@
 #include <QLabel>
 #include <QGroupBox>
 #include <QCloseEvent>
+#include <QStatusBar>
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -36,7 +39,14 @@ MainWindow::MainWindow(QWidget* parent)
     , binomialGroup_(new QGroupBox("Binomial Tree Settings", this))
     , numTreeStepsSpin_(new QDoubleSpinBox(this))
     , treeMethodCombo_(new QComboBox(this))
+    , finiteDifferenceGroup_(new QGroupBox("Finite Difference Settings", this))
+    , numSpaceStepsSpin_(new QDoubleSpinBox(this))
+    , numTimeStepsSpin_(new QDoubleSpinBox(this))
+    , approximationGroup_(new QGroupBox("American Approximation Settings", this))
+    , approximationMethodCombo_(new QComboBox(this))
     , resultsTable_(new QTableWidget(this))
+    , progressBar_(new QProgressBar(this))
+    , cancelButton_(new QPushButton("Cancel", this))
 {
     setWindowTitle("Options Pricer");
 
@@ -87,12 +97,21 @@ MainWindow::MainWindow(QWidget* parent)
     leftLayout->addWidget(inputGroup);
     leftLayout->addWidget(monteCarloGroup_);
     leftLayout->addWidget(binomialGroup_);
+    leftLayout->addWidget(finiteDifferenceGroup_);
+    leftLayout->addWidget(approximationGroup_);
     leftLayout->addWidget(calculateButton);
     leftLayout->addStretch();
 
+    // Progress of the running calculation
+    auto* progressLayout = new QHBoxLayout();
+    progressLayout->addWidget(progressBar_, 1);
+    progressLayout->addWidget(cancelButton_);
+    connect(cancelButton_, &QPushButton::clicked, this, &MainWindow::cancelCalculation);
+
     // Add widgets to right panel
     rightLayout->addWidget(resultsLabel);
     rightLayout->addWidget(resultsTable_);
+    rightLayout->addLayout(progressLayout);
 
     // Add panels to main layout
     mainLayout->addWidget(leftPanel, 1);
@@ -103,6 +122,15 @@ MainWindow::MainWindow(QWidget* parent)
 
     // Set initial state
     updateEngineControls();
+    setCalculating(false);
+
+    // A result still being priced is stale once any input changes
+    for (auto* spin : findChildren<QDoubleSpinBox*>()) {
+        connect(spin, &QDoubleSpinBox::valueChanged, this, &MainWindow::inputsChanged);
+    }
+    for (auto* combo : findChildren<QComboBox*>()) {
+        connect(combo, &QComboBox::currentIndexChanged, this, &MainWindow::inputsChanged);
+    }
 
     // Restore window geometry
     QSettings settings;
@@ -114,7 +142,13 @@ MainWindow::MainWindow(QWidget* parent)
     }
 }
 
-MainWindow::~MainWindow() = default;
+MainWindow::~MainWindow() {
+    // The job posts back to this window, so it has to stop first
+    job_.token.cancel();
+    if (jobDone_.valid()) {
+        jobDone_.wait();
+    }
+}
 
 void MainWindow::createInputLayout() {
     // Option type combo
@@ -129,6 +163,8 @@ void MainWindow::createInputLayout() {
     pricingMethodCombo_->addItem("Black-Scholes");
     pricingMethodCombo_->addItem("Monte Carlo");
     pricingMethodCombo_->addItem("Binomial Tree");
+    pricingMethodCombo_->addItem("Finite Difference");
+    pricingMethodCombo_->addItem("American Approximation");
     connect(pricingMethodCombo_, &QComboBox::currentTextChanged,
             this, &MainWindow::updateEngineControls);
 
@@ -172,6 +208,8 @@ void MainWindow::createEngineSpecificControls() {
 
     varianceReductionCombo_->addItem("None");
     varianceReductionCombo_->addItem("Antithetic Variates");
+    varianceReductionCombo_->addItem("Control Variate");
+    varianceReductionCombo_->addItem("Antithetic + Control Variate");
 
     mcLayout->addRow("Number of Paths:", numPathsSpin_);
     mcLayout->addRow("Steps per Path:", numStepsSpin_);
@@ -189,6 +227,29 @@ void MainWindow::createEngineSpecificControls() {
 
     btLayout->addRow("Number of Steps:", numTreeStepsSpin_);
     btLayout->addRow("Method:", treeMethodCombo_);
+
+    // Finite difference controls
+    auto* fdLayout = new QFormLayout(finiteDifferenceGroup_);
+
+    numSpaceStepsSpin_->setRange(20, 5000);
+    numSpaceStepsSpin_->setValue(200);
+    numSpaceStepsSpin_->setDecimals(0);
+
+    numTimeStepsSpin_->setRange(10, 5000);
+    numTimeStepsSpin_->setValue(100);
+    numTimeStepsSpin_->setDecimals(0);
+
+    fdLayout->addRow("Spot Grid Steps:", numSpaceStepsSpin_);
+    fdLayout->addRow("Time Steps:", numTimeStepsSpin_);
+
+    // American approximation controls
+    auto* aaLayout = new QFormLayout(approximationGroup_);
+
+    approximationMethodCombo_->addItem("Bjerksund-Stensland");
+    approximationMethodCombo_->addItem("Barone-Adesi-Whaley");
+    approximationMethodCombo_->addItem("Andersen-Lake-Offengenden");
+
+    aaLayout->addRow("Method:", approximationMethodCombo_);
 }
 
 void MainWindow::createResultsLayout() {
@@ -226,16 +287,89 @@ void MainWindow::createMenuBar() {
 }
 
 void MainWindow::calculateOption() {
+    // The replaced job stops at its next checkpoint; waiting for it keeps it
+    // from competing with the new one for the pool
+    job_.token.cancel();
+    if (jobDone_.valid()) {
+        jobDone_.wait();
+    }
+
+    try {
+        const auto option = createOption();
+        const quint64 id = ++jobId_;
+        auto done = std::make_shared<std::promise<void>>();
+        jobDone_ = done->get_future().share();
+
+        // Both callbacks run on the pricing thread and only post back to this one
+        job_ = pricer::priceAsync(
+            createPricingEngine(), *option,
+            [this, id](const pricer::PricingProgress& progress) {
+                QMetaObject::invokeMethod(this, [this, id, progress] { showProgress(id, progress); },
+                                          Qt::QueuedConnection);
+            },
+            [this, id, done] {
+                QMetaObject::invokeMethod(this, [this, id] { finishCalculation(id); }, Qt::QueuedConnection);
+                done->set_value();
+            });
+        setCalculating(true);
+    }
+    catch (const std::exception& e) {
+        showErrorMessage(QString("Calculation error: ") + e.what());
+    }
+}
+
+void MainWindow::cancelCalculation() {
+    if (jobRunning_) {
+        job_.token.cancel();
+    }
+}
+
+void MainWindow::inputsChanged() {
+    if (jobRunning_) {
+        cancelCalculation();
+        statusBar()->showMessage("Calculation cancelled: inputs changed", 5000);
+    }
+}
+
+void MainWindow::showProgress(const quint64 id, const pricer::PricingProgress& progress) {
+    if (id != jobId_ || !jobRunning_) {
+        return;
+    }
+    progressBar_->setValue(static_cast<int>(progress.fraction * 100.0));
+    if (progress.has_estimate) {
+        displayResults(progress.estimate, true);
+    }
+}
+
+void MainWindow::finishCalculation(const quint64 id) {
+    if (id != jobId_) {
+        return;
+    }
+    setCalculating(false);
+
     try {
-        auto option = createOption();
-        option->setPricingEngine(createPricingEngine());
-        displayResults(*option);
+        displayResults(job_.result.get(), false);
+        progressBar_->setValue(100);
+    }
+    catch (const pricer::PricingCancelled&) {
+        statusBar()->showMessage("Calculation cancelled", 5000);
     }
     catch (const std::exception& e) {
         showErrorMessage(QString("Calculation error: ") + e.what());
     }
 }
 
+void MainWindow::setCalculating(const bool running) {
+    jobRunning_ = running;
+    cancelButton_->setEnabled(running);
+    if (running) {
+        progressBar_->setValue(0);
+        statusBar()->showMessage("Calculating...");
+    } else {
+        statusBar()->clearMessage();
+    }
+}
+
 std::unique_ptr<pricer::Option> MainWindow::createOption() const {
     auto type = optionTypeCombo_->currentData().value<pricer::OptionType>();
     bool isAmerican = optionStyleCombo_->currentText() == "American";
@@ -270,12 +404,33 @@ std::shared_ptr<pricer::PricingEngine> MainWindow::createPricingEngine() const {
         return pricer::makeBlackScholesPricingEngine();
     }
     else if (method == "Monte Carlo") {
-        return pricer::makeMonteCarloEngine(
+        const QString reduction = varianceReductionCombo_->currentText();
+        auto engine = std::make_shared<pricer::MonteCarloEngine>(
             static_cast<size_t>(numPathsSpin_->value()),
             static_cast<size_t>(numStepsSpin_->value()),
-            varianceReductionCombo_->currentText().contains("Antithetic")
+            reduction.contains("Antithetic")
+        );
+        if (reduction.contains("Control")) {
+            engine->setControlVariate(pricer::ControlVariate::TerminalSpot);
+        }
+        return engine;
+    }
+    else if (method == "Finite Difference") {
+        return pricer::makeFiniteDifferenceEngine(
+            static_cast<size_t>(numSpaceStepsSpin_->value()),
+            static_cast<size_t>(numTimeStepsSpin_->value())
         );
     }
+    else if (method == "American Approximation") {
+        const QString approximation = approximationMethodCombo_->currentText();
+        if (approximation == "Barone-Adesi-Whaley") {
+            return pricer::makeAmericanApproximationEngine(pricer::AmericanApproximation::BaroneAdesiWhaley);
+        }
+        if (approximation == "Andersen-Lake-Offengenden") {
+            return pricer::makeAmericanApproximationEngine(pricer::AmericanApproximation::AndersenLakeOffengenden);
+        }
+        return pricer::makeAmericanApproximationEngine(pricer::AmericanApproximation::BjerksundStensland);
+    }
     else {  // Binomial Tree
         return pricer::makeBinomialTreeEngine(
             static_cast<size_t>(numTreeStepsSpin_->value()),
@@ -284,7 +439,7 @@ std::shared_ptr<pricer::PricingEngine> MainWindow::createPricingEngine() const {
     }
 }
 
-void MainWindow::displayResults(const pricer::Option& option) {
+void MainWindow::displayResults(const pricer::PricingResult& result, const bool partial) {
     resultsTable_->setRowCount(0);
 
     // Add results to table
@@ -295,16 +450,20 @@ void MainWindow::displayResults(const pricer::Option& option) {
         resultsTable_->setItem(row, 1, new QTableWidgetItem(QString::number(value, 'f', 6)));
     };
 
-    addRow("Option Price", option.price());
-    addRow("Delta", option.delta());
-    addRow("Gamma", option.gamma());
-    addRow("Theta", option.theta());
-    addRow("Vega", option.vega());
-    addRow("Rho", option.rho());
+    addRow("Option Price", result.price);
+
+    // Partial results only carry the price so far
+    if (!partial) {
+        addRow("Delta", result.delta);
+        addRow("Gamma", result.gamma);
+        addRow("Theta", result.theta);
+        addRow("Vega", result.vega);
+        addRow("Rho", result.rho);
+    }
 
     // If Monte Carlo, add confidence interval
-    if (auto* mc_engine = dynamic_cast<const pricer::MonteCarloEngine*>(option.getEngine())) {
-        auto [fst, snd] = mc_engine->getConfidenceInterval(option);
+    if (result.std_error > 0.0) {
+        auto [fst, snd] = result.confidenceInterval();
         addRow("95% CI Lower", fst);
         addRow("95% CI Upper", snd);
     }
@@ -317,9 +476,11 @@ void MainWindow::updateEngineControls() {
 
     monteCarloGroup_->setVisible(method == "Monte Carlo");
     binomialGroup_->setVisible(method == "Binomial Tree");
+    finiteDifferenceGroup_->setVisible(method == "Finite Difference");
+    approximationGroup_->setVisible(method == "American Approximation");
 
-    // Enable/disable option style based on pricing method
-    optionStyleCombo_->setEnabled(method != "Black-Scholes");
+    // Enable/disable option style based on pricing method; the closed forms fix it
+    optionStyleCombo_->setEnabled(method != "Black-Scholes" && method != "American Approximation");
 }
 
 void MainWindow::resetFields() {
@@ -342,6 +503,11 @@ void MainWindow::resetFields() {
     numTreeStepsSpin_->setValue(1000);
     treeMethodCombo_->setCurrentIndex(0);
 
+    numSpaceStepsSpin_->setValue(200);
+    numTimeStepsSpin_->setValue(100);
+
+    approximationMethodCombo_->setCurrentIndex(0);
+
     resultsTable_->setRowCount(0);
 }
 
@@ -10,6 +10,10 @@
 #include <QDoubleSpinBox>
 #include <QTableWidget>
 #include <QGroupBox>
+#include <QProgressBar>
+#include <QPushButton>
+#include "pricer/async.h"
+#include <future>
 #include <memory>
 
 namespace pricer {
@@ -26,6 +30,8 @@ public:
 
 private slots:
     void calculateOption();
+    void cancelCalculation();
+    void inputsChanged();
     void updateEngineControls();
     void resetFields();
     void exportResults();
@@ -56,8 +62,26 @@ private:
     QDoubleSpinBox* numTreeStepsSpin_;
     QComboBox* treeMethodCombo_;
 
+    // Finite difference specific controls
+    QGroupBox* finiteDifferenceGroup_;
+    QDoubleSpinBox* numSpaceStepsSpin_;
+    QDoubleSpinBox* numTimeStepsSpin_;
+
+    // American approximation specific controls
+    QGroupBox* approximationGroup_;
+    QComboBox* approximationMethodCombo_;
+
     // Results display
     QTableWidget* resultsTable_;
+    QProgressBar* progressBar_;
+    QPushButton* cancelButton_;
+
+    // Background pricing. Reports of a job are tagged with its id, so those
+    // of a job that was replaced are dropped when they arrive.
+    pricer::PricingJob job_;
+    std::shared_future<void> jobDone_;  // Ready once the job stops calling back
+    quint64 jobId_ = 0;
+    bool jobRunning_ = false;
 
     // Create layout functions
     void createInputLayout();
@@ -68,7 +92,10 @@ private:
     // Helper functions
     [[nodiscard]] std::unique_ptr<pricer::Option> createOption() const;
     [[nodiscard]] std::shared_ptr<pricer::PricingEngine> createPricingEngine() const;
-    void displayResults(const pricer::Option& option);
+    void displayResults(const pricer::PricingResult& result, bool partial);
+    void showProgress(quint64 id, const pricer::PricingProgress& progress);
+    void finishCalculation(quint64 id);
+    void setCalculating(bool running);
     void showErrorMessage(const QString& message);
 
     // Constants for input validation
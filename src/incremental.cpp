@@ -0,0 +1,151 @@
+#include "pricer/incremental.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace pricer {
+
+IncrementalPricer::IncrementalPricer(std::shared_ptr<ThreadPool> pool)
+    : pricer_(std::move(pool)) {
+}
+
+std::size_t IncrementalPricer::addUnderlying(const MarketState& market) {
+    // Any contract will do to check the market inputs
+    validate(ContractSpec{1.0, 1.0}, market);
+    underlyings_.push_back({market, false, false, {}});
+    return underlyings_.size() - 1;
+}
+
+std::size_t IncrementalPricer::addPosition(const ContractSpec& contract,
+                                           const std::size_t underlying,
+                                           const double quantity,
+                                           std::shared_ptr<const PricingEngine> engine) {
+    if (underlying >= underlyings_.size()) {
+        throw std::out_of_range("Unknown underlying");
+    }
+    if (!engine) {
+        throw std::invalid_argument("Position needs a pricing engine");
+    }
+    validate(contract, underlyings_[underlying].market);
+
+    const std::size_t position = positions_.size();
+    positions_.push_back({contract, underlying, quantity, std::move(engine), 0.0, {}});
+    underlyings_[underlying].positions.push_back(position);
+    new_positions_.push_back(position);
+    result_.positions.emplace_back();
+    return position;
+}
+
+void IncrementalPricer::setSpot(const std::size_t underlying, const double spot) {
+    MarketState market = underlyings_.at(underlying).market;
+    market.spot = spot;
+    validate(ContractSpec{1.0, 1.0}, market);
+    underlyings_[underlying].market = market;
+    markDirty(underlying, true);
+}
+
+void IncrementalPricer::setVolatility(const std::size_t underlying, const double volatility) {
+    MarketState market = underlyings_.at(underlying).market;
+    market.volatility = volatility;
+    validate(ContractSpec{1.0, 1.0}, market);
+    underlyings_[underlying].market = market;
+    markDirty(underlying, false);
+}
+
+void IncrementalPricer::setRate(const std::size_t underlying, const double rate) {
+    underlyings_.at(underlying).market.rate = rate;
+    markDirty(underlying, false);
+}
+
+void IncrementalPricer::setDividend(const std::size_t underlying, const double dividend) {
+    MarketState market = underlyings_.at(underlying).market;
+    market.dividend = dividend;
+    validate(ContractSpec{1.0, 1.0}, market);
+    underlyings_[underlying].market = market;
+    markDirty(underlying, false);
+}
+
+void IncrementalPricer::markDirty(const std::size_t underlying, const bool spot_only) {
+    Underlying& u = underlyings_[underlying];
+    if (!u.spot_moved && !u.other_moved) {
+        dirty_underlyings_.push_back(underlying);
+    }
+    (spot_only ? u.spot_moved : u.other_moved) = true;
+}
+
+void IncrementalPricer::update(const std::size_t position, const PricingResult& value) {
+    PricingResult& current = result_.positions[position];
+    PricingResult& total = result_.total;
+    const double q = positions_[position].quantity;
+
+    total.price += q * (value.price - current.price);
+    total.delta += q * (value.delta - current.delta);
+    total.gamma += q * (value.gamma - current.gamma);
+    total.theta += q * (value.theta - current.theta);
+    total.vega += q * (value.vega - current.vega);
+    total.rho += q * (value.rho - current.rho);
+    current = value;
+}
+
+const PortfolioResult& IncrementalPricer::reprice() {
+    // Positions that need the engine, and Taylor updates of the rest of the
+    // dirty ones. Nothing is changed until pricing has succeeded, so a
+    // reprice that throws leaves every position queued for the next one.
+    std::vector<std::size_t> full = new_positions_;
+    std::vector<std::pair<std::size_t, PricingResult>> approximated;
+
+    for (const std::size_t u : dirty_underlyings_) {
+        const Underlying& underlying = underlyings_[u];
+        const double spot = underlying.market.spot;
+
+        for (const std::size_t p : underlying.positions) {
+            const Position& position = positions_[p];
+            if (position.anchor_spot == 0.0) {
+                continue;  // new, already queued
+            }
+
+            const double move = spot - position.anchor_spot;
+            if (!underlying.other_moved && std::abs(move) <= taylor_threshold_ * position.anchor_spot) {
+                PricingResult value = position.anchor;
+                value.price += position.anchor.delta * move + 0.5 * position.anchor.gamma * move * move;
+                value.delta += position.anchor.gamma * move;
+                approximated.emplace_back(p, value);
+            } else {
+                full.push_back(p);
+            }
+        }
+    }
+
+    PortfolioResult priced;
+    if (!full.empty()) {
+        Portfolio book;
+        book.reserve(full.size());
+        for (const std::size_t p : full) {
+            const Position& position = positions_[p];
+            book.add(position.contract, underlyings_[position.underlying].market, 1.0, position.engine);
+        }
+        priced = pricer_.price(book);
+    }
+
+    for (std::size_t i = 0; i < full.size(); ++i) {
+        Position& position = positions_[full[i]];
+        position.anchor_spot = underlyings_[position.underlying].market.spot;
+        position.anchor = priced.positions[i];
+        update(full[i], priced.positions[i]);
+    }
+    for (const auto& [p, value] : approximated) {
+        update(p, value);
+    }
+
+    for (const std::size_t u : dirty_underlyings_) {
+        underlyings_[u].spot_moved = false;
+        underlyings_[u].other_moved = false;
+    }
+    dirty_underlyings_.clear();
+    new_positions_.clear();
+    last_repriced_ = full.size();
+    last_approximated_ = approximated.size();
+    return result_;
+}
+
+} // namespace pricer
@@ -0,0 +1,142 @@
+#include "pricer/metrics.h"
+#include <algorithm>
+#include <bit>
+
+namespace pricer {
+
+namespace {
+    // One cache line group per engine, so engines recording at once do not share lines
+    struct alignas(64) EngineCounters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> contracts{0};
+        std::atomic<std::uint64_t> total_ns{0};
+        std::atomic<std::uint64_t> paths{0};
+        std::atomic<std::uint64_t> nodes{0};
+        std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBuckets> latency{};
+    };
+
+    std::array<EngineCounters, kMetricsEngines> counters;
+
+    EngineCounters& countersOf(const MetricsEngine engine) {
+        return counters[static_cast<std::size_t>(engine)];
+    }
+
+    std::size_t bucketOf(const std::uint64_t nanoseconds) {
+        const auto width = static_cast<std::size_t>(std::bit_width(nanoseconds));
+        return std::min(width == 0 ? 0 : width - 1, LatencyHistogram::kBuckets - 1);
+    }
+
+    double perSecond(const std::uint64_t amount, const std::uint64_t nanoseconds) {
+        return nanoseconds == 0 ? 0.0 : static_cast<double>(amount) * 1e9 / static_cast<double>(nanoseconds);
+    }
+}
+
+std::uint64_t LatencyHistogram::total() const {
+    std::uint64_t sum = 0;
+    for (const std::uint64_t count : counts) {
+        sum += count;
+    }
+    return sum;
+}
+
+double LatencyHistogram::quantile(const double q) const {
+    const std::uint64_t calls = total();
+    if (calls == 0) {
+        return 0.0;
+    }
+
+    const auto rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(calls - 1));
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+        seen += counts[b];
+        if (seen > rank) {
+            return static_cast<double>(std::uint64_t{2} << b);
+        }
+    }
+    return static_cast<double>(std::uint64_t{2} << (kBuckets - 1));
+}
+
+double EngineMetrics::nanosecondsPerCall() const {
+    return calls == 0 ? 0.0 : static_cast<double>(total_ns) / static_cast<double>(calls);
+}
+
+double EngineMetrics::nanosecondsPerContract() const {
+    return contracts == 0 ? 0.0 : static_cast<double>(total_ns) / static_cast<double>(contracts);
+}
+
+double EngineMetrics::pathsPerSecond() const {
+    return perSecond(paths, total_ns);
+}
+
+double EngineMetrics::nodesPerSecond() const {
+    return perSecond(nodes, total_ns);
+}
+
+namespace metrics {
+
+void setEnabled(const bool on) {
+    detail::enabled.store(on, std::memory_order_relaxed);
+}
+
+void reset() {
+    for (EngineCounters& engine : counters) {
+        engine.calls.store(0, std::memory_order_relaxed);
+        engine.contracts.store(0, std::memory_order_relaxed);
+        engine.total_ns.store(0, std::memory_order_relaxed);
+        engine.paths.store(0, std::memory_order_relaxed);
+        engine.nodes.store(0, std::memory_order_relaxed);
+        for (auto& bucket : engine.latency) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+PricingMetrics snapshot() {
+    PricingMetrics result;
+    for (std::size_t e = 0; e < kMetricsEngines; ++e) {
+        const EngineCounters& source = counters[e];
+        EngineMetrics& target = result.engines[e];
+        target.calls = source.calls.load(std::memory_order_relaxed);
+        target.contracts = source.contracts.load(std::memory_order_relaxed);
+        target.total_ns = source.total_ns.load(std::memory_order_relaxed);
+        target.paths = source.paths.load(std::memory_order_relaxed);
+        target.nodes = source.nodes.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b < LatencyHistogram::kBuckets; ++b) {
+            target.latency.counts[b] = source.latency[b].load(std::memory_order_relaxed);
+        }
+    }
+    result.thread_pools = ThreadPool::totalMetrics();
+    return result;
+}
+
+std::string_view engineName(const MetricsEngine engine) {
+    switch (engine) {
+        case MetricsEngine::BlackScholes:
+            return "Black-Scholes";
+        case MetricsEngine::MonteCarlo:
+            return "Monte Carlo";
+        case MetricsEngine::BinomialTree:
+            return "Binomial Tree";
+        case MetricsEngine::FiniteDifference:
+            return "Finite Difference";
+        case MetricsEngine::AmericanApproximation:
+            return "American Approximation";
+    }
+    return "Unknown";
+}
+
+void recordCall(const MetricsEngine engine, const std::uint64_t nanoseconds, const std::uint64_t contracts) {
+    EngineCounters& target = countersOf(engine);
+    target.calls.fetch_add(1, std::memory_order_relaxed);
+    target.contracts.fetch_add(contracts, std::memory_order_relaxed);
+    target.total_ns.fetch_add(nanoseconds, std::memory_order_relaxed);
+    target.latency[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void add(const MetricsEngine engine, const MetricsCounter counter, const std::uint64_t amount) {
+    EngineCounters& target = countersOf(engine);
+    (counter == MetricsCounter::Paths ? target.paths : target.nodes).fetch_add(amount, std::memory_order_relaxed);
+}
+
+} // namespace metrics
+} // namespace pricer
@@ -2,22 +2,317 @@
 // Created by Yusufu Shehu on 18/01/2025.
 //
 #include "pricer/monte_carlo.h"
+#include "pricer/async.h"
+#include "pricer/black_scholes.h"
+#include "pricer/metrics.h"
+#include "pricer/trace.h"
+#include "path_payoff.h"
+#include "vanilla_kernel.h"
+#include "vector_math.h"
 #include <cmath>
 #include <thread>
-#include <future>
 #include <numeric>
-#include <random>
-#include <iostream>
+#include <stdexcept>
+#include <algorithm>
 namespace pricer {
 
+namespace {
+    constexpr const char* kTraceName = "MonteCarlo";
+
+    // Bump sizes shared by the scenario simulation and its finite differences
+    constexpr double kSpotBump = 0.01;          // relative to spot
+    constexpr double kTimeBump = 1.0 / 365.0;   // one day
+    constexpr double kVolBump = 0.0001;
+    constexpr double kRateBump = 0.0001;
+
+    // Leading elements of every per-batch sum array; the spreads are
+    // centred, so the variances never come from differences of large sums
+    enum Moment : size_t {
+        kPayoff,
+        kPayoffSpread,
+        kControl,
+        kControlSpread,
+        kCoSpread
+    };
+
+    /**
+     * @brief Merge the moments of `count` more paths into sums over `total` paths
+     *
+     * Chan, Golub and LeVeque's pairwise update: the spreads of the two
+     * groups add up, plus a term for the distance between their means.
+     */
+    template <size_t N, size_t M>
+    void mergeMoments(std::array<double, N>& sums, const size_t total,
+                      const std::array<double, M>& other, const size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (total == 0) {
+            std::copy_n(other.begin(), kCoSpread + 1, sums.begin());
+            return;
+        }
+
+        const double n_a = static_cast<double>(total);
+        const double n_b = static_cast<double>(count);
+        const double delta_f = other[kPayoff] / n_b - sums[kPayoff] / n_a;
+        const double delta_y = other[kControl] / n_b - sums[kControl] / n_a;
+        const double weight = n_a * n_b / (n_a + n_b);
+
+        sums[kPayoff] += other[kPayoff];
+        sums[kControl] += other[kControl];
+        sums[kPayoffSpread] += other[kPayoffSpread] + delta_f * delta_f * weight;
+        sums[kControlSpread] += other[kControlSpread] + delta_y * delta_y * weight;
+        sums[kCoSpread] += other[kCoSpread] + delta_f * delta_y * weight;
+    }
+
+    // Merge one block of path payoffs and controls, centred on the block means
+    template <size_t N>
+    void addBlockMoments(std::array<double, N>& sums, const size_t total,
+                         const double* payoff, const double* control, const size_t count) {
+        std::array<double, kCoSpread + 1> block{};
+        for (size_t j = 0; j < count; ++j) {
+            block[kPayoff] += payoff[j];
+            block[kControl] += control[j];
+        }
+
+        const double mean_f = block[kPayoff] / static_cast<double>(count);
+        const double mean_y = block[kControl] / static_cast<double>(count);
+        for (size_t j = 0; j < count; ++j) {
+            const double df = payoff[j] - mean_f;
+            const double dy = control[j] - mean_y;
+            block[kPayoffSpread] += df * df;
+            block[kControlSpread] += dy * dy;
+            block[kCoSpread] += df * dy;
+        }
+
+        mergeMoments(sums, total, block, count);
+    }
+
+    // Payoffs and controls of a block of vanilla paths from their log-returns,
+    // averaged with the antithetic paths if anti is set. The type is fixed at
+    // compile time and the control picked once per block, so no loop branches.
+    template <OptionType Type>
+    void vanillaBlock(const double spot, const double strike, const ControlVariate control,
+                      const double* log_return, const double* anti,
+                      double* payoffs, double* controls, const size_t count) {
+        for (size_t j = 0; j < count; ++j) {
+            const double final_price = spot * simd::exp(log_return[j]);
+            payoffs[j] = vanilla::intrinsic<Type>(final_price, strike);
+            controls[j] = final_price;
+        }
+        if (anti) {
+            for (size_t j = 0; j < count; ++j) {
+                const double anti_price = spot * simd::exp(anti[j]);
+                payoffs[j] = (payoffs[j] + vanilla::intrinsic<Type>(anti_price, strike)) / 2.0;
+                controls[j] = (controls[j] + anti_price) / 2.0;
+            }
+        }
+
+        // The controls hold S_T, the TerminalSpot control; the BlackScholes
+        // control is the payoff itself
+        switch (control) {
+            case ControlVariate::TerminalSpot:
+                break;
+            case ControlVariate::BlackScholes:
+                std::copy_n(payoffs, count, controls);
+                break;
+            default:
+                std::fill_n(controls, count, 0.0);
+                break;
+        }
+    }
+
+    // Undiscounted, control-variate adjusted mean payoff and its standard error
+    struct Estimate {
+        double beta;
+        double mean;
+        double std_error;
+    };
+
+    // Control variate with the variance-minimizing coefficient
+    // beta = Cov(f, y) / Var(y), estimated from the same paths
+    template <size_t N>
+    Estimate controlledMean(const std::array<double, N>& sums, const size_t paths, const double control_mean) {
+        const double n = static_cast<double>(paths);
+        const double beta = sums[kControlSpread] > 0.0 ? sums[kCoSpread] / sums[kControlSpread] : 0.0;
+        const double spread = sums[kPayoffSpread] - 2.0 * beta * sums[kCoSpread]
+                              + beta * beta * sums[kControlSpread];
+        return {beta,
+                (sums[kPayoff] - beta * (sums[kControl] - n * control_mean)) / n,
+                std::sqrt(std::max(spread, 0.0)) / n};
+    }
+
+    /**
+     * @brief Least-squares coefficients from accumulated normal equations
+     *
+     * Cholesky factorization that drops a basis function whose pivot
+     * vanishes, i.e. one the in-the-money paths cannot tell apart from the
+     * earlier ones, so a date with few such paths still gets a fit.
+     */
+    template <size_t N>
+    std::array<double, N> solveNormalEquations(const std::array<double, N * N>& gram,
+                                               const std::array<double, N>& rhs) {
+        std::array<double, N * N> lower{};
+        std::array<bool, N> kept{};
+        for (size_t j = 0; j < N; ++j) {
+            double pivot = gram[j * N + j];
+            for (size_t k = 0; k < j; ++k) {
+                pivot -= lower[j * N + k] * lower[j * N + k];
+            }
+            if (!(pivot > 1e-12 * gram[j * N + j])) {
+                continue;
+            }
+            kept[j] = true;
+            lower[j * N + j] = std::sqrt(pivot);
+            for (size_t i = j + 1; i < N; ++i) {
+                double entry = gram[i * N + j];
+                for (size_t k = 0; k < j; ++k) {
+                    entry -= lower[i * N + k] * lower[j * N + k];
+                }
+                lower[i * N + j] = entry / lower[j * N + j];
+            }
+        }
+
+        std::array<double, N> y{};
+        for (size_t j = 0; j < N; ++j) {
+            if (kept[j]) {
+                double entry = rhs[j];
+                for (size_t k = 0; k < j; ++k) {
+                    entry -= lower[j * N + k] * y[k];
+                }
+                y[j] = entry / lower[j * N + j];
+            }
+        }
+
+        std::array<double, N> beta{};
+        for (size_t j = N; j-- > 0;) {
+            if (kept[j]) {
+                double entry = y[j];
+                for (size_t i = j + 1; i < N; ++i) {
+                    entry -= lower[i * N + j] * beta[i];
+                }
+                beta[j] = entry / lower[j * N + j];
+            }
+        }
+        return beta;
+    }
+
+    // Least-squares Monte Carlo regresses the continuation value on 1, m,
+    // m^2 and m^3 in the moneyness m = S / K - 1. Its normal equations are
+    // the power sums of m up to m^6, and the cash flows times 1 ... m^3.
+    constexpr size_t kBasis = 4;
+    constexpr size_t kPowers = 2 * kBasis - 1;
+    constexpr size_t kRowLanes = 64;
+
+    // Running sums per block lane, so the accumulation is elementwise and
+    // vectorizes; a chunk reduces its lanes once, in order
+    struct RegressionRows {
+        std::array<std::array<double, kRowLanes>, kPowers> power{};
+        std::array<std::array<double, kRowLanes>, kBasis> flow{};
+    };
+
+    // Exercise where the payoff max(phi (S - K), 0) beats the fitted
+    // continuation value, then discount the cash flows by one date
+    PRICER_SIMD_CLONES
+    void exerciseRow(const double* spot, double* cash_flow, const double strike, const double phi,
+                     const double* coefficients, const double discount, const size_t count) {
+        if (!coefficients) {
+            for (size_t j = 0; j < count; ++j) {
+                cash_flow[j] *= discount;
+            }
+            return;
+        }
+
+        const double b0 = coefficients[0];
+        const double b1 = coefficients[1];
+        const double b2 = coefficients[2];
+        const double b3 = coefficients[3];
+        for (size_t j = 0; j < count; ++j) {
+            const double intrinsic = std::max(phi * (spot[j] - strike), 0.0);
+            const double m = spot[j] / strike - 1.0;
+            const double continuation = b0 + m * (b1 + m * (b2 + m * b3));
+            const bool exercise = intrinsic > 0.0 && intrinsic > continuation;
+            cash_flow[j] = (exercise ? intrinsic : cash_flow[j]) * discount;
+        }
+    }
+
+    // Spots on the bridged Brownian motion, then the regression terms of
+    // the paths that are in the money there
+    PRICER_SIMD_CLONES
+    void regressionRow(const double* brownian, const double sign, const double spot_0, const double drift,
+                       const double sigma, const double strike, const double phi, double* spot,
+                       const double* cash_flow, RegressionRows& rows, const size_t count) {
+        for (size_t j = 0; j < count; ++j) {
+            const double s = spot_0 * simd::exp(drift + sign * sigma * brownian[j]);
+            spot[j] = s;
+
+            const double m = s / strike - 1.0;
+            const double m2 = m * m;
+            const double m3 = m2 * m;
+            const double w = phi * (s - strike) > 0.0 ? 1.0 : 0.0;
+            const double f = w * cash_flow[j];
+            rows.power[0][j] += w;
+            rows.power[1][j] += w * m;
+            rows.power[2][j] += w * m2;
+            rows.power[3][j] += w * m3;
+            rows.power[4][j] += w * m2 * m2;
+            rows.power[5][j] += w * m2 * m3;
+            rows.power[6][j] += w * m3 * m3;
+            rows.flow[0][j] += f;
+            rows.flow[1][j] += f * m;
+            rows.flow[2][j] += f * m2;
+            rows.flow[3][j] += f * m3;
+        }
+    }
+
+    /**
+     * @brief Greeks as central differences of a pricing function
+     *
+     * The function should reuse its random numbers across calls, so the
+     * noise of the bumped prices cancels in the differences.
+     * @param base Unbumped result, which supplies the price and its error
+     */
+    template <typename Price>
+    PricingResult bumpAndReprice(const OptionParameters& option, PricingResult base, Price&& price) {
+        const async::ScopedQuiet quiet;
+        const double S = option.getSpot();
+        const double T = option.getExpiry();
+        const double sigma = option.getVolatility();
+        const double r = option.getRate();
+        const double h_spot = kSpotBump * S;
+        const double h_time = kTimeBump;
+        const double h_time_down = T > h_time ? h_time : 0.0;
+
+        const double spot_up = price(option.withSpot(S + h_spot));
+        const double spot_down = price(option.withSpot(S - h_spot));
+        base.delta = (spot_up - spot_down) / (2.0 * h_spot);
+        base.gamma = (spot_up - 2.0 * base.price + spot_down) / (h_spot * h_spot);
+        base.theta = -(price(option.withExpiry(T + h_time)) -
+                       (h_time_down > 0.0 ? price(option.withExpiry(T - h_time_down)) : base.price))
+                     / (h_time + h_time_down) / 365.0;
+        base.vega = (price(option.withVolatility(sigma + kVolBump)) - price(option.withVolatility(sigma - kVolBump)))
+                    / (2.0 * kVolBump) / 100.0;
+        base.rho = (price(option.withRate(r + kRateBump)) - price(option.withRate(r - kRateBump)))
+                   / (2.0 * kRateBump) / 100.0;
+        return base;
+    }
+
+    // Layout of MonteCarloEngine::EstimatorSums after the moments
+    enum Estimator : size_t {
+        kDeltaTerm = kCoSpread + 1,
+        kGammaTerm,
+        kVegaTerm,
+        kRhoTerm,
+        kTimeTerm
+    };
+}
+
 MonteCarloEngine::MonteCarloEngine(size_t num_paths, size_t num_steps,
                                  bool use_antithetic, size_t num_threads)
     : num_paths_(num_paths)
     , num_steps_(num_steps)
     , use_antithetic_(use_antithetic)
-    , num_threads_(num_threads)
-    , last_mean_(0.0)
-    , last_stderr_(0.0) {
+    , num_threads_(num_threads) {
 
     // If num_threads is 0, use hardware concurrency
     if (num_threads_ == 0) {
@@ -25,233 +320,953 @@ MonteCarloEngine::MonteCarloEngine(size_t num_paths, size_t num_steps,
     }
 }
 
-double MonteCarloEngine::calculate(const Option& option) const {
-    // Split paths among threads
-    size_t paths_per_thread = num_paths_ / num_threads_;
-    std::vector<std::future<std::pair<double, double>>> futures;
+void MonteCarloEngine::setPayoff(Payoff payoff) {
+    if (const auto* barrier = std::get_if<BarrierPayoff>(&payoff)) {
+        if (!(barrier->barrier > 0.0)) {
+            throw std::invalid_argument("Barrier must be positive");
+        }
+        if (barrier->rebate < 0.0) {
+            throw std::invalid_argument("Rebate must be non-negative");
+        }
+    }
+    payoff_ = payoff;
+}
+
+template <typename Sums>
+MonteCarloEngine::Batches<Sums> MonteCarloEngine::runBatches(
+    Sums (MonteCarloEngine::*batch)(const OptionParameters&, size_t, size_t) const,
+    const OptionParameters& option) const {
+
+    const auto start = std::chrono::steady_clock::now();
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+
+    // Chunks never straddle a replicate; within each replicate every chunk
+    // is full except possibly the last, which takes the remainder
+    struct Chunk {
+        size_t replicate;
+        size_t begin;
+        size_t count;
+    };
+    const size_t replicates = replicateCount();
+    std::vector<Chunk> chunks;
+    for (size_t r = 0; r < replicates; ++r) {
+        const size_t end = replicateBegin(r + 1);
+        for (size_t begin = replicateBegin(r); begin < end; begin += kChunkPaths) {
+            chunks.push_back({r, begin, std::min(kChunkPaths, end - begin)});
+        }
+    }
+
+    const double control_mean = controlMean(option);
+    auto estimate = [control_mean](const Sums& sums, const size_t paths) {
+        return controlledMean(sums, paths, control_mean);
+    };
 
-    futures.reserve(num_threads_);
-    for (size_t i = 0; i < num_threads_; ++i) {
-        futures.push_back(
-            std::async(std::launch::async,
-                      &MonteCarloEngine::simulateBatch,
-                      this,
-                      std::ref(option),
-                      static_cast<unsigned int>(i),
-                      paths_per_thread)
-        );
+    std::vector<Sums> partial(chunks.size());
+    Sums sums{};
+    size_t paths = 0;
+    std::vector<std::array<double, 2>> replicate_sums(replicates, {0.0, 0.0});
+    auto merge = [&](const size_t i) {
+        mergeMoments(sums, paths, partial[i], chunks[i].count);
+        for (size_t k = kNumMoments; k < sums.size(); ++k) {
+            sums[k] += partial[i][k];
+        }
+        paths += chunks[i].count;
+        replicate_sums[chunks[i].replicate][0] += partial[i][kPayoff];
+        replicate_sums[chunks[i].replicate][1] += partial[i][kControl];
+    };
+    auto simulateChunks = [&](const size_t first, const size_t last) {
+        pool.parallelFor(last - first, [&](const size_t i) {
+            partial[first + i] = (this->*batch)(option, chunks[first + i].begin, chunks[first + i].count);
+        }, num_threads_);
+    };
+
+    const bool has_budget = time_budget_.count() > 0;
+    const bool adaptive = replicates == 1 && (target_std_error_ > 0.0 || has_budget);
+    // A job runs in waves too, to check its token and report the estimate
+    // between them. Chunks still merge in order, so the price is unchanged.
+    const bool in_job = async::currentJob() != nullptr;
+    size_t simulated = chunks.size();
+    if (adaptive || in_job) {
+        // Each wave gives every thread a couple of chunks. Chunks finished
+        // past the one that met the target are dropped, so the target alone
+        // never makes the price depend on the wave size.
+        const double discount = simd::exp(-option.getRate() * option.getExpiry());
+        const size_t wave = 2 * std::max<size_t>(1, std::min(num_threads_, pool.size()));
+        size_t merged = 0;
+        simulated = 0;
+        bool done = false;
+        while (!done && merged < chunks.size()) {
+            async::checkpoint();
+            simulated = std::min(chunks.size(), merged + wave);
+            simulateChunks(merged, simulated);
+            while (!done && merged < simulated) {
+                merge(merged++);
+                done = adaptive && target_std_error_ > 0.0
+                       && estimate(sums, paths).std_error * discount <= target_std_error_;
+            }
+            done = done || (adaptive && has_budget && std::chrono::steady_clock::now() - start >= time_budget_);
+
+            if (in_job) {
+                const Estimate partial = estimate(sums, paths);
+                PricingProgress progress;
+                progress.fraction = done ? 1.0 : static_cast<double>(paths) / static_cast<double>(num_paths_);
+                progress.has_estimate = true;
+                progress.estimate.price = partial.mean * discount;
+                progress.estimate.std_error = partial.std_error * discount;
+                progress.estimate.paths = paths;
+                async::report(progress);
+            }
+        }
+    } else {
+        simulateChunks(0, chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            merge(i);
+        }
     }
+    PRICER_METRICS_ADD(MetricsEngine::MonteCarlo, MetricsCounter::Paths,
+                       simulated == 0 ? 0 : chunks[simulated - 1].begin + chunks[simulated - 1].count);
 
-    // Collect results
-    double sum_payoffs = 0.0;
-    double sum_squared_payoffs = 0.0;
-    for (auto& future : futures) {
-        auto result = future.get();
-        sum_payoffs += result.first;
-        sum_squared_payoffs += result.second;
+    const Estimate result = paths > 0 ? estimate(sums, paths) : Estimate{0.0, 0.0, 0.0};
+    double std_error = result.std_error;
+
+    if (replicates > 1) {
+        // Randomized QMC: the replicate means are i.i.d., the points within
+        // one replicate are not
+        std::vector<double> means(replicates);
+        double average = 0.0;
+        for (size_t r = 0; r < replicates; ++r) {
+            const double n = static_cast<double>(replicateBegin(r + 1) - replicateBegin(r));
+            means[r] = (replicate_sums[r][0] - result.beta * (replicate_sums[r][1] - n * control_mean)) / n;
+            average += means[r] / static_cast<double>(replicates);
+        }
+        double spread = 0.0;
+        for (const double m : means) {
+            spread += (m - average) * (m - average);
+        }
+        std_error = std::sqrt(spread / static_cast<double>(replicates * (replicates - 1)));
     }
 
-    // Calculate mean, variance, and standard error
-    const double total_paths = paths_per_thread * num_threads_;
-    const double mean = sum_payoffs / total_paths;
-    const double variance = (sum_squared_payoffs / total_paths - mean * mean);
-    const double stderr = std::sqrt(variance / total_paths);
+    PRICER_TRACE(kTraceName, "Total Paths", static_cast<double>(paths));
+    PRICER_TRACE(kTraceName, "Replicates", static_cast<double>(replicates));
+    PRICER_TRACE(kTraceName, "Control Coefficient", result.beta);
+    PRICER_TRACE(kTraceName, "Mean", result.mean);
+    PRICER_TRACE(kTraceName, "Standard Error", std_error);
 
-    // Debug statements
-    std::cout << "Debug: Total Paths: " << total_paths << std::endl;
-    std::cout << "Debug: Sum of Payoffs: " << sum_payoffs << std::endl;
-    std::cout << "Debug: Sum of Squared Payoffs: " << sum_squared_payoffs << std::endl;
-    std::cout << "Debug: Mean: " << mean << std::endl;
-    std::cout << "Debug: Variance: " << variance << std::endl;
-    std::cout << "Debug: Standard Error: " << stderr << std::endl;
+    return {sums, result.mean, std_error, paths};
+}
 
-    // Store statistics for confidence interval
-    last_mean_ = mean;
-    last_stderr_ = stderr;
+size_t MonteCarloEngine::replicateCount() const {
+    // Unscrambled Sobol points are deterministic, so there is nothing to replicate
+    if (sequence_type_ != SequenceType::Sobol || !scramble_) {
+        return 1;
+    }
+    return std::max<size_t>(1, std::min(replicates_, num_paths_));
+}
 
-    // Discount to present value
-    return mean * std::exp(-option.getRate() * option.getExpiry());
+size_t MonteCarloEngine::replicateBegin(const size_t replicate) const {
+    const size_t replicates = replicateCount();
+    const size_t base = num_paths_ / replicates;
+    return replicate * base + std::min(replicate, num_paths_ % replicates);
 }
 
+std::uint32_t MonteCarloEngine::scrambleSeed(const size_t replicate, const size_t dim) const {
+    return philox4x32({static_cast<std::uint32_t>(dim), static_cast<std::uint32_t>(replicate), 0, 0},
+                      {static_cast<std::uint32_t>(seed_), static_cast<std::uint32_t>(seed_ >> 32)})[0];
+}
 
+PricingResult MonteCarloEngine::simulate(const OptionParameters& option) const {
+    PRICER_METRICS_TIMER(MetricsEngine::MonteCarlo);
+    const bool path_dependent = isPathDependent(payoff_);
+    if (option.isAmerican()) {
+        if (path_dependent) {
+            throw std::invalid_argument("Path-dependent payoffs need European exercise");
+        }
+        return simulateAmerican(option);
+    }
+    const auto [sums, mean, std_error, paths] = runBatches(
+        path_dependent ? &MonteCarloEngine::simulatePathBatch : &MonteCarloEngine::simulateBatch, option);
+
+    PRICER_TRACE(kTraceName, "Sum of Payoffs", sums[kPayoff]);
+    PRICER_TRACE(kTraceName, "Payoff Spread", sums[kPayoffSpread]);
+
+    // Discount to present value
+    const double discount = simd::exp(-option.getRate() * option.getExpiry());
+
+    PricingResult result;
+    result.price = mean * discount;
+    result.std_error = std_error * discount;
+    result.paths = paths;
+    return result;
+}
+
+double MonteCarloEngine::calculate(const OptionParameters& option) const {
+    return simulate(option).price;
+}
 
-std::vector<double> MonteCarloEngine::generatePath(
-    const Option& option,
-    std::mt19937& rng,
+void MonteCarloEngine::generatePath(
+    const OptionParameters& option,
+    const std::uint64_t path_index,
+    const std::span<double> path,
     const bool antithetic) const {
 
-    std::normal_distribution<double> normal(0.0, 1.0);
+    if (path.size() != num_steps_ + 1) {
+        throw std::invalid_argument("Path buffer must hold num_steps + 1 values");
+    }
 
     const double S = option.getSpot();
-    const double r = option.getRate();
-    const double q = option.getDividend();
     const double sigma = option.getVolatility();
     const double T = option.getExpiry();
-
     const double dt = T / num_steps_;
-    const double drift = (r - q - 0.5 * sigma * sigma) * dt;
+    const double drift = (option.getRate() - option.getDividend() - 0.5 * sigma * sigma) * dt;
     const double vol = sigma * std::sqrt(dt);
 
-    std::vector<double> path(num_steps_ + 1);
     path[0] = S;
 
+    if (sequence_type_ == SequenceType::PseudoRandom) {
+        const CounterBasedRng rng(random_generator_, seed_);
+        for (size_t i = 0; i < num_steps_; ++i) {
+            double z = rng.normal(path_index, i);
+            if (antithetic) z = -z;  // Antithetic variate
+
+            path[i + 1] = path[i] * simd::exp(drift + vol * z);
+        }
+        return;
+    }
+
+    // One Sobol dimension per step; scratch is reused across calls
+    const SobolSequence sobol(num_steps_);
+    const size_t replicate = replicateOf(path_index);
+    const std::uint64_t point = path_index - replicateBegin(replicate);
+
+    thread_local std::vector<double> z;
+    thread_local std::vector<double> w;
+    z.resize(num_steps_);
+    w.resize(num_steps_);
     for (size_t i = 0; i < num_steps_; ++i) {
-        double z = normal(rng);
-        if (antithetic) z = -z;  // Antithetic variate
+        sobol.normals(point, i, scramble_, scrambleSeed(replicate, i), std::span<double>(&z[i], 1));
+        if (antithetic) z[i] = -z[i];
+    }
+
+    if (brownian_bridge_) {
+        BrownianBridge(num_steps_).build(z, w);
+        const double scale = sigma * std::sqrt(T);
+        for (size_t i = 0; i < num_steps_; ++i) {
+            path[i + 1] = S * simd::exp(drift * static_cast<double>(i + 1) + scale * w[i]);
+        }
+    } else {
+        for (size_t i = 0; i < num_steps_; ++i) {
+            path[i + 1] = path[i] * simd::exp(drift + vol * z[i]);
+        }
+    }
+}
 
-        path[i + 1] = path[i] * std::exp(drift + vol * z);
+size_t MonteCarloEngine::simulationSteps() const {
+    if (path_sampling_ == PathSampling::Automatic) {
+        return isPathDependent(payoff_) ? num_steps_ : 1;
     }
+    return path_sampling_ == PathSampling::FullPath ? num_steps_ : 1;
+}
+
+MonteCarloEngine::PathDraws MonteCarloEngine::makeDraws(const size_t steps) const {
+    PathDraws draws{CounterBasedRng(random_generator_, seed_), std::nullopt};
+    if (sequence_type_ == SequenceType::Sobol) {
+        // With the bridge only dimension 0 (W_T) reaches a terminal payoff
+        draws.sobol.emplace(brownian_bridge_ ? 1 : steps);
+    }
+    return draws;
+}
 
-    return path;
+size_t MonteCarloEngine::replicateOf(const std::uint64_t path) const {
+    const size_t replicates = replicateCount();
+    const size_t base = num_paths_ / replicates;
+    const size_t extra = num_paths_ % replicates;
+
+    // The first `extra` replicates hold one path more than the others
+    const std::uint64_t boundary = extra * (base + 1);
+    if (path < boundary) {
+        return static_cast<size_t>(path / (base + 1));
+    }
+    return std::min(replicates - 1, static_cast<size_t>(extra + (path - boundary) / std::max<size_t>(base, 1)));
+}
+
+void MonteCarloEngine::evolveBlock(
+    const OptionParameters& option,
+    const size_t steps,
+    const PathDraws& draws,
+    const std::uint64_t first_path,
+    const size_t count,
+    double* log_return,
+    double* anti_log_return) const {
+
+    const double sigma = option.getVolatility();
+    const double T = option.getExpiry();
+    const double dt = T / steps;
+    const double drift = (option.getRate() - option.getDividend() - 0.5 * sigma * sigma) * dt;
+    const double vol = sigma * std::sqrt(dt);
+
+    std::array<double, kPathBlock> z;
+    const std::span<double> block(z.data(), count);
+    std::fill_n(log_return, count, 0.0);
+    if (anti_log_return) {
+        std::fill_n(anti_log_return, count, 0.0);
+    }
+
+    // Sobol points are indexed within their replicate, and a bridged path
+    // reaches S_T in a single draw of variance T
+    size_t dims = steps;
+    double dim_drift = drift;
+    double dim_vol = vol;
+    size_t replicate = 0;
+    std::uint64_t point = 0;
+    if (draws.sobol) {
+        replicate = replicateOf(first_path);
+        point = first_path - replicateBegin(replicate);
+        if (brownian_bridge_) {
+            dims = 1;
+            dim_drift = drift * static_cast<double>(steps);
+            dim_vol = sigma * std::sqrt(T);
+        }
+    }
+
+    for (size_t d = 0; d < dims; ++d) {
+        if (draws.sobol) {
+            draws.sobol->normals(point, d, scramble_, scrambleSeed(replicate, d), block);
+        } else {
+            draws.rng.normals(first_path, d, block);
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            log_return[j] += dim_drift + dim_vol * z[j];
+        }
+
+        if (anti_log_return) {
+            for (size_t j = 0; j < count; ++j) {
+                anti_log_return[j] += dim_drift - dim_vol * z[j];
+            }
+        }
+    }
 }
 
 double MonteCarloEngine::calculatePayoff(
-    const Option& option,
+    const OptionParameters& option,
     double final_price) {
 
-    double K = option.getStrike();
+    return vanilla::dispatch(option.getType(), [&](const auto type) {
+        return vanilla::intrinsic<decltype(type)::value>(final_price, option.getStrike());
+    });
+}
 
-    if (option.getType() == OptionType::Call) {
-        return std::max(final_price - K, 0.0);
-    } else {
-        return std::max(K - final_price, 0.0);
+double MonteCarloEngine::controlPayoff(const OptionParameters& option, const double final_price) const {
+    switch (control_variate_) {
+        case ControlVariate::TerminalSpot:
+            return final_price;
+        case ControlVariate::BlackScholes:
+            return calculatePayoff(option, final_price);
+        default:
+            return 0.0;
     }
 }
 
-std::pair<double, double> MonteCarloEngine::simulateBatch(
-    const Option& option,
-    unsigned int seed,
+double MonteCarloEngine::controlMean(const OptionParameters& option) const {
+    const double r = option.getRate();
+    const double T = option.getExpiry();
+
+    // Undiscounted expectations, like the payoff sums they are compared with
+    switch (control_variate_) {
+        case ControlVariate::TerminalSpot:
+            return option.getSpot() * simd::exp((r - option.getDividend()) * T);
+        case ControlVariate::BlackScholes:
+            return BlackScholesPricingEngine().calculate(option) * simd::exp(r * T);
+        default:
+            return 0.0;
+    }
+}
+
+MonteCarloEngine::MomentSums MonteCarloEngine::simulateBatch(
+    const OptionParameters& option,
+    size_t first_path,
     size_t num_paths) const {
 
-    std::mt19937 rng(seed);
-    double sum_payoffs = 0.0;
-    double sum_squared_payoffs = 0.0;
+    const size_t steps = simulationSteps();
+    const PathDraws draws = makeDraws(steps);
+    const double S = option.getSpot();
 
-    for (size_t i = 0; i < num_paths; ++i) {
-        // Generate path and calculate payoff
-        auto path = generatePath(option, rng, false);
-        double payoff = calculatePayoff(option, path.back());
+    std::array<double, kPathBlock> log_return;
+    std::array<double, kPathBlock> anti_log_return;
+    std::array<double, kPathBlock> payoffs;
+    std::array<double, kPathBlock> controls;
+    double* anti = use_antithetic_ ? anti_log_return.data() : nullptr;
+
+    MomentSums sums{};
+
+    vanilla::dispatch(option.getType(), [&](const auto type) {
+        for (size_t begin = 0; begin < num_paths; begin += kPathBlock) {
+            const size_t count = std::min(kPathBlock, num_paths - begin);
+            evolveBlock(option, steps, draws, first_path + begin, count, log_return.data(), anti);
+            vanillaBlock<decltype(type)::value>(S, option.getStrike(), control_variate_, log_return.data(), anti,
+                                                payoffs.data(), controls.data(), count);
+            addBlockMoments(sums, begin, payoffs.data(), controls.data(), count);
+        }
+    });
+
+    return sums;
+}
+
+MonteCarloEngine::MomentSums MonteCarloEngine::simulatePathBatch(
+    const OptionParameters& option,
+    size_t first_path,
+    size_t num_paths) const {
+
+    return std::visit([&](const auto& payoff) {
+        return simulatePaths(path::makeKernel(payoff), option, first_path, num_paths);
+    }, payoff_);
+}
+
+template <typename Kernel>
+MonteCarloEngine::MomentSums MonteCarloEngine::simulatePaths(
+    Kernel kernel,
+    const OptionParameters& option,
+    size_t first_path,
+    size_t num_paths) const {
+
+    static_assert(kPathBlock == path::kBlock);
+    const double sigma = option.getVolatility();
+    const size_t steps = std::max<size_t>(1, simulationSteps());
+    const double dt = option.getExpiry() / static_cast<double>(steps);
+    const double drift = (option.getRate() - option.getDividend() - 0.5 * sigma * sigma) * dt;
+    const double vol = sigma * std::sqrt(dt);
+    const double log_spot = std::log(option.getSpot());
+    const path::Grid grid{option.getType(), option.getStrike(), sigma, dt, steps};
 
+    // Every step is a monitoring date, so the dimensions follow time even
+    // where the Brownian bridge would reorder them
+    PathDraws draws{CounterBasedRng(random_generator_, seed_), std::nullopt};
+    if (sequence_type_ == SequenceType::Sobol) {
+        draws.sobol.emplace(steps);
+    }
+
+    Kernel anti_kernel = kernel;
+    std::array<double, kPathBlock> z;
+    std::array<double, kPathBlock> previous;
+    std::array<double, kPathBlock> current;
+    std::array<double, kPathBlock> anti_previous;
+    std::array<double, kPathBlock> anti_current;
+    std::array<double, kPathBlock> payoffs;
+    std::array<double, kPathBlock> anti_payoffs;
+    std::array<double, kPathBlock> controls;
+
+    MomentSums sums{};
+
+    for (size_t begin = 0; begin < num_paths; begin += kPathBlock) {
+        const size_t count = std::min(kPathBlock, num_paths - begin);
+        const std::uint64_t first = first_path + begin;
+        const std::span<double> block(z.data(), count);
+        size_t replicate = 0;
+        std::uint64_t point = 0;
+        if (draws.sobol) {
+            replicate = replicateOf(first);
+            point = first - replicateBegin(replicate);
+        }
+
+        kernel.start(log_spot, grid, count);
+        std::fill_n(current.begin(), count, log_spot);
         if (use_antithetic_) {
-            // Generate antithetic path
-            auto anti_path = generatePath(option, rng, true);
-            double anti_payoff = calculatePayoff(option, anti_path.back());
+            anti_kernel.start(log_spot, grid, count);
+            std::fill_n(anti_current.begin(), count, log_spot);
+        }
 
-            // Average the payoffs
-            payoff = (payoff + anti_payoff) / 2.0;
+        for (size_t d = 0; d < steps; ++d) {
+            if (draws.sobol) {
+                draws.sobol->normals(point, d, scramble_, scrambleSeed(replicate, d), block);
+            } else {
+                draws.rng.normals(first, d, block);
+            }
+
+            for (size_t j = 0; j < count; ++j) {
+                previous[j] = current[j];
+                current[j] += drift + vol * z[j];
+            }
+            kernel.observe(previous.data(), current.data(), count);
+
+            if (use_antithetic_) {
+                for (size_t j = 0; j < count; ++j) {
+                    anti_previous[j] = anti_current[j];
+                    anti_current[j] += drift - vol * z[j];
+                }
+                anti_kernel.observe(anti_previous.data(), anti_current.data(), count);
+            }
         }
 
-        sum_payoffs += payoff;
-        sum_squared_payoffs += payoff * payoff;
+        kernel.settle(current.data(), payoffs.data(), count);
+        for (size_t j = 0; j < count; ++j) {
+            controls[j] = controlPayoff(option, simd::exp(current[j]));
+        }
+        if (use_antithetic_) {
+            anti_kernel.settle(anti_current.data(), anti_payoffs.data(), count);
+            for (size_t j = 0; j < count; ++j) {
+                payoffs[j] = (payoffs[j] + anti_payoffs[j]) / 2.0;
+                controls[j] = (controls[j] + controlPayoff(option, simd::exp(anti_current[j]))) / 2.0;
+            }
+        }
+
+        addBlockMoments(sums, begin, payoffs.data(), controls.data(), count);
     }
 
-    return {sum_payoffs, sum_squared_payoffs};
+    return sums;
 }
 
-    std::pair<double, double> MonteCarloEngine::getConfidenceInterval(const Option& option) const {
-    // 95% confidence interval (1.96 standard errors)
-    constexpr double z_score = 1.96;
-    double margin = z_score * last_stderr_;
+MonteCarloEngine::EstimatorSums MonteCarloEngine::simulateEstimators(
+    const OptionParameters& option,
+    size_t first_path,
+    size_t num_paths) const {
 
-    // Discount factor
-    const double discount = std::exp(-option.getRate() * option.getExpiry());
+    const double S = option.getSpot();
+    const double r = option.getRate();
+    const double q = option.getDividend();
+    const double sigma = option.getVolatility();
+    const double T = option.getExpiry();
+    const double nu = r - q - 0.5 * sigma * sigma;
+    const double sqrt_T = std::sqrt(T);
+    const double sigma_sqrt_T = sigma * sqrt_T;
+    const bool likelihood_ratio = greek_method_ == GreekMethod::LikelihoodRatio;
 
-    // Apply discounting to the mean and margin
-    double discounted_mean = last_mean_ * discount;
-    double discounted_margin = margin * discount;
+    const double K = option.getStrike();
+    const size_t steps = simulationSteps();
+    const PathDraws draws = makeDraws(steps);
+    EstimatorSums sums{};
 
-    return {discounted_mean - discounted_margin, discounted_mean + discounted_margin};
-}
+    vanilla::dispatch(option.getType(), [&](const auto type) {
+        constexpr OptionType Type = decltype(type)::value;
 
+        // Adds one path's Greek terms, writing S_T = S * exp(nu * T + sigma * W_T)
+        auto accumulate = [&](const double log_return, const double weight) {
+            const double final_price = S * simd::exp(log_return);
+            const double sigma_w = log_return - nu * T;
+            const double z = sigma_w / sigma_sqrt_T;
 
-double MonteCarloEngine::calculateDelta(const Option& option) const {
-    // Use finite difference approximation
-    const double h = 0.01 * option.getSpot();
+            if (likelihood_ratio) {
+                // Payoff times the score of the lognormal density of S_T
+                const double f = weight * vanilla::intrinsic<Type>(final_price, K);
+                sums[kDeltaTerm] += f * z / (S * sigma_sqrt_T);
+                sums[kGammaTerm] += f * (z * z - 1.0 - z * sigma_sqrt_T) / (S * S * sigma * sigma * T);
+                sums[kVegaTerm] += f * ((z * z - 1.0) / sigma - z * sqrt_T);
+                sums[kRhoTerm] += f * z * sqrt_T / sigma;
+                sums[kTimeTerm] += f * ((z * z - 1.0) / (2.0 * T) + z * nu / sigma_sqrt_T);
+            } else {
+                // Payoff slope times dS_T/dθ; gamma differentiates the slope's
+                // expectation by likelihood ratio since the slope is a step
+                const double g = weight * vanilla::slope<Type>(final_price, K) * final_price;
+                sums[kDeltaTerm] += g / S;
+                sums[kGammaTerm] += g * (z / sigma_sqrt_T - 1.0) / (S * S);
+                sums[kVegaTerm] += g * (sigma_w - sigma * sigma * T) / sigma;
+                sums[kRhoTerm] += g * T;
+                sums[kTimeTerm] += g * (nu + 0.5 * sigma_w / T);
+            }
+        };
 
-    // Calculate up price
-    double spot = option.getSpot();
-    const_cast<Option&>(option).setSpot(spot + h);
-    double up_price = calculate(option);
+        std::array<double, kPathBlock> log_return;
+        std::array<double, kPathBlock> anti_log_return;
+        std::array<double, kPathBlock> payoffs;
+        std::array<double, kPathBlock> controls;
+        double* anti = use_antithetic_ ? anti_log_return.data() : nullptr;
 
-    // Calculate down price
-    const_cast<Option&>(option).setSpot(spot - h);
-    double down_price = calculate(option);
+        for (size_t begin = 0; begin < num_paths; begin += kPathBlock) {
+            const size_t count = std::min(kPathBlock, num_paths - begin);
+            evolveBlock(option, steps, draws, first_path + begin, count, log_return.data(), anti);
+            vanillaBlock<Type>(S, K, control_variate_, log_return.data(), anti,
+                               payoffs.data(), controls.data(), count);
 
-    // Reset spot price
-    const_cast<Option&>(option).setSpot(spot);
+            if (anti) {
+                for (size_t j = 0; j < count; ++j) {
+                    accumulate(log_return[j], 0.5);
+                    accumulate(anti[j], 0.5);
+                }
+            } else {
+                for (size_t j = 0; j < count; ++j) {
+                    accumulate(log_return[j], 1.0);
+                }
+            }
+            addBlockMoments(sums, begin, payoffs.data(), controls.data(), count);
+        }
+    });
 
-    return (up_price - down_price) / (2.0 * h);
+    return sums;
 }
 
-double MonteCarloEngine::calculateGamma(const Option& option) const {
-    const double h = 0.01 * option.getSpot();
-    double spot = option.getSpot();
+MonteCarloEngine::ScenarioSums MonteCarloEngine::simulateScenarios(
+    const OptionParameters& option,
+    size_t first_path,
+    size_t num_paths) const {
 
-    // Calculate up price
-    const_cast<Option&>(option).setSpot(spot + h);
-    double up_price = calculate(option);
+    const double S = option.getSpot();
+    const double r = option.getRate();
+    const double q = option.getDividend();
+    const double sigma = option.getVolatility();
+    const double T = option.getExpiry();
+    const double nu = r - q - 0.5 * sigma * sigma;
 
-    // Calculate center price
-    const_cast<Option&>(option).setSpot(spot);
-    double center_price = calculate(option);
+    const double h_spot = kSpotBump * S;
+    const double h_time = kTimeBump;
+    const double h_time_down = T > h_time ? h_time : 0.0;
+    const double h_vol = kVolBump;
+    const double h_rate = kRateBump;
 
-    // Calculate down price
-    const_cast<Option&>(option).setSpot(spot - h);
-    double down_price = calculate(option);
+    // Every scenario's terminal price is S * exp(a + b * sigma * W_T) of the base path
+    auto vol_drift = [&](double vol) { return (r - q - 0.5 * vol * vol) * T; };
+    const std::array<double, kNumScenarios> a = {
+        nu * T,
+        simd::log((S + h_spot) / S) + nu * T,
+        simd::log((S - h_spot) / S) + nu * T,
+        nu * (T + h_time),
+        nu * (T - h_time_down),
+        vol_drift(sigma + h_vol),
+        vol_drift(sigma - h_vol),
+        (nu + h_rate) * T,
+        (nu - h_rate) * T
+    };
+    const std::array<double, kNumScenarios> b = {
+        1.0,
+        1.0,
+        1.0,
+        std::sqrt((T + h_time) / T),
+        std::sqrt((T - h_time_down) / T),
+        (sigma + h_vol) / sigma,
+        (sigma - h_vol) / sigma,
+        1.0,
+        1.0
+    };
 
-    // Reset spot price
-    const_cast<Option&>(option).setSpot(spot);
+    const double K = option.getStrike();
+    const size_t steps = simulationSteps();
+    const PathDraws draws = makeDraws(steps);
+    ScenarioSums sums{};
 
-    return (up_price - 2.0 * center_price + down_price) / (h * h);
+    vanilla::dispatch(option.getType(), [&](const auto type) {
+        constexpr OptionType Type = decltype(type)::value;
+
+        auto accumulate = [&](const double log_return, const double weight) {
+            const double sigma_w = log_return - nu * T;
+            for (size_t k = 0; k < kNumScenarios; ++k) {
+                sums[kNumMoments + k] += weight * vanilla::intrinsic<Type>(S * simd::exp(a[k] + b[k] * sigma_w), K);
+            }
+        };
+
+        std::array<double, kPathBlock> log_return;
+        std::array<double, kPathBlock> anti_log_return;
+        std::array<double, kPathBlock> payoffs;
+        std::array<double, kPathBlock> controls;
+        double* anti = use_antithetic_ ? anti_log_return.data() : nullptr;
+
+        for (size_t begin = 0; begin < num_paths; begin += kPathBlock) {
+            const size_t count = std::min(kPathBlock, num_paths - begin);
+            evolveBlock(option, steps, draws, first_path + begin, count, log_return.data(), anti);
+            vanillaBlock<Type>(S, K, control_variate_, log_return.data(), anti,
+                               payoffs.data(), controls.data(), count);
+
+            if (anti) {
+                for (size_t j = 0; j < count; ++j) {
+                    accumulate(log_return[j], 0.5);
+                    accumulate(anti[j], 0.5);
+                }
+            } else {
+                for (size_t j = 0; j < count; ++j) {
+                    accumulate(log_return[j], 1.0);
+                }
+            }
+            addBlockMoments(sums, begin, payoffs.data(), controls.data(), count);
+        }
+    });
+
+    return sums;
+}
+
+PricingResult MonteCarloEngine::calculateAll(const OptionParameters& option) const {
+    PRICER_METRICS_TIMER(MetricsEngine::MonteCarlo);
+    if (isPathDependent(payoff_)) {
+        return bumpAndReprice(option, simulate(option), [this](const OptionParameters& bumped) {
+            return simulate(bumped).price;
+        });
+    }
+    if (option.isAmerican()) {
+        return calculateAmericanBumped(option);
+    }
+    if (greek_method_ == GreekMethod::CommonRandomNumbers) {
+        return calculateBumped(option);
+    }
+
+    const auto [sums, mean, std_error, paths] = runBatches(&MonteCarloEngine::simulateEstimators, option);
+    const double total_paths = static_cast<double>(paths);
+
+    const double r = option.getRate();
+    const double T = option.getExpiry();
+    const double discount = simd::exp(-r * T);
+    auto expectation = [&](size_t k) { return discount * sums[k] / total_paths; };
+
+    PricingResult result;
+    result.price = discount * mean;  // control-variate adjusted
+    result.std_error = discount * std_error;
+    result.paths = paths;
+    result.delta = expectation(kDeltaTerm);
+    result.gamma = expectation(kGammaTerm);
+    // The rate and expiry also move the discount factor
+    result.theta = -(expectation(kTimeTerm) - r * result.price) / 365.0;
+    result.vega = expectation(kVegaTerm) / 100.0;
+    result.rho = (expectation(kRhoTerm) - T * result.price) / 100.0;
+
+    return result;
 }
 
-    double MonteCarloEngine::calculateTheta(const Option& option) const {
-    const double h = 1.0 / 365.0;  // One day
-    double expiry = option.getExpiry();
+PricingResult MonteCarloEngine::calculateBumped(const OptionParameters& option) const {
+    const auto [sums, mean, std_error, paths] = runBatches(&MonteCarloEngine::simulateScenarios, option);
+    const double total_paths = static_cast<double>(paths);
 
-    // Backup the original expiry value
-    const_cast<Option&>(option).setExpiry(expiry + h);
-    double price_plus_h = calculate(option);
+    const double S = option.getSpot();
+    const double r = option.getRate();
+    const double T = option.getExpiry();
+    const double h_spot = kSpotBump * S;
+    const double h_time = kTimeBump;
+    const double h_time_down = T > h_time ? h_time : 0.0;
+    const double h_vol = kVolBump;
+    const double h_rate = kRateBump;
 
-    const_cast<Option&>(option).setExpiry(expiry - h);
-    double price_minus_h = calculate(option);
+    // Scenario values, each discounted with its own rate and expiry
+    auto value = [&](size_t k, double rate, double expiry) {
+        return sums[kNumMoments + k] / total_paths * simd::exp(-rate * expiry);
+    };
+    const double base = value(0, r, T);
+    const double spot_up = value(1, r, T);
+    const double spot_down = value(2, r, T);
 
-    // Restore the original expiry value
-    const_cast<Option&>(option).setExpiry(expiry);
+    // Gamma keeps the raw base value so the common random numbers cancel
+    PricingResult result;
+    result.price = mean * simd::exp(-r * T);  // control-variate adjusted
+    result.std_error = std_error * simd::exp(-r * T);
+    result.paths = paths;
+    result.delta = (spot_up - spot_down) / (2.0 * h_spot);
+    result.gamma = (spot_up - 2.0 * base + spot_down) / (h_spot * h_spot);
+    result.theta = -(value(3, r, T + h_time) - value(4, r, T - h_time_down))
+                   / (h_time + h_time_down) / 365.0;
+    result.vega = (value(5, r, T) - value(6, r, T)) / (2.0 * h_vol) / 100.0;
+    result.rho = (value(7, r + h_rate, T) - value(8, r - h_rate, T)) / (2.0 * h_rate) / 100.0;
 
-    // Central difference formula
-    return -(price_plus_h - price_minus_h) / (2.0 * h);
+    return result;
 }
 
+PricingResult MonteCarloEngine::simulateAmerican(const OptionParameters& option,
+                                                std::vector<double>* policy) const {
+    static_assert(kPathBlock <= kRowLanes);
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    const size_t num_paths = num_paths_;
+    PRICER_METRICS_ADD(MetricsEngine::MonteCarlo, MetricsCounter::Paths, num_paths);
+
+    const double S = option.getSpot();
+    const double K = option.getStrike();
+    const double r = option.getRate();
+    const double sigma = option.getVolatility();
+    const double T = option.getExpiry();
+    const double phi = option.getType() == OptionType::Call ? 1.0 : -1.0;
+    const double nu = r - option.getDividend() - 0.5 * sigma * sigma;
+    const size_t steps = std::max<size_t>(1, num_steps_);
+    const double dt = T / static_cast<double>(steps);
+    const double step_discount = simd::exp(-r * dt);
+    const double exercise_now = calculatePayoff(option, S);
+    if (num_paths == 0) {
+        PricingResult result;
+        result.price = exercise_now;
+        return result;
+    }
+
+    // Lane-major per-path state. Antithetic paths are a second lane in the
+    // regression; they mirror the Brownian motion, which is stored once.
+    const size_t lanes = use_antithetic_ ? 2 : 1;
+    std::vector<double> brownian(num_paths);
+    std::vector<double> spot(lanes * num_paths);
+    std::vector<double> cash_flow(lanes * num_paths);  // discounted to the current date
+    std::vector<double> control(lanes * num_paths);
+
+    using Regression = std::array<double, kPowers + kBasis>;
+    const size_t chunks = (num_paths + kChunkPaths - 1) / kChunkPaths;
+    std::vector<Regression> partial(chunks);
+    const CounterBasedRng rng(random_generator_, seed_);
 
-double MonteCarloEngine::calculateVega(const Option& option) const {
-    const double h = 0.0001;
-    double vol = option.getVolatility();
+    // Expiry: draw W_T, which is dimension 0 of every stream
+    pool.parallelFor(chunks, [&](const size_t c) {
+        const size_t chunk_end = std::min(num_paths, (c + 1) * kChunkPaths);
+        for (size_t begin = c * kChunkPaths; begin < chunk_end; begin += kPathBlock) {
+            const size_t count = std::min(kPathBlock, chunk_end - begin);
+            rng.normals(begin, 0, std::span<double>(brownian.data() + begin, count));
+            for (size_t j = 0; j < count; ++j) {
+                brownian[begin + j] *= std::sqrt(T);
+            }
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                const double sign = lane == 0 ? 1.0 : -1.0;
+                for (size_t j = begin; j < begin + count; ++j) {
+                    const double terminal = S * simd::exp(nu * T + sign * sigma * brownian[j]);
+                    spot[lane * num_paths + j] = terminal;
+                    cash_flow[lane * num_paths + j] = calculatePayoff(option, terminal);
+                    control[lane * num_paths + j] = controlPayoff(option, terminal);
+                }
+            }
+        }
+    }, num_threads_);
+
+    // Earlier dates, one pass each: exercise at t_{k+1} with its fitted
+    // continuation, discount to t_k, bridge W back to t_k and sum the
+    // regression terms there. W(t_k) given W(t_{k+1}) is normal with mean
+    // k / (k + 1) W(t_{k+1}) and variance dt k / (k + 1).
+    // A given policy holds the coefficients of dates steps - 1 ... 1
+    const bool fitting = !policy || policy->size() != (steps - 1) * kBasis;
+    if (policy && fitting) {
+        policy->assign((steps - 1) * kBasis, 0.0);
+    }
+    std::array<double, kBasis> coefficients{};
+    for (size_t step = steps; step-- > 0;) {
+        async::checkpoint();
+        const double* exercise = nullptr;
+        if (step + 1 < steps) {
+            exercise = fitting ? coefficients.data() : policy->data() + (steps - step - 2) * kBasis;
+        }
+        const double k = static_cast<double>(step);
+        const double shrink = k / (k + 1.0);
+        const double spread = std::sqrt(dt * shrink);
+
+        pool.parallelFor(chunks, [&](const size_t c) {
+            const size_t chunk_end = std::min(num_paths, (c + 1) * kChunkPaths);
+            RegressionRows rows;
+            std::array<double, kPathBlock> z;
+
+            for (size_t begin = c * kChunkPaths; begin < chunk_end; begin += kPathBlock) {
+                const size_t count = std::min(kPathBlock, chunk_end - begin);
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    exerciseRow(spot.data() + lane * num_paths + begin, cash_flow.data() + lane * num_paths + begin,
+                                K, phi, exercise, step_discount, count);
+                }
+                if (step == 0) {
+                    continue;
+                }
+
+                rng.normals(begin, steps - step, std::span<double>(z.data(), count));
+                double* w = brownian.data() + begin;
+                for (size_t j = 0; j < count; ++j) {
+                    w[j] = shrink * w[j] + spread * z[j];
+                }
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    regressionRow(w, lane == 0 ? 1.0 : -1.0, S, nu * k * dt, sigma, K, phi,
+                                  spot.data() + lane * num_paths + begin,
+                                  cash_flow.data() + lane * num_paths + begin, rows, count);
+                }
+            }
+
+            Regression sums{};
+            for (size_t p = 0; p < kPowers; ++p) {
+                for (size_t j = 0; j < kPathBlock; ++j) {
+                    sums[p] += rows.power[p][j];
+                }
+            }
+            for (size_t b = 0; b < kBasis; ++b) {
+                for (size_t j = 0; j < kPathBlock; ++j) {
+                    sums[kPowers + b] += rows.flow[b][j];
+                }
+            }
+            partial[c] = sums;
+        }, num_threads_);
+        async::report({static_cast<double>(steps - step) / static_cast<double>(steps), false, {}});
+
+        if (step == 0 || !fitting) {
+            continue;
+        }
+
+        Regression total{};
+        for (const Regression& sums : partial) {
+            for (size_t i = 0; i < total.size(); ++i) {
+                total[i] += sums[i];
+            }
+        }
+        std::array<double, kBasis * kBasis> gram;
+        std::array<double, kBasis> rhs;
+        for (size_t a = 0; a < kBasis; ++a) {
+            for (size_t b = 0; b < kBasis; ++b) {
+                gram[a * kBasis + b] = total[a + b];
+            }
+            rhs[a] = total[kPowers + a];
+        }
+        coefficients = solveNormalEquations<kBasis>(gram, rhs);
+        if (policy) {
+            std::copy(coefficients.begin(), coefficients.end(), policy->data() + (steps - step - 1) * kBasis);
+        }
+    }
+
+    // Antithetic lanes are averaged per path, as in the European kernels
+    MomentSums sums{};
+    std::array<double, kPathBlock> payoffs;
+    std::array<double, kPathBlock> controls;
+    for (size_t begin = 0; begin < num_paths; begin += kPathBlock) {
+        const size_t count = std::min(kPathBlock, num_paths - begin);
+        for (size_t j = 0; j < count; ++j) {
+            payoffs[j] = 0.0;
+            controls[j] = 0.0;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                payoffs[j] += cash_flow[lane * num_paths + begin + j] / static_cast<double>(lanes);
+                controls[j] += control[lane * num_paths + begin + j] / static_cast<double>(lanes);
+            }
+        }
+        addBlockMoments(sums, begin, payoffs.data(), controls.data(), count);
+    }
 
-    const_cast<Option&>(option).setVolatility(vol + h);
-    double up_price = calculate(option);
+    // The control stays undiscounted; beta absorbs the scale
+    const auto [beta, mean, std_error] = controlledMean(sums, num_paths, controlMean(option));
 
-    const_cast<Option&>(option).setVolatility(vol - h);
-    double down_price = calculate(option);
+    PRICER_TRACE(kTraceName, "Total Paths", static_cast<double>(num_paths));
+    PRICER_TRACE(kTraceName, "Exercise Dates", static_cast<double>(steps));
+    PRICER_TRACE(kTraceName, "Control Coefficient", beta);
+    PRICER_TRACE(kTraceName, "Continuation Value", mean);
+    PRICER_TRACE(kTraceName, "Standard Error", std_error);
+
+    // Exercising today is known exactly
+    PricingResult result;
+    result.paths = num_paths;
+    if (exercise_now > mean) {
+        result.price = exercise_now;
+    } else {
+        result.price = mean;
+        result.std_error = std_error;
+    }
+    return result;
+}
 
-    const_cast<Option&>(option).setVolatility(vol);
+PricingResult MonteCarloEngine::calculateAmericanBumped(const OptionParameters& option) const {
+    // The bumped runs reuse the base run's exercise policy, so the
+    // differences see the paths move, not the regression noise
+    std::vector<double> policy;
+    PricingResult result = simulateAmerican(option, &policy);
+    return bumpAndReprice(option, result, [&](const OptionParameters& bumped) {
+        return simulateAmerican(bumped, &policy).price;
+    });
+}
 
-    return (up_price - down_price) / (2.0 * h);
+std::pair<double, double> MonteCarloEngine::getConfidenceInterval(const OptionParameters& option) const {
+    // 95% confidence interval (1.96 standard errors)
+    return simulate(option).confidenceInterval(1.96);
 }
 
-double MonteCarloEngine::calculateRho(const Option& option) const {
-    const double h = 0.0001;
-    double rate = option.getRate();
+double MonteCarloEngine::calculateDelta(const OptionParameters& option) const {
+    return calculateAll(option).delta;
+}
 
-    const_cast<Option&>(option).setRate(rate + h);
-    double up_price = calculate(option);
+double MonteCarloEngine::calculateGamma(const OptionParameters& option) const {
+    return calculateAll(option).gamma;
+}
 
-    const_cast<Option&>(option).setRate(rate - h);
-    double down_price = calculate(option);
+double MonteCarloEngine::calculateTheta(const OptionParameters& option) const {
+    return calculateAll(option).theta;
+}
 
-    const_cast<Option&>(option).setRate(rate);
+double MonteCarloEngine::calculateVega(const OptionParameters& option) const {
+    return calculateAll(option).vega;
+}
 
-    return (up_price - down_price) / (2.0 * h);
+double MonteCarloEngine::calculateRho(const OptionParameters& option) const {
+    return calculateAll(option).rho;
 }
 
-} // namespace pricer
\ No newline at end of file
+} // namespace pricer
@@ -0,0 +1,63 @@
+#include "pricer/normal.h"
+#include "vector_math.h"
+#include <stdexcept>
+
+namespace pricer {
+
+namespace {
+    void checkLengths(const std::size_t in, const std::size_t out) {
+        if (in != out) {
+            throw std::invalid_argument("Input and output must have the same length");
+        }
+    }
+
+    PRICER_SIMD_CLONES
+    void cdfChain(const double* x, double* out, const std::size_t n, const NormalAccuracy accuracy) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = simd::normalCDF(x[i], accuracy);
+        }
+    }
+
+    PRICER_SIMD_CLONES
+    void pdfChain(const double* x, double* out, const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = simd::normalPDF(x[i]);
+        }
+    }
+
+    PRICER_SIMD_CLONES
+    void inverseChain(const double* p, double* out, const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = simd::inverseNormalCDF(p[i]);
+        }
+    }
+}
+
+double normalCDF(const double x, const NormalAccuracy accuracy) {
+    return simd::normalCDF(x, accuracy);
+}
+
+double normalPDF(const double x) {
+    return simd::normalPDF(x);
+}
+
+double inverseNormalCDF(const double p) {
+    return simd::inverseNormalCDF(p);
+}
+
+void normalCDF(const std::span<const double> x, const std::span<double> out, const NormalAccuracy accuracy) {
+    checkLengths(x.size(), out.size());
+    cdfChain(x.data(), out.data(), x.size(), accuracy);
+}
+
+void normalPDF(const std::span<const double> x, const std::span<double> out) {
+    checkLengths(x.size(), out.size());
+    pdfChain(x.data(), out.data(), x.size());
+}
+
+void inverseNormalCDF(const std::span<const double> p, const std::span<double> out) {
+    checkLengths(p.size(), out.size());
+    inverseChain(p.data(), out.data(), p.size());
+}
+
+} // namespace pricer
@@ -5,6 +5,69 @@
 
 namespace pricer {
 
+namespace {
+    ContractSpec withExercise(ContractSpec contract, const ExerciseStyle exercise) {
+        contract.exercise = exercise;
+        return contract;
+    }
+}
+
+OptionParameters::OptionParameters(const OptionType type,
+                                   const double strike,
+                                   const double expiry,
+                                   const double spot,
+                                   const double rate,
+                                   const double volatility,
+                                   const double dividend,
+                                   const ExerciseStyle exercise)
+    : OptionParameters(ContractSpec{strike, expiry, type, exercise},
+                       MarketState{spot, rate, volatility, dividend})
+{
+}
+
+OptionParameters::OptionParameters(const ContractSpec& contract, const MarketState& market)
+    : contract_(contract)
+    , market_(market)
+{
+    validate(contract_, market_);
+}
+
+OptionParameters::OptionParameters(const Option& option)
+    : contract_(option.contract())
+    , market_(option.market())
+{
+}
+
+OptionParameters OptionParameters::withSpot(const double spot) const {
+    MarketState market = market_;
+    market.spot = spot;
+    return {contract_, market};
+}
+
+OptionParameters OptionParameters::withRate(const double rate) const {
+    MarketState market = market_;
+    market.rate = rate;
+    return {contract_, market};
+}
+
+OptionParameters OptionParameters::withVolatility(const double volatility) const {
+    MarketState market = market_;
+    market.volatility = volatility;
+    return {contract_, market};
+}
+
+OptionParameters OptionParameters::withDividend(const double dividend) const {
+    MarketState market = market_;
+    market.dividend = dividend;
+    return {contract_, market};
+}
+
+OptionParameters OptionParameters::withExpiry(const double expiry) const {
+    ContractSpec contract = contract_;
+    contract.expiry = expiry;
+    return {contract, market_};
+}
+
 Option::Option(const OptionType type,
                const double strike,
                const double expiry,
@@ -12,13 +75,14 @@ Option::Option(const OptionType type,
                const double rate,
                const double volatility,
                const double dividend)
-    : type_(type)
-    , strike_(strike)
-    , expiry_(expiry)
-    , spot_(spot)
-    , rate_(rate)
-    , volatility_(volatility)
-    , dividend_(dividend)
+    : Option(ContractSpec{strike, expiry, type, ExerciseStyle::European},
+             MarketState{spot, rate, volatility, dividend})
+{
+}
+
+Option::Option(const ContractSpec& contract, const MarketState& market)
+    : contract_(contract)
+    , market_(market)
     , engine_(nullptr)
 {
     validateParameters();
@@ -32,32 +96,37 @@ void Option::checkEngine() const {
 
 double Option::price() const {
     checkEngine();
-    return engine_->calculate(*this);
+    return engine_->calculate(parameters());
 }
 
 double Option::delta() const {
     checkEngine();
-    return engine_->calculateDelta(*this);
+    return engine_->calculateDelta(parameters());
 }
 
 double Option::gamma() const {
     checkEngine();
-    return engine_->calculateGamma(*this);
+    return engine_->calculateGamma(parameters());
 }
 
 double Option::theta() const {
     checkEngine();
-    return engine_->calculateTheta(*this);
+    return engine_->calculateTheta(parameters());
 }
 
 double Option::vega() const {
     checkEngine();
-    return engine_->calculateVega(*this);
+    return engine_->calculateVega(parameters());
 }
 
 double Option::rho() const {
     checkEngine();
-    return engine_->calculateRho(*this);
+    return engine_->calculateRho(parameters());
+}
+
+PricingResult Option::calculateAll() const {
+    checkEngine();
+    return engine_->calculateAll(parameters());
 }
 
 void Option::setPricingEngine(std::shared_ptr<PricingEngine> engine) {
@@ -65,51 +134,70 @@ void Option::setPricingEngine(std::shared_ptr<PricingEngine> engine) {
 }
 
 void Option::setSpot(const double spot) {
-    spot_ = spot;
+    market_.spot = spot;
     validateParameters();
 }
 
 void Option::setRate(const double rate) {
-    rate_ = rate;
+    market_.rate = rate;
     validateParameters();
 }
 
 void Option::setVolatility(const double volatility) {
-    volatility_ = volatility;
+    market_.volatility = volatility;
     validateParameters();
 }
 
 void Option::setDividend(const double dividend) {
-    dividend_ = dividend;
+    market_.dividend = dividend;
     validateParameters();
 }
 
 void Option::setExpiry(const double expiry) {
-    expiry_ = expiry;
+    contract_.expiry = expiry;
     validateParameters();
 }
 
 void Option::validateParameters() const {
-    if (strike_ <= 0.0) {
-        throw std::invalid_argument("Strike price must be positive");
-    }
-    if (expiry_ <= 0.0) {
-        throw std::invalid_argument("Time to expiry must be positive");
-    }
-    if (spot_ <= 0.0) {
-        throw std::invalid_argument("Spot price must be positive");
-    }
-    if (volatility_ <= 0.0) {
-        throw std::invalid_argument("Volatility must be positive");
-    }
-    if (dividend_ < 0.0) {
-        throw std::invalid_argument("Dividend yield cannot be negative");
-    }
+    validate(contract_, market_);
+}
+
+EuropeanOption::EuropeanOption(const OptionType type,
+                               const double strike,
+                               const double expiry,
+                               const double spot,
+                               const double rate,
+                               const double volatility,
+                               const double dividend)
+    : Option(type, strike, expiry, spot, rate, volatility, dividend)
+{
+}
+
+EuropeanOption::EuropeanOption(const ContractSpec contract, const MarketState& market)
+    : Option(withExercise(contract, ExerciseStyle::European), market)
+{
+}
+
+AmericanOption::AmericanOption(const OptionType type,
+                               const double strike,
+                               const double expiry,
+                               const double spot,
+                               const double rate,
+                               const double volatility,
+                               const double dividend)
+    : Option(ContractSpec{strike, expiry, type, ExerciseStyle::American},
+             MarketState{spot, rate, volatility, dividend})
+{
+}
+
+AmericanOption::AmericanOption(const ContractSpec contract, const MarketState& market)
+    : Option(withExercise(contract, ExerciseStyle::American), market)
+{
 }
 
 double AmericanOption::price() const {
     checkEngine();
-    return engine_->calculate(*this);
+    return engine_->calculate(parameters());
 }
 
 } // namespace pricer
\ No newline at end of file
@@ -0,0 +1,214 @@
+//
+// Streaming block kernels of the path-dependent Monte Carlo payoffs.
+//
+
+#ifndef OPTIONS_PRICER_PATH_PAYOFF_H
+#define OPTIONS_PRICER_PATH_PAYOFF_H
+
+#include "pricer/contract.h"
+#include "pricer/payoff.h"
+#include "vector_math.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace pricer::path {
+
+// Paths a kernel tracks at once; matches MonteCarloEngine's path block
+inline constexpr std::size_t kBlock = 64;
+
+/**
+ * @brief What a kernel sees of the contract and the monitoring dates
+ */
+struct Grid {
+    OptionType type;
+    double strike;
+    double volatility;
+    double dt;          ///< Time between monitoring dates
+    std::size_t dates;  ///< Monitoring dates after today
+};
+
+/**
+ * @brief Compile-time interface of a payoff over a block of paths
+ *
+ * A kernel keeps a running state per path of the block instead of the
+ * paths themselves. The engine calls start once per block, observe once
+ * per monitoring date with the log-spots before and after the step, and
+ * settle at expiry. Derived kernels implement startBlock, observeStep and
+ * settleBlock as plain loops over the block so the calls inline into the
+ * engine's time-step loop and vectorize.
+ */
+template <typename Derived>
+class PathKernel {
+public:
+    void start(const double log_spot, const Grid& grid, const std::size_t count) {
+        grid_ = grid;
+        phi_ = grid.type == OptionType::Call ? 1.0 : -1.0;
+        derived().startBlock(log_spot, count);
+    }
+
+    void observe(const double* previous, const double* current, const std::size_t count) {
+        derived().observeStep(previous, current, count);
+    }
+
+    // Undiscounted payoff of each path, from the log-spots at expiry
+    void settle(const double* terminal, double* payoff, const std::size_t count) const {
+        derived().settleBlock(terminal, payoff, count);
+    }
+
+protected:
+    // max(phi (value - K), 0) for the contract's type and strike
+    [[nodiscard]] double vanilla(const double value) const {
+        return std::max(phi_ * (value - grid_.strike), 0.0);
+    }
+
+    Grid grid_{};
+    double phi_ = 1.0;
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+};
+
+class VanillaKernel : public PathKernel<VanillaKernel> {
+public:
+    explicit VanillaKernel(const VanillaPayoff&) {}
+
+    void startBlock(double, std::size_t) {}
+    void observeStep(const double*, const double*, std::size_t) {}
+
+    void settleBlock(const double* terminal, double* payoff, const std::size_t count) const {
+        for (std::size_t j = 0; j < count; ++j) {
+            payoff[j] = vanilla(simd::exp(terminal[j]));
+        }
+    }
+};
+
+class AsianKernel : public PathKernel<AsianKernel> {
+public:
+    explicit AsianKernel(const AsianPayoff& payoff)
+        : geometric_(payoff.averaging == AsianAveraging::Geometric) {}
+
+    void startBlock(double, const std::size_t count) {
+        std::fill_n(sum_.begin(), count, 0.0);
+    }
+
+    // Arithmetic averages sum the spots, geometric ones the log-spots
+    void observeStep(const double*, const double* current, const std::size_t count) {
+        if (geometric_) {
+            for (std::size_t j = 0; j < count; ++j) {
+                sum_[j] += current[j];
+            }
+        } else {
+            for (std::size_t j = 0; j < count; ++j) {
+                sum_[j] += simd::exp(current[j]);
+            }
+        }
+    }
+
+    void settleBlock(const double*, double* payoff, const std::size_t count) const {
+        const double dates = static_cast<double>(grid_.dates);
+        for (std::size_t j = 0; j < count; ++j) {
+            const double average = geometric_ ? simd::exp(sum_[j] / dates) : sum_[j] / dates;
+            payoff[j] = vanilla(average);
+        }
+    }
+
+private:
+    bool geometric_;
+    std::array<double, kBlock> sum_;
+};
+
+class BarrierKernel : public PathKernel<BarrierKernel> {
+public:
+    explicit BarrierKernel(const BarrierPayoff& payoff)
+        : log_barrier_(std::log(payoff.barrier))
+        , side_(payoff.type == BarrierType::UpAndOut || payoff.type == BarrierType::UpAndIn ? 1.0 : -1.0)
+        , knock_out_(payoff.type == BarrierType::UpAndOut || payoff.type == BarrierType::DownAndOut)
+        , rebate_(payoff.rebate)
+        , bridge_correction_(payoff.bridge_correction) {}
+
+    // A spot already on the far side of the barrier has touched it
+    void startBlock(const double log_spot, const std::size_t count) {
+        std::fill_n(alive_.begin(), count, side_ * (log_barrier_ - log_spot) > 0.0 ? 1.0 : 0.0);
+    }
+
+    // Between two spots on the near side, the bridge touches the barrier with
+    // probability exp(-2 d_0 d_1 / (sigma^2 dt)) for log-distances d_0 and d_1
+    void observeStep(const double* previous, const double* current, const std::size_t count) {
+        const double scale = bridge_correction_ ? -2.0 / (grid_.volatility * grid_.volatility * grid_.dt) : 0.0;
+        for (std::size_t j = 0; j < count; ++j) {
+            const double before = side_ * (log_barrier_ - previous[j]);
+            const double after = side_ * (log_barrier_ - current[j]);
+            const double touched = bridge_correction_ ? simd::exp(scale * before * after) : 0.0;
+            alive_[j] *= after > 0.0 ? 1.0 - touched : 0.0;
+        }
+    }
+
+    void settleBlock(const double* terminal, double* payoff, const std::size_t count) const {
+        for (std::size_t j = 0; j < count; ++j) {
+            const double active = knock_out_ ? alive_[j] : 1.0 - alive_[j];
+            payoff[j] = active * vanilla(simd::exp(terminal[j])) + (1.0 - active) * rebate_;
+        }
+    }
+
+private:
+    double log_barrier_;
+    double side_;  // +1 for a barrier above the spot, -1 below
+    bool knock_out_;
+    double rebate_;
+    bool bridge_correction_;
+    std::array<double, kBlock> alive_;  // probability of not having touched the barrier
+};
+
+class LookbackKernel : public PathKernel<LookbackKernel> {
+public:
+    explicit LookbackKernel(const LookbackPayoff& payoff)
+        : floating_(payoff.strike == LookbackStrike::Floating)
+        , continuity_correction_(payoff.continuity_correction) {}
+
+    void startBlock(const double log_spot, const std::size_t count) {
+        std::fill_n(high_.begin(), count, log_spot);
+        std::fill_n(low_.begin(), count, log_spot);
+    }
+
+    void observeStep(const double*, const double* current, const std::size_t count) {
+        for (std::size_t j = 0; j < count; ++j) {
+            high_[j] = std::max(high_[j], current[j]);
+            low_[j] = std::min(low_[j], current[j]);
+        }
+    }
+
+    void settleBlock(const double* terminal, double* payoff, const std::size_t count) const {
+        constexpr double kBeta = 0.5826;  // -zeta(1/2) / sqrt(2 pi)
+        const double shift = continuity_correction_ ? kBeta * grid_.volatility * std::sqrt(grid_.dt) : 0.0;
+        const bool call = phi_ > 0.0;
+        for (std::size_t j = 0; j < count; ++j) {
+            const double high = simd::exp(high_[j] + shift);
+            const double low = simd::exp(low_[j] - shift);
+            const double spot = simd::exp(terminal[j]);
+            if (floating_) {
+                payoff[j] = call ? spot - low : high - spot;
+            } else {
+                payoff[j] = vanilla(call ? high : low);
+            }
+        }
+    }
+
+private:
+    bool floating_;
+    bool continuity_correction_;
+    std::array<double, kBlock> high_;  // running max and min of the log-spot
+    std::array<double, kBlock> low_;
+};
+
+// Kernel of each payoff, chosen at compile time
+inline VanillaKernel makeKernel(const VanillaPayoff& payoff) { return VanillaKernel(payoff); }
+inline AsianKernel makeKernel(const AsianPayoff& payoff) { return AsianKernel(payoff); }
+inline BarrierKernel makeKernel(const BarrierPayoff& payoff) { return BarrierKernel(payoff); }
+inline LookbackKernel makeKernel(const LookbackPayoff& payoff) { return LookbackKernel(payoff); }
+
+} // namespace pricer::path
+
+#endif // OPTIONS_PRICER_PATH_PAYOFF_H
@@ -0,0 +1,112 @@
+#include "pricer/portfolio.h"
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+
+namespace pricer {
+
+std::size_t Portfolio::add(const ContractSpec& contract,
+                           const MarketState& market,
+                           const double quantity,
+                           std::shared_ptr<const PricingEngine> engine) {
+    if (!engine) {
+        throw std::invalid_argument("Position needs a pricing engine");
+    }
+
+    // Books use a handful of engines, so a linear search is enough
+    auto group = std::find_if(groups_.begin(), groups_.end(),
+                              [&](const EngineGroup& g) { return g.engine == engine; });
+    if (group == groups_.end()) {
+        groups_.push_back({std::move(engine), {}, {}});
+        group = groups_.end() - 1;
+    }
+
+    group->contracts.add(contract, market);
+
+    const std::size_t position = slots_.size();
+    group->positions.push_back(position);
+    slots_.push_back({static_cast<std::size_t>(group - groups_.begin()), group->contracts.size() - 1});
+    quantities_.push_back(quantity);
+    return position;
+}
+
+void Portfolio::reserve(const std::size_t positions) {
+    slots_.reserve(positions);
+    quantities_.reserve(positions);
+}
+
+ContractSpec Portfolio::contract(const std::size_t position) const {
+    const Slot& slot = slots_[position];
+    return groups_[slot.group].contracts.contract(slot.index);
+}
+
+MarketState Portfolio::market(const std::size_t position) const {
+    const Slot& slot = slots_[position];
+    return groups_[slot.group].contracts.market(slot.index);
+}
+
+const PricingEngine& Portfolio::engine(const std::size_t position) const {
+    return *groups_[slots_[position].group].engine;
+}
+
+PortfolioPricer::PortfolioPricer(std::shared_ptr<ThreadPool> pool)
+    : thread_pool_(std::move(pool)) {
+}
+
+void PortfolioPricer::setChunkSize(const std::size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+    chunk_size_ = size;
+}
+
+PortfolioResult PortfolioPricer::price(const Portfolio& portfolio) const {
+    const auto& groups = portfolio.groups();
+
+    struct Task {
+        std::size_t group;
+        std::size_t begin;
+        std::size_t count;
+    };
+
+    std::vector<Task> tasks;
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        const std::size_t n = groups[g].contracts.size();
+        for (std::size_t begin = 0; begin < n; begin += chunk_size_) {
+            tasks.push_back({g, begin, std::min(chunk_size_, n - begin)});
+        }
+    }
+
+    PortfolioResult result;
+    result.positions.resize(portfolio.size());
+
+    // Each task evaluates its chunk into scratch and scatters it to position order
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    pool.parallelFor(tasks.size(), [&](const std::size_t t) {
+        thread_local std::vector<PricingResult> scratch;
+        const Task& task = tasks[t];
+        const auto& group = groups[task.group];
+
+        scratch.resize(task.count);
+        group.engine->calculateAllBatch(group.contracts, task.begin, scratch);
+        for (std::size_t i = 0; i < task.count; ++i) {
+            result.positions[group.positions[task.begin + i]] = scratch[i];
+        }
+    });
+
+    PricingResult& total = result.total;
+    for (std::size_t p = 0; p < result.positions.size(); ++p) {
+        const PricingResult& unit = result.positions[p];
+        const double q = portfolio.quantity(p);
+        total.price += q * unit.price;
+        total.delta += q * unit.delta;
+        total.gamma += q * unit.gamma;
+        total.theta += q * unit.theta;
+        total.vega += q * unit.vega;
+        total.rho += q * unit.rho;
+    }
+
+    return result;
+}
+
+} // namespace pricer
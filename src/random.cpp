@@ -0,0 +1,133 @@
+#include "pricer/random.h"
+#include "vector_math.h"
+#include <bit>
+#include <cmath>
+
+namespace pricer {
+
+namespace {
+    constexpr std::uint32_t kPhiloxM0 = 0xD2511F53;
+    constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57;
+    constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9;  // golden ratio
+    constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85;  // sqrt(3) - 1
+
+    constexpr std::uint64_t kSkeinParity = 0x1BD11BDAA9FC1A22ULL;
+    constexpr int kThreefryRotations[8] = {16, 42, 12, 31, 16, 32, 24, 21};
+
+    // Stream s, draw d use counter (d, s); 64 of the 128 output bits are used
+    inline std::uint64_t philoxBits(const std::uint64_t seed, const std::uint64_t stream,
+                                    const std::uint64_t draw) {
+        std::uint32_t c0 = static_cast<std::uint32_t>(draw);
+        std::uint32_t c1 = static_cast<std::uint32_t>(draw >> 32);
+        std::uint32_t c2 = static_cast<std::uint32_t>(stream);
+        std::uint32_t c3 = static_cast<std::uint32_t>(stream >> 32);
+        std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+        std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+
+#pragma GCC unroll 10
+        for (int round = 0; round < 10; ++round) {
+            const std::uint64_t p0 = static_cast<std::uint64_t>(kPhiloxM0) * c0;
+            const std::uint64_t p1 = static_cast<std::uint64_t>(kPhiloxM1) * c2;
+            c0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<std::uint32_t>(p1);
+            c2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<std::uint32_t>(p0);
+            k0 += kPhiloxW0;
+            k1 += kPhiloxW1;
+        }
+
+        return (static_cast<std::uint64_t>(c0) << 32) | c1;
+    }
+
+    inline std::array<std::uint64_t, 2> threefryBlock(std::uint64_t x0, std::uint64_t x1,
+                                                      const std::uint64_t k0, const std::uint64_t k1) {
+        const std::uint64_t ks[3] = {k0, k1, kSkeinParity ^ k0 ^ k1};
+        x0 += ks[0];
+        x1 += ks[1];
+
+#pragma GCC unroll 20
+        for (int round = 0; round < 20; ++round) {
+            x0 += x1;
+            x1 = std::rotl(x1, kThreefryRotations[round % 8]);
+            x1 ^= x0;
+
+            // Key injection after every fourth round
+            if (round % 4 == 3) {
+                const std::uint64_t s = static_cast<std::uint64_t>(round / 4 + 1);
+                x0 += ks[s % 3];
+                x1 += ks[(s + 1) % 3] + s;
+            }
+        }
+
+        return {x0, x1};
+    }
+
+    inline std::uint64_t threefryBits(const std::uint64_t seed, const std::uint64_t stream,
+                                      const std::uint64_t draw) {
+        return threefryBlock(draw, stream, seed, 0)[0];
+    }
+
+    // Top 52 bits to the midpoint of a 2^-52 cell, so the result is in (0, 1)
+    inline double toUniform(const std::uint64_t bits) {
+        const double mantissa = std::bit_cast<double>((bits >> 12) | 0x4330000000000000ULL)
+                                - 4503599627370496.0;
+        return (mantissa + 0.5) * 0x1.0p-52;
+    }
+
+    PRICER_SIMD_CLONES
+    void philoxNormals(const std::uint64_t seed, const std::uint64_t first_stream,
+                       const std::uint64_t draw, double* out, const std::size_t n) {
+        for (std::size_t j = 0; j < n; ++j) {
+            out[j] = simd::inverseNormalCDF(toUniform(philoxBits(seed, first_stream + j, draw)));
+        }
+    }
+
+    PRICER_SIMD_CLONES
+    void threefryNormals(const std::uint64_t seed, const std::uint64_t first_stream,
+                         const std::uint64_t draw, double* out, const std::size_t n) {
+        for (std::size_t j = 0; j < n; ++j) {
+            out[j] = simd::inverseNormalCDF(toUniform(threefryBits(seed, first_stream + j, draw)));
+        }
+    }
+}
+
+std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter,
+                                        std::array<std::uint32_t, 2> key) {
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(kPhiloxM0) * counter[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(kPhiloxM1) * counter[2];
+        counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                   static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                   static_cast<std::uint32_t>(p0)};
+        key[0] += kPhiloxW0;
+        key[1] += kPhiloxW1;
+    }
+    return counter;
+}
+
+std::array<std::uint64_t, 2> threefry2x64(const std::array<std::uint64_t, 2> counter,
+                                          const std::array<std::uint64_t, 2> key) {
+    return threefryBlock(counter[0], counter[1], key[0], key[1]);
+}
+
+double CounterBasedRng::uniform(const std::uint64_t stream, const std::uint64_t draw) const {
+    return toUniform(generator_ == RandomGenerator::Philox4x32
+                         ? philoxBits(seed_, stream, draw)
+                         : threefryBits(seed_, stream, draw));
+}
+
+double CounterBasedRng::normal(const std::uint64_t stream, const std::uint64_t draw) const {
+    return simd::inverseNormalCDF(uniform(stream, draw));
+}
+
+void CounterBasedRng::normals(const std::uint64_t first_stream, const std::uint64_t draw,
+                              const std::span<double> out) const {
+    if (generator_ == RandomGenerator::Philox4x32) {
+        philoxNormals(seed_, first_stream, draw, out.data(), out.size());
+    } else {
+        threefryNormals(seed_, first_stream, draw, out.data(), out.size());
+    }
+}
+
+} // namespace pricer
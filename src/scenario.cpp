@@ -0,0 +1,144 @@
+#include "pricer/scenario.h"
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+
+namespace pricer {
+
+namespace {
+
+std::vector<double> evenShifts(const double range, const std::size_t points) {
+    if (points == 0) {
+        throw std::invalid_argument("A scenario ladder needs at least one point");
+    }
+    if (!(range >= 0.0)) {
+        throw std::invalid_argument("Scenario range must be non-negative");
+    }
+    if (points == 1) {
+        return {0.0};
+    }
+
+    std::vector<double> shifts(points);
+    const double step = 2.0 * range / static_cast<double>(points - 1);
+    for (std::size_t i = 0; i < points; ++i) {
+        shifts[i] = -range + step * static_cast<double>(i);
+    }
+    // Odd ladders hit zero exactly, so the centre reprices the book as it is
+    if (points % 2 == 1) {
+        shifts[points / 2] = 0.0;
+    }
+    return shifts;
+}
+
+} // namespace
+
+ScenarioGrid ScenarioGrid::ladder(const double spot_range,
+                                  const std::size_t spot_points,
+                                  const double volatility_range,
+                                  const std::size_t volatility_points) {
+    return {evenShifts(spot_range, spot_points), evenShifts(volatility_range, volatility_points)};
+}
+
+ScenarioPricer::ScenarioPricer(std::shared_ptr<ThreadPool> pool)
+    : thread_pool_(std::move(pool)) {
+}
+
+void ScenarioPricer::setChunkSize(const std::size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+    chunk_size_ = size;
+}
+
+ScenarioCube ScenarioPricer::price(const Portfolio& portfolio,
+                                   const ScenarioGrid& grid,
+                                   const bool greeks) const {
+    const std::size_t scenarios = grid.size();
+    if (scenarios == 0) {
+        throw std::invalid_argument("Scenario grid must not be empty");
+    }
+
+    ScenarioCube cube;
+    cube.positions = portfolio.size();
+    cube.spot_points = grid.spot_shifts.size();
+    cube.volatility_points = grid.volatility_shifts.size();
+    cube.prices.resize(cube.positions * scenarios);
+    if (greeks) {
+        cube.results.resize(cube.positions * scenarios);
+    }
+
+    const auto& groups = portfolio.groups();
+
+    struct Task {
+        std::size_t group;
+        std::size_t begin;
+        std::size_t count;
+    };
+
+    // Whole positions per task, so each task fills contiguous slabs of the cube
+    const std::size_t per_task = std::max<std::size_t>(1, chunk_size_ / scenarios);
+    std::vector<Task> tasks;
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        const std::size_t n = groups[g].contracts.size();
+        for (std::size_t begin = 0; begin < n; begin += per_task) {
+            tasks.push_back({g, begin, std::min(per_task, n - begin)});
+        }
+    }
+
+    ThreadPool& pool = thread_pool_ ? *thread_pool_ : ThreadPool::global();
+    pool.parallelFor(tasks.size(), [&](const std::size_t t) {
+        thread_local ContractBatch shifted;
+        thread_local std::vector<double> prices;
+        thread_local std::vector<PricingResult> results;
+        const Task& task = tasks[t];
+        const auto& group = groups[task.group];
+
+        shifted.clear();
+        shifted.reserve(task.count * scenarios);
+        for (std::size_t i = task.begin; i < task.begin + task.count; ++i) {
+            const ContractSpec contract = group.contracts.contract(i);
+            const MarketState market = group.contracts.market(i);
+            for (const double spot_shift : grid.spot_shifts) {
+                MarketState bumped = market;
+                bumped.spot = market.spot * (1.0 + spot_shift);
+                for (const double volatility_shift : grid.volatility_shifts) {
+                    bumped.volatility = market.volatility + volatility_shift;
+                    shifted.add(contract, bumped);
+                }
+            }
+        }
+
+        if (greeks) {
+            results.resize(shifted.size());
+            group.engine->calculateAllBatch(shifted, 0, results);
+        } else {
+            prices.resize(shifted.size());
+            group.engine->priceBatch(shifted, prices);
+        }
+
+        for (std::size_t i = 0; i < task.count; ++i) {
+            const std::size_t slab = group.positions[task.begin + i] * scenarios;
+            for (std::size_t k = 0; k < scenarios; ++k) {
+                if (greeks) {
+                    cube.results[slab + k] = results[i * scenarios + k];
+                    cube.prices[slab + k] = results[i * scenarios + k].price;
+                } else {
+                    cube.prices[slab + k] = prices[i * scenarios + k];
+                }
+            }
+        }
+    });
+
+    cube.book.assign(scenarios, 0.0);
+    for (std::size_t p = 0; p < cube.positions; ++p) {
+        const double q = portfolio.quantity(p);
+        const double* unit = cube.prices.data() + p * scenarios;
+        for (std::size_t k = 0; k < scenarios; ++k) {
+            cube.book[k] += q * unit[k];
+        }
+    }
+
+    return cube;
+}
+
+} // namespace pricer
@@ -0,0 +1,258 @@
+#include "pricer/sobol.h"
+#include "pricer/normal.h"
+#include "pricer/random.h"
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace pricer {
+
+namespace {
+    // Joe & Kuo (2008) initial direction numbers m_1 ... m_s for dimensions
+    // 2 to 21 of their new-joe-kuo-6.21201 table (dimension 1 is all ones)
+    constexpr std::uint32_t kJoeKuoInitial[][7] = {
+        {1},
+        {1, 3},
+        {1, 3, 1},
+        {1, 1, 1},
+        {1, 1, 3, 3},
+        {1, 3, 5, 13},
+        {1, 1, 5, 5, 17},
+        {1, 1, 5, 5, 5},
+        {1, 1, 7, 11, 19},
+        {1, 1, 5, 1, 1},
+        {1, 1, 1, 3, 11},
+        {1, 3, 5, 5, 31},
+        {1, 3, 3, 9, 7, 49},
+        {1, 1, 1, 15, 21, 21},
+        {1, 3, 1, 13, 27, 49},
+        {1, 1, 1, 15, 7, 5},
+        {1, 3, 1, 15, 13, 25},
+        {1, 1, 5, 5, 19, 61},
+        {1, 3, 7, 11, 23, 15, 103},
+        {1, 3, 7, 13, 13, 15, 69}
+    };
+    constexpr std::size_t kJoeKuoDimensions = std::size(kJoeKuoInitial) + 1;
+
+    // Multiplication in GF(2)[x] / p, where p has degree s
+    std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, const std::uint64_t p, const int s) {
+        std::uint64_t result = 0;
+        while (b) {
+            if (b & 1) {
+                result ^= a;
+            }
+            b >>= 1;
+            a <<= 1;
+            if ((a >> s) & 1) {
+                a ^= p;
+            }
+        }
+        return result;
+    }
+
+    // x^e mod p
+    std::uint64_t powX(std::uint64_t e, const std::uint64_t p, const int s) {
+        std::uint64_t base = s == 1 ? 1 : 2;  // x mod (x + 1) is 1
+        std::uint64_t result = 1;
+        while (e) {
+            if (e & 1) {
+                result = mulMod(result, base, p, s);
+            }
+            base = mulMod(base, base, p, s);
+            e >>= 1;
+        }
+        return result;
+    }
+
+    // p is primitive iff x has multiplicative order exactly 2^s - 1 modulo p
+    bool isPrimitive(const std::uint64_t p, const int s) {
+        const std::uint64_t order = (std::uint64_t{1} << s) - 1;
+        if (powX(order, p, s) != 1) {
+            return false;
+        }
+
+        std::uint64_t rest = order;
+        for (std::uint64_t f = 3; f * f <= rest; f += 2) {
+            if (rest % f == 0) {
+                if (powX(order / f, p, s) == 1) {
+                    return false;
+                }
+                while (rest % f == 0) {
+                    rest /= f;
+                }
+            }
+        }
+        return rest == 1 || rest == order || powX(order / rest, p, s) != 1;
+    }
+
+    std::uint32_t reverseBits(std::uint32_t x) {
+        x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+        x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+        x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+        x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+        return (x >> 16) | (x << 16);
+    }
+}
+
+std::uint32_t owenScramble(std::uint32_t x, const std::uint32_t seed) {
+    // Laine-Karras permutation on the reversed bits, so that each output
+    // bit depends only on the more significant input bits
+    x = reverseBits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverseBits(x);
+}
+
+SobolSequence::SobolSequence(const std::size_t dimensions)
+    : dimensions_(dimensions) {
+
+    if (dimensions_ == 0 || dimensions_ > kMaxDimensions) {
+        throw std::invalid_argument("Sobol dimension count out of range");
+    }
+
+    polynomials_.assign(dimensions_, 0);
+    directions_.assign(32 * dimensions_, 0);
+
+    // Dimension 0 is the van der Corput sequence
+    for (int i = 0; i < 32; ++i) {
+        directions_[i] = std::uint32_t{1} << (31 - i);
+    }
+
+    // Primitive polynomials in order of degree, then of middle coefficients
+    std::size_t dim = 1;
+    for (int s = 1; dim < dimensions_; ++s) {
+        for (std::uint64_t a = 0; a < (std::uint64_t{1} << (s - 1)) && dim < dimensions_; ++a) {
+            const std::uint64_t p = (std::uint64_t{1} << s) | (a << 1) | 1;
+            if (!isPrimitive(p, s)) {
+                continue;
+            }
+            polynomials_[dim] = static_cast<std::uint32_t>(p);
+
+            std::uint64_t m[33] = {};
+            for (int i = 1; i <= s && i <= 32; ++i) {
+                if (dim < kJoeKuoDimensions) {
+                    m[i] = kJoeKuoInitial[dim - 1][i - 1];
+                } else {
+                    // Any odd m_i below 2^i gives a valid sequence
+                    const auto bits = philox4x32({static_cast<std::uint32_t>(dim),
+                                                  static_cast<std::uint32_t>(i), 0, 0},
+                                                 {0x50B01u, 0u});
+                    m[i] = (bits[0] & ((std::uint64_t{1} << i) - 1)) | 1;
+                }
+            }
+
+            // m_i = 2 a_1 m_{i-1} ^ 4 a_2 m_{i-2} ^ ... ^ 2^s m_{i-s} ^ m_{i-s}
+            for (int i = s + 1; i <= 32; ++i) {
+                std::uint64_t value = m[i - s] ^ (m[i - s] << s);
+                for (int j = 1; j < s; ++j) {
+                    if ((p >> (s - j)) & 1) {
+                        value ^= m[i - j] << j;
+                    }
+                }
+                m[i] = value;
+            }
+
+            for (int i = 1; i <= 32; ++i) {
+                directions_[32 * dim + i - 1] = static_cast<std::uint32_t>(m[i] << (32 - i));
+            }
+            ++dim;
+        }
+    }
+}
+
+std::uint32_t SobolSequence::coordinate(const std::uint64_t index, const std::size_t dim) const {
+    const std::uint32_t* v = directions(dim);
+    std::uint64_t gray = index ^ (index >> 1);
+    std::uint32_t x = 0;
+    for (int bit = 0; gray && bit < 32; ++bit, gray >>= 1) {
+        if (gray & 1) {
+            x ^= v[bit];
+        }
+    }
+    return x;
+}
+
+void SobolSequence::normals(const std::uint64_t first_point, const std::size_t dim,
+                            const bool scramble, const std::uint32_t scramble_seed,
+                            const std::span<double> out) const {
+    const std::uint32_t* v = directions(dim);
+    std::uint32_t x = coordinate(first_point, dim);
+
+    for (std::size_t j = 0; j < out.size(); ++j) {
+        const std::uint32_t value = scramble ? owenScramble(x, scramble_seed) : x;
+        out[j] = inverseNormalCDF((static_cast<double>(value) + 0.5) * 0x1.0p-32);
+
+        // Gray code: the next point flips the lowest zero bit of the index
+        const int bit = std::countr_zero(first_point + j + 1);
+        x ^= bit < 32 ? v[bit] : 0;
+    }
+}
+
+BrownianBridge::BrownianBridge(const std::size_t steps)
+    : steps_(steps)
+    , bridge_index_(steps)
+    , left_index_(steps)
+    , right_index_(steps)
+    , left_weight_(steps)
+    , right_weight_(steps)
+    , std_dev_(steps) {
+
+    if (steps_ == 0) {
+        throw std::invalid_argument("Brownian bridge needs at least one step");
+    }
+
+    auto t = [&](std::size_t k) { return static_cast<double>(k + 1) / static_cast<double>(steps_); };
+
+    // map[k] != 0 once W(t_k) has been assigned a construction step
+    std::vector<std::size_t> map(steps_, 0);
+    map[steps_ - 1] = 1;
+    bridge_index_[0] = steps_ - 1;
+    std_dev_[0] = std::sqrt(t(steps_ - 1));
+
+    std::size_t j = 0;
+    for (std::size_t i = 1; i < steps_; ++i) {
+        // Next unassigned run [j, k) and the assigned point k closing it
+        while (map[j]) {
+            ++j;
+        }
+        std::size_t k = j;
+        while (!map[k]) {
+            ++k;
+        }
+        const std::size_t l = j + ((k - 1 - j) >> 1);
+        map[l] = i;
+
+        bridge_index_[i] = l;
+        left_index_[i] = j;
+        right_index_[i] = k;
+
+        const double t_left = j == 0 ? 0.0 : t(j - 1);
+        left_weight_[i] = (t(k) - t(l)) / (t(k) - t_left);
+        right_weight_[i] = (t(l) - t_left) / (t(k) - t_left);
+        std_dev_[i] = std::sqrt((t(l) - t_left) * (t(k) - t(l)) / (t(k) - t_left));
+
+        j = k + 1;
+        if (j >= steps_) {
+            j = 0;
+        }
+    }
+}
+
+void BrownianBridge::build(const std::span<const double> z, const std::span<double> w) const {
+    if (z.size() != steps_ || w.size() != steps_) {
+        throw std::invalid_argument("Brownian bridge buffers must hold one value per step");
+    }
+
+    w[steps_ - 1] = std_dev_[0] * z[0];
+    for (std::size_t i = 1; i < steps_; ++i) {
+        const std::size_t j = left_index_[i];
+        const std::size_t k = right_index_[i];
+        const double left = j == 0 ? 0.0 : w[j - 1];
+        w[bridge_index_[i]] = left_weight_[i] * left + right_weight_[i] * w[k] + std_dev_[i] * z[i];
+    }
+}
+
+} // namespace pricer
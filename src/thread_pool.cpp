@@ -0,0 +1,260 @@
+#include "pricer/thread_pool.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pricer {
+
+namespace {
+    // Pool and worker slot of the calling thread, if it is a worker
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_worker = 0;
+
+    std::mutex global_mutex;
+    size_t global_threads = 0;
+    bool global_pin_threads = false;
+    bool global_started = false;
+
+    // Every live pool, for ThreadPool::totalMetrics()
+    std::mutex pools_mutex;
+    std::vector<const ThreadPool*> live_pools;
+
+    size_t hardwareThreads() {
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    // Best effort: a failed affinity call just leaves the thread floating
+    void pinToCore(std::thread& thread, const size_t core) {
+#if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core % hardwareThreads(), &cpus);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#else
+        (void)thread;
+        (void)core;
+#endif
+    }
+
+    // Shared between the caller of parallelFor and the helper tasks it queued
+    struct LoopState {
+        const std::function<void(size_t)>* body = nullptr;
+        size_t count = 0;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        void run() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                if (!failed.load(std::memory_order_relaxed)) {
+                    try {
+                        (*body)(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        failed = true;
+                    }
+                }
+                if (done.fetch_add(1) + 1 == count) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.notify_all();
+                }
+            }
+        }
+    };
+}
+
+ThreadPool::ThreadPool(size_t num_threads, const bool pin_threads)
+    : pin_threads_(pin_threads) {
+
+    if (num_threads == 0) {
+        num_threads = hardwareThreads();
+    }
+
+    queues_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        queues_.push_back(std::make_unique<Worker>());
+    }
+
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        if (pin_threads_) {
+            pinToCore(workers_.back(), i);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(pools_mutex);
+    live_pools.push_back(this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(pools_mutex);
+        live_pools.erase(std::find(live_pools.begin(), live_pools.end(), this));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(const size_t count,
+                             const std::function<void(size_t)>& body,
+                             const size_t max_concurrency) {
+    if (count == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<LoopState>();
+    state->body = &body;
+    state->count = count;
+
+    // The caller is one of the threads, so queue at most size() helpers
+    const size_t limit = max_concurrency == 0 ? size() + 1 : max_concurrency;
+    const size_t helpers = std::min({limit, count, size() + 1}) - 1;
+    for (size_t i = 0; i < helpers; ++i) {
+        enqueue([state] { state->run(); });
+    }
+
+    state->run();
+
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&] { return state->done.load() == count; });
+    }
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+ThreadPoolMetrics ThreadPool::metrics() const {
+    ThreadPoolMetrics result;
+    result.workers = size();
+    result.tasks_queued = tasks_queued_.load(std::memory_order_relaxed);
+    result.tasks_run = tasks_run_.load(std::memory_order_relaxed);
+    result.steals = steals_.load(std::memory_order_relaxed);
+    result.queue_depth = queued_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        result.max_queue_depth = max_queued_;
+    }
+    return result;
+}
+
+ThreadPoolMetrics ThreadPool::totalMetrics() {
+    ThreadPoolMetrics total;
+    std::lock_guard<std::mutex> lock(pools_mutex);
+    for (const ThreadPool* pool : live_pools) {
+        const ThreadPoolMetrics pool_metrics = pool->metrics();
+        total.workers += pool_metrics.workers;
+        total.tasks_queued += pool_metrics.tasks_queued;
+        total.tasks_run += pool_metrics.tasks_run;
+        total.steals += pool_metrics.steals;
+        total.queue_depth += pool_metrics.queue_depth;
+        total.max_queue_depth = std::max(total.max_queue_depth, pool_metrics.max_queue_depth);
+    }
+    return total;
+}
+
+ThreadPool& ThreadPool::global() {
+    static const std::unique_ptr<ThreadPool> pool = [] {
+        std::lock_guard<std::mutex> lock(global_mutex);
+        global_started = true;
+        return std::make_unique<ThreadPool>(global_threads, global_pin_threads);
+    }();
+    return *pool;
+}
+
+void ThreadPool::setGlobalConfiguration(const size_t num_threads, const bool pin_threads) {
+    std::lock_guard<std::mutex> lock(global_mutex);
+    if (global_started) {
+        throw std::runtime_error("Global thread pool is already running");
+    }
+    global_threads = num_threads;
+    global_pin_threads = pin_threads;
+}
+
+void ThreadPool::enqueue(Task task) {
+    const size_t target = current_pool == this
+        ? current_worker
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        max_queued_ = std::max(max_queued_, ++queued_);
+    }
+    tasks_queued_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::tryPop(const size_t self, Task& task) {
+    // Newest task from our own deque first, it is the most likely to be cache-warm
+    {
+        Worker& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+
+    // Otherwise steal the oldest task of another worker
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        Worker& victim = *queues_[(self + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued_;
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(const size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    for (;;) {
+        Task task;
+        if (tryPop(index, task)) {
+            task();
+            tasks_run_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [&] { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace pricer
@@ -0,0 +1,28 @@
+#include "pricer/trace.h"
+#include <iomanip>
+#include <ostream>
+
+namespace pricer {
+
+void RecordingTraceSink::record(std::string_view engine, std::string_view label, double value) {
+    entries_.push_back({std::string(engine), std::string(label), value});
+}
+
+const double* RecordingTraceSink::find(std::string_view label) const {
+    for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+        if (it->label == label) {
+            return &it->value;
+        }
+    }
+    return nullptr;
+}
+
+void StreamTraceSink::record(std::string_view engine, std::string_view label, double value) {
+    std::string text;
+    text.reserve(engine.size() + label.size() + 3);
+    text.append("[").append(engine).append("] ").append(label);
+    out_ << std::setw(40) << std::left << text << " = "
+         << std::fixed << std::setprecision(6) << value << '\n';
+}
+
+} // namespace pricer
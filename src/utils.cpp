@@ -2,85 +2,32 @@
 // Created by Yusufu Shehu on 18/01/2025.
 //
 #include "pricer/utils.h"
+#include "pricer/engine.h"
+#include "pricer/normal.h"
+#include "pricer/thread_pool.h"
+#include "vector_math.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
 
 
 namespace pricer::utils {
 
-double normalCDF(double x) {
-    // Using Abramowitz and Stegun approximation (1.26.2.32)
-    constexpr double a1 = 0.254829592;
-    constexpr double a2 = -0.284496736;
-    constexpr double a3 = 1.421413741;
-    constexpr double a4 = -1.453152027;
-    constexpr double a5 = 1.061405429;
-    constexpr double p = 0.3275911;
-
-    double sign = 1.0;
-    if (x < 0) {
-        sign = -1.0;
-        x = -x;
-    }
-
-    double t = 1.0 / (1.0 + p * x);
-    double y = 1.0 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * std::exp(-x * x / 2.0);
-
-    return 0.5 * (1.0 + sign * y);
+double normalCDF(const double x) {
+    return pricer::normalCDF(x);
 }
 
-double normalPDF(double x) {
-    static const double sqrt2pi = std::sqrt(2.0 * M_PI);
-    return std::exp(-x * x / 2.0) / sqrt2pi;
+double normalPDF(const double x) {
+    return pricer::normalPDF(x);
 }
 
-double inverseNormalCDF(double p) {
+double inverseNormalCDF(const double p) {
     if (p <= 0.0 || p >= 1.0) {
         throw std::invalid_argument("Probability must be between 0 and 1");
     }
-
-    // Beasley-Springer-Moro algorithm
-    static const double a[4] = {
-        2.50662823884,
-        -18.61500062529,
-        41.39119773534,
-        -25.44106049637
-    };
-
-    static const double b[4] = {
-        -8.47351093090,
-        23.08336743743,
-        -21.06224101826,
-        3.13082909833
-    };
-
-    static const double c[9] = {
-        0.3374754822726147,
-        0.9761690190917186,
-        0.1607979714918209,
-        0.0276438810333863,
-        0.0038405729373609,
-        0.0003951896511919,
-        0.0000321767881768,
-        0.0000002888167364,
-        0.0000003960315187
-    };
-
-    double q = p - 0.5;
-    double r;
-
-    if (std::abs(q) <= 0.42) {
-        r = q * q;
-        double num = (((a[3] * r + a[2]) * r + a[1]) * r + a[0]) * q;
-        double den = ((((b[3] * r + b[2]) * r + b[1]) * r + b[0]) * r + 1.0);
-        return num / den;
-    }
-
-    r = (q > 0) ? (1.0 - p) : p;
-    r = std::sqrt(-std::log(r));
-    double x = ((((((((c[8] * r + c[7]) * r + c[6]) * r + c[5]) * r + c[4]) * r + c[3]) * r + c[2]) * r + c[1]) * r + c[0]);
-
-    return (q > 0) ? x : -x;
+    return pricer::inverseNormalCDF(p);
 }
 
 std::vector<double> generateNormalVariates(size_t n, std::mt19937& rng) {
@@ -115,27 +62,190 @@ double forwardPrice(double spot, double rate, double dividend, double time) {
     return spot * std::exp((rate - dividend) * time);
 }
 
-    double impliedVolatility(double marketPrice, double spot, double strike,
-                            double rate, double time, double dividend, bool isCall) {
-    // Newton-Raphson implementation
-    const double ACCURACY = 1.0e-5;
-    const int MAX_ITERATIONS = 100;
-    double sigma = 0.5;  // Initial guess
-
-    for (int i = 0; i < MAX_ITERATIONS; i++) {
-        // TODO: Implement proper Black-Scholes calculation here
-        // For now, return placeholder to avoid unused parameter warnings
-        (void)marketPrice;
-        (void)spot;
-        (void)strike;
-        (void)rate;
-        (void)time;
-        (void)dividend;
-        (void)isCall;
-        (void)ACCURACY;
+namespace {
+    // Quotes per call of the implied volatility kernels
+    constexpr std::size_t kImpliedVolBlock = 256;
+    constexpr int kImpliedVolMaxIterations = 16;
+
+    // Rows of the solver state, one contiguous array each so the kernels vectorize
+    enum ImpliedVolRow { kLogMoneyness, kNormalizedPrice, kHalfForward, kTotalVol, kLower, kUpper, kImpliedVolRows };
+
+    // Normalized out-of-the-money price b(x, s) = e^{x/2} N(x/s + s/2) - e^{-x/2} N(x/s - s/2)
+    // of an undiscounted call with unit sqrt(FK), for x <= 0 and s = sigma sqrt(T)
+    inline double normalizedPrice(const double x, const double half_forward, const double s) {
+        return half_forward * simd::normalCDF(x / s + s / 2.0) - simd::normalCDF(x / s - s / 2.0) / half_forward;
+    }
+
+    // Reduces every quote to (x, beta) with x <= 0 and seeds the solver. Puts and
+    // in-the-money calls map to the out-of-the-money call through put-call parity.
+    // Prices outside the no-arbitrage bounds get a NaN normalized price.
+    PRICER_SIMD_CLONES
+    void impliedVolSetup(const double* price, const double* spot, const double* strike, const double* expiry,
+                         const double* rate, const double* dividend, const OptionType* type,
+                         double (*state)[kImpliedVolBlock], const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const double T = expiry[i];
+            const double carry = (rate[i] - dividend[i]) * T;
+            const double w = type[i] == OptionType::Call ? 1.0 : -1.0;
+
+            // Call-equivalent log-moneyness and its out-of-the-money image
+            const double moneyness = w * (simd::log(spot[i] / strike[i]) + carry);
+            const double x = -std::fabs(moneyness);
+            const double half_forward = simd::exp(x / 2.0);
+
+            // Normalize by the discounted sqrt(F K) and strip the intrinsic value
+            const double scale = strike[i] * simd::exp(-rate[i] * T) * simd::exp(w * moneyness / 2.0);
+            const double intrinsic = moneyness > 0.0 ? 1.0 / half_forward - half_forward : 0.0;
+            const double beta = price[i] / scale - intrinsic;
+            const bool valid = beta > 0.0 && beta < half_forward;
+
+            // b is convex in s below its inflection point sqrt(2|x|) and concave above
+            const double s_c = std::sqrt(-2.0 * x);
+            const bool lower_wing = beta < normalizedPrice(x, half_forward, s_c);
+
+            // Lower wing: asymptotic b ~ phi(x/s) s^3 / x^2 for small s, solved by one fixed-point pass
+            const double log_beta = simd::log(beta);
+            const double s_0 = -x / std::sqrt(-2.0 * log_beta);
+            const double r = 3.0 * simd::log(s_0) - 2.0 * simd::log(-x) - 0.91893853320467274 - s_0 * s_0 / 8.0 - log_beta;
+            const double wing_guess = -x / std::sqrt(2.0 * (r > 0.0 ? r : 1e-300));
+
+            // Upper region: Corrado-Miller in normalized units, F = e^{x/2}, K = e^{-x/2}
+            const double f_minus_k = half_forward - 1.0 / half_forward;
+            const double a = beta - f_minus_k / 2.0;
+            const double disc = a * a - f_minus_k * f_minus_k / M_PI;
+            const double cm_guess = 2.5066282746310002 / (half_forward + 1.0 / half_forward)
+                                    * (a + std::sqrt(disc > 0.0 ? disc : 0.0));
+
+            // Each guess is used only inside its bracket, with s_c as the last resort
+            const double lower = lower_wing ? 0.0 : s_c;
+            const double upper = lower_wing ? s_c : HUGE_VAL;
+            const double guess = (lower_wing ? wing_guess : HUGE_VAL) <= s_c ? wing_guess : cm_guess;
+
+            state[kLogMoneyness][i] = x;
+            state[kNormalizedPrice][i] = valid ? beta : std::numeric_limits<double>::quiet_NaN();
+            state[kHalfForward][i] = half_forward;
+            state[kTotalVol][i] = guess >= lower ? (guess <= upper ? guess : s_c) : s_c;
+            state[kLower][i] = lower;
+            state[kUpper][i] = upper;
+        }
+    }
+
+    // One safeguarded Halley step on log b(s) - log beta, whose curvature stays mild
+    // in both wings. Steps leaving the bracket fall back to bisection (or doubling
+    // while there is no upper bound). Returns how many quotes moved by more than
+    // the tolerance; once the bracket has collapsed every step is below it.
+    PRICER_SIMD_CLONES
+    std::size_t impliedVolStep(double (*state)[kImpliedVolBlock], const std::size_t n) {
+        constexpr double inv_sqrt2pi = 0.39894228040143267794;
+        constexpr double tolerance = 1e-12;
+        std::size_t moving = 0;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const double x = state[kLogMoneyness][i];
+            const double beta = state[kNormalizedPrice][i];
+            const double s = state[kTotalVol][i];
+
+            const double b = normalizedPrice(x, state[kHalfForward][i], s);
+            const double vega = inv_sqrt2pi * simd::exp(-0.5 * (x * x / (s * s) + s * s / 4.0));
+            const double volga = vega * (x * x / (s * s * s) - s / 4.0);
+
+            const double lower = b < beta ? s : state[kLower][i];
+            const double upper = b < beta ? state[kUpper][i] : s;
+
+            const double h = simd::log(b / beta);
+            const double dh = vega / b;
+            const double d2h = volga / b - dh * dh;
+            const double next = s - h / dh / (1.0 - h * d2h / (2.0 * dh * dh));
+
+            const bool inside = (next >= lower) & (next <= upper);
+            const double fallback = upper < HUGE_VAL ? 0.5 * (lower + upper) : 2.0 * s;
+            const double accepted = inside ? next : fallback;
+
+            state[kTotalVol][i] = accepted;
+            state[kLower][i] = lower;
+            state[kUpper][i] = upper;
+            moving += (beta == beta) & (std::fabs(accepted - s) >= tolerance * s);
+        }
+        return moving;
+    }
+
+    void impliedVolChain(const double* price, const double* spot, const double* strike, const double* expiry,
+                         const double* rate, const double* dividend, const OptionType* type,
+                         double* out, const std::size_t n) {
+        double state[kImpliedVolRows][kImpliedVolBlock];
+
+        for (std::size_t begin = 0; begin < n; begin += kImpliedVolBlock) {
+            const std::size_t count = std::min(kImpliedVolBlock, n - begin);
+            impliedVolSetup(price + begin, spot + begin, strike + begin, expiry + begin,
+                            rate + begin, dividend + begin, type + begin, state, count);
+
+            for (int iteration = 0; iteration < kImpliedVolMaxIterations; ++iteration) {
+                if (impliedVolStep(state, count) == 0) {
+                    break;
+                }
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const double beta = state[kNormalizedPrice][i];
+                out[begin + i] = beta == beta ? state[kTotalVol][i] / std::sqrt(expiry[begin + i])
+                                              : std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+}
+
+double impliedVolatility(const double marketPrice, const double spot, const double strike,
+                         const double rate, const double time, const double dividend, const bool isCall) {
+    const OptionType type = isCall ? OptionType::Call : OptionType::Put;
+    double sigma;
+    impliedVolatilityBatch({&marketPrice, 1}, {&spot, 1}, {&strike, 1}, {&time, 1},
+                           {&rate, 1}, {&dividend, 1}, {&type, 1}, {&sigma, 1});
+
+    if (std::isnan(sigma)) {
+        throw std::invalid_argument("Market price is outside the no-arbitrage bounds");
     }
     return sigma;
 }
+
+void impliedVolatilityBatch(const std::span<const double> marketPrice,
+                            const std::span<const double> spot,
+                            const std::span<const double> strike,
+                            const std::span<const double> expiry,
+                            const std::span<const double> rate,
+                            const std::span<const double> dividend,
+                            const std::span<const OptionType> type,
+                            const std::span<double> out) {
+    const std::size_t n = out.size();
+    if (marketPrice.size() != n || spot.size() != n || strike.size() != n || expiry.size() != n
+        || rate.size() != n || dividend.size() != n || type.size() != n) {
+        throw std::invalid_argument("Batch inputs must all have the same length");
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (expiry[i] <= 0.0) {
+            throw std::invalid_argument("Time to expiry must be positive");
+        }
+        if (spot[i] <= 0.0 || strike[i] <= 0.0) {
+            throw std::invalid_argument("Spot and strike prices must be positive");
+        }
+    }
+
+    constexpr std::size_t chunk = 4096;
+    if (n <= chunk) {
+        impliedVolChain(marketPrice.data(), spot.data(), strike.data(), expiry.data(),
+                        rate.data(), dividend.data(), type.data(), out.data(), n);
+        return;
+    }
+
+    ThreadPool::global().parallelFor((n + chunk - 1) / chunk, [&](const std::size_t c) {
+        const std::size_t begin = c * chunk;
+        const std::size_t count = std::min(chunk, n - begin);
+        impliedVolChain(marketPrice.data() + begin, spot.data() + begin, strike.data() + begin,
+                        expiry.data() + begin, rate.data() + begin, dividend.data() + begin,
+                        type.data() + begin, out.data() + begin, count);
+    });
+}
+
 double historicalVolatility(const std::vector<double>& prices, const double timeStep) {
     if (prices.size() < 2) {
         throw std::invalid_argument("Need at least two prices to calculate volatility");
@@ -182,72 +292,67 @@ double presentValue(const std::vector<double>& cashFlows,
 bool isApproxEqual(const double a, const double b, const double epsilon) {
     return std::abs(a - b) <= epsilon * std::max(std::abs(a), std::abs(b));
 }
-    // Add to end of file...
-
-double utils::finiteDifferenceDelta(const Option& option, const double h) {
-    const double spot = option.getSpot();
 
-    const_cast<Option&>(option).setSpot(spot + h);
-    const double price_up = option.price();
+namespace {
+    const PricingEngine& pricingEngine(const Option& option) {
+        if (!option.getEngine()) {
+            throw std::runtime_error("No pricing engine set");
+        }
+        return *option.getEngine();
+    }
+}
 
-    const_cast<Option&>(option).setSpot(spot - h);
-    const double price_down = option.price();
+double finiteDifferenceDelta(const Option& option, const double h) {
+    const OptionParameters params = option.parameters();
+    const PricingEngine& engine = pricingEngine(option);
+    const double spot = params.getSpot();
 
-    const_cast<Option&>(option).setSpot(spot);  // Reset
+    const double price_up = engine.calculate(params.withSpot(spot + h));
+    const double price_down = engine.calculate(params.withSpot(spot - h));
 
     return (price_up - price_down) / (2 * h);
 }
 
-double utils::finiteDifferenceGamma(const Option& option, const double h) {
-    const double spot = option.getSpot();
-
-    const_cast<Option&>(option).setSpot(spot + h);
-    const double price_up = option.price();
+double finiteDifferenceGamma(const Option& option, const double h) {
+    const OptionParameters params = option.parameters();
+    const PricingEngine& engine = pricingEngine(option);
+    const double spot = params.getSpot();
 
-    const_cast<Option&>(option).setSpot(spot - h);
-    const double price_down = option.price();
-
-    const_cast<Option&>(option).setSpot(spot);
-    const double price_mid = option.price();
+    const double price_up = engine.calculate(params.withSpot(spot + h));
+    const double price_down = engine.calculate(params.withSpot(spot - h));
+    const double price_mid = engine.calculate(params);
 
     return (price_up - 2 * price_mid + price_down) / (h * h);
 }
 
-double utils::finiteDifferenceTheta(const Option& option, const double h) {
-    const double expiry = option.getExpiry();
+double finiteDifferenceTheta(const Option& option, const double h) {
+    const OptionParameters params = option.parameters();
+    const PricingEngine& engine = pricingEngine(option);
 
-    const double original_price = option.price();
-    const_cast<Option&>(option).setExpiry(expiry - h);
-    const double new_price = option.price();
-    const_cast<Option&>(option).setExpiry(expiry);  // Reset
+    const double original_price = engine.calculate(params);
+    const double new_price = engine.calculate(params.withExpiry(params.getExpiry() - h));
 
     return -(new_price - original_price) / h;
 }
 
-double utils::finiteDifferenceVega(const Option& option, const double h) {
-    const double vol = option.getVolatility();
-
-    const_cast<Option&>(option).setVolatility(vol + h);
-    const double price_up = option.price();
-
-    const_cast<Option&>(option).setVolatility(vol - h);
-    const double price_down = option.price();
+double finiteDifferenceVega(const Option& option, const double h) {
+    const OptionParameters params = option.parameters();
+    const PricingEngine& engine = pricingEngine(option);
+    const double vol = params.getVolatility();
 
-    const_cast<Option&>(option).setVolatility(vol);  // Reset
+    const double price_up = engine.calculate(params.withVolatility(vol + h));
+    const double price_down = engine.calculate(params.withVolatility(vol - h));
 
     return (price_up - price_down) / (2 * h);
 }
 
-double utils::finiteDifferenceRho(const Option& option, const double h) {
-    const double rate = option.getRate();
-
-    const_cast<Option&>(option).setRate(rate + h);
-    const double price_up = option.price();
-
-    const_cast<Option&>(option).setRate(rate - h);
-    const double price_down = option.price();
+double finiteDifferenceRho(const Option& option, const double h) {
+    const OptionParameters params = option.parameters();
+    const PricingEngine& engine = pricingEngine(option);
+    const double rate = params.getRate();
 
-    const_cast<Option&>(option).setRate(rate);  // Reset
+    const double price_up = engine.calculate(params.withRate(rate + h));
+    const double price_down = engine.calculate(params.withRate(rate - h));
 
     return (price_up - price_down) / (2 * h);
 }
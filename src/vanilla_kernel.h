@@ -0,0 +1,64 @@
+//
+// Vanilla payoffs specialized at compile time on option type and exercise style.
+//
+
+#ifndef OPTIONS_PRICER_VANILLA_KERNEL_H
+#define OPTIONS_PRICER_VANILLA_KERNEL_H
+
+#include "pricer/contract.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace pricer::vanilla {
+
+template <OptionType Type>
+using TypeConstant = std::integral_constant<OptionType, Type>;
+
+template <ExerciseStyle Style>
+using StyleConstant = std::integral_constant<ExerciseStyle, Style>;
+
+// +1 for a call, -1 for a put
+template <OptionType Type>
+inline constexpr double kPhi = Type == OptionType::Call ? 1.0 : -1.0;
+
+// max(phi (S - K), 0)
+template <OptionType Type>
+[[nodiscard]] inline double intrinsic(const double spot, const double strike) {
+    return std::max(kPhi<Type> * (spot - strike), 0.0);
+}
+
+// Derivative of intrinsic with respect to the spot: phi in the money, else 0
+template <OptionType Type>
+[[nodiscard]] inline double slope(const double spot, const double strike) {
+    return kPhi<Type> * (spot - strike) > 0.0 ? kPhi<Type> : 0.0;
+}
+
+/**
+ * @brief Call body(TypeConstant<type>{}), so the runtime type is branched on
+ *        once and body is instantiated for calls and puts separately
+ */
+template <typename Body>
+decltype(auto) dispatch(const OptionType type, Body&& body) {
+    if (type == OptionType::Call) {
+        return body(TypeConstant<OptionType::Call>{});
+    }
+    return body(TypeConstant<OptionType::Put>{});
+}
+
+/**
+ * @brief As above on the type and the exercise style, calling
+ *        body(TypeConstant<type>{}, StyleConstant<exercise>{})
+ */
+template <typename Body>
+decltype(auto) dispatch(const OptionType type, const ExerciseStyle exercise, Body&& body) {
+    return dispatch(type, [&](const auto type_constant) -> decltype(auto) {
+        if (exercise == ExerciseStyle::American) {
+            return body(type_constant, StyleConstant<ExerciseStyle::American>{});
+        }
+        return body(type_constant, StyleConstant<ExerciseStyle::European>{});
+    });
+}
+
+} // namespace pricer::vanilla
+
+#endif // OPTIONS_PRICER_VANILLA_KERNEL_H
@@ -0,0 +1,175 @@
+#include "pricer/american_approximation.h"
+#include "pricer/black_scholes.h"
+#include "pricer/finite_difference.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+class AmericanApproximationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fd_engine = std::make_shared<pricer::FiniteDifferenceEngine>(1000, 1000);
+        bs_engine = pricer::makeBlackScholesPricingEngine();
+    }
+
+    struct Case {
+        pricer::OptionType type;
+        double spot;
+        double strike;
+        double expiry;
+        double rate;
+        double volatility;
+        double dividend;
+    };
+
+    static constexpr Case kCases[] = {
+        {pricer::OptionType::Put, 100.0, 100.0, 1.0, 0.05, 0.2, 0.0},
+        {pricer::OptionType::Put, 90.0, 100.0, 1.0, 0.05, 0.2, 0.0},
+        {pricer::OptionType::Put, 110.0, 100.0, 0.5, 0.08, 0.3, 0.02},
+        {pricer::OptionType::Call, 100.0, 90.0, 1.0, 0.05, 0.2, 0.06},
+        {pricer::OptionType::Call, 42.0, 40.0, 0.75, 0.04, 0.35, 0.08},
+        {pricer::OptionType::Put, 100.0, 100.0, 3.0, 0.06, 0.15, 0.09},
+    };
+
+    static pricer::OptionParameters makeOption(const Case& c) {
+        return {c.type, c.strike, c.expiry, c.spot, c.rate, c.volatility, c.dividend,
+                pricer::ExerciseStyle::American};
+    }
+
+    static pricer::ContractBatch makeBatch() {
+        pricer::ContractBatch batch;
+        for (int i = 0; i < 150; ++i) {
+            const Case& c = kCases[i % std::size(kCases)];
+            batch.add({c.strike, c.expiry, c.type, pricer::ExerciseStyle::American},
+                      {c.spot * (0.8 + 0.003 * i), c.rate, c.volatility, c.dividend});
+        }
+        return batch;
+    }
+
+    std::shared_ptr<pricer::FiniteDifferenceEngine> fd_engine;
+    std::shared_ptr<pricer::PricingEngine> bs_engine;
+};
+
+// Each method against a fine finite-difference grid; Bjerksund-Stensland is a lower bound
+TEST_F(AmericanApproximationTest, MatchesFiniteDifference) {
+    const pricer::AmericanApproximationEngine bjerksund(pricer::AmericanApproximation::BjerksundStensland);
+    const pricer::AmericanApproximationEngine whaley(pricer::AmericanApproximation::BaroneAdesiWhaley);
+    const pricer::AmericanApproximationEngine andersen(pricer::AmericanApproximation::AndersenLakeOffengenden);
+
+    for (const auto& c : kCases) {
+        const auto option = makeOption(c);
+        const double reference = fd_engine->calculate(option);
+
+        EXPECT_NEAR(bjerksund.calculate(option), reference, 0.1) << "spot " << c.spot;
+        EXPECT_LT(bjerksund.calculate(option), reference + 1e-3) << "spot " << c.spot;
+        EXPECT_NEAR(whaley.calculate(option), reference, 0.3) << "spot " << c.spot;
+        EXPECT_NEAR(andersen.calculate(option), reference, 1e-3) << "spot " << c.spot;
+    }
+}
+
+// Without dividends early exercise of a call is never optimal, and every method returns Black-Scholes
+TEST_F(AmericanApproximationTest, CallWithoutDividendIsEuropean) {
+    const pricer::OptionParameters option(pricer::OptionType::Call, 100.0, 1.0, 100.0, 0.05, 0.2, 0.0,
+                                          pricer::ExerciseStyle::American);
+    const double european = bs_engine->calculate(option);
+
+    for (const auto method : {pricer::AmericanApproximation::BjerksundStensland,
+                              pricer::AmericanApproximation::BaroneAdesiWhaley,
+                              pricer::AmericanApproximation::AndersenLakeOffengenden}) {
+        const pricer::AmericanApproximationEngine engine(method);
+        EXPECT_NEAR(engine.calculate(option), european, 1e-10);
+    }
+}
+
+// Deep in the money the put is worth its intrinsic value
+TEST_F(AmericanApproximationTest, DeepPutIsExercised) {
+    const pricer::OptionParameters option(pricer::OptionType::Put, 100.0, 1.0, 50.0, 0.05, 0.2, 0.0,
+                                          pricer::ExerciseStyle::American);
+
+    for (const auto method : {pricer::AmericanApproximation::BjerksundStensland,
+                              pricer::AmericanApproximation::BaroneAdesiWhaley,
+                              pricer::AmericanApproximation::AndersenLakeOffengenden}) {
+        const pricer::AmericanApproximationEngine engine(method);
+        EXPECT_DOUBLE_EQ(engine.calculate(option), 50.0);
+    }
+}
+
+// The batch kernels price each contract exactly as the scalar path does
+TEST_F(AmericanApproximationTest, BatchMatchesScalar) {
+    const pricer::ContractBatch batch = makeBatch();
+    std::vector<double> prices(batch.size());
+
+    for (const auto method : {pricer::AmericanApproximation::BjerksundStensland,
+                              pricer::AmericanApproximation::BaroneAdesiWhaley}) {
+        const pricer::AmericanApproximationEngine engine(method);
+        engine.priceBatch(batch, prices);
+
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            const pricer::ContractSpec contract = batch.contract(i);
+            const pricer::MarketState market = batch.market(i);
+            const pricer::OptionParameters option(contract.type, contract.strike, contract.expiry, market.spot,
+                                                  market.rate, market.volatility, market.dividend,
+                                                  contract.exercise);
+            EXPECT_NEAR(prices[i], engine.calculate(option), 1e-12) << "contract " << i;
+        }
+    }
+}
+
+// Greeks of the batch block equal the single-contract ones and track the finite-difference grid
+TEST_F(AmericanApproximationTest, BatchGreeksMatchScalar) {
+    const pricer::ContractBatch batch = makeBatch();
+    const pricer::AmericanApproximationEngine engine;
+    std::vector<pricer::PricingResult> results(batch.size() - 10);
+    engine.calculateAllBatch(batch, 10, results);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const pricer::ContractSpec contract = batch.contract(10 + i);
+        const pricer::MarketState market = batch.market(10 + i);
+        const pricer::OptionParameters option(contract.type, contract.strike, contract.expiry, market.spot,
+                                              market.rate, market.volatility, market.dividend,
+                                              contract.exercise);
+        const pricer::PricingResult single = engine.calculateAll(option);
+
+        EXPECT_NEAR(results[i].price, single.price, 1e-12) << "contract " << i;
+        EXPECT_NEAR(results[i].delta, single.delta, 1e-8) << "contract " << i;
+        EXPECT_NEAR(results[i].vega, single.vega, 1e-8) << "contract " << i;
+    }
+
+    const auto option = makeOption(kCases[0]);
+    const pricer::PricingResult fd = fd_engine->calculateAll(option);
+    const pricer::PricingResult approximation = engine.calculateAll(option);
+    EXPECT_NEAR(approximation.delta, fd.delta, 0.02);
+    EXPECT_NEAR(approximation.gamma, fd.gamma, 2e-3);
+    EXPECT_NEAR(approximation.vega, fd.vega, 0.02);
+
+    EXPECT_THROW(engine.calculateAllBatch(batch, 20, results), std::out_of_range);
+}
+
+TEST_F(AmericanApproximationTest, CalculateAllMatchesIndividualGreeks) {
+    const pricer::AmericanApproximationEngine engine(pricer::AmericanApproximation::BaroneAdesiWhaley);
+    const auto option = makeOption(kCases[2]);
+    const pricer::PricingResult all = engine.calculateAll(option);
+
+    EXPECT_DOUBLE_EQ(all.price, engine.calculate(option));
+    EXPECT_DOUBLE_EQ(all.delta, engine.calculateDelta(option));
+    EXPECT_DOUBLE_EQ(all.gamma, engine.calculateGamma(option));
+    EXPECT_DOUBLE_EQ(all.theta, engine.calculateTheta(option));
+    EXPECT_DOUBLE_EQ(all.vega, engine.calculateVega(option));
+    EXPECT_DOUBLE_EQ(all.rho, engine.calculateRho(option));
+}
+
+TEST_F(AmericanApproximationTest, InvalidBatch) {
+    const pricer::AmericanApproximationEngine engine;
+    const std::vector<double> ones(4, 1.0);
+    const std::vector<double> zeros(4, 0.0);
+    const std::vector<pricer::OptionType> types(4, pricer::OptionType::Put);
+    std::vector<double> out(3);
+
+    EXPECT_THROW(engine.priceBatch(ones, ones, ones, ones, ones, ones, types, out), std::invalid_argument);
+
+    out.resize(4);
+    EXPECT_THROW(engine.priceBatch(ones, ones, zeros, ones, ones, ones, types, out), std::invalid_argument);
+    EXPECT_THROW(engine.priceBatch(ones, ones, ones, ones, zeros, ones, types, out), std::invalid_argument);
+}
@@ -0,0 +1,143 @@
+#include "pricer/async.h"
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/finite_difference.h"
+#include "pricer/monte_carlo.h"
+#include "pricer/thread_pool.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+class AsyncTest : public ::testing::Test {
+protected:
+    static pricer::OptionParameters makeOption(const pricer::ExerciseStyle exercise = pricer::ExerciseStyle::European) {
+        return {pricer::OptionType::Put, 100.0, 1.0, 100.0, 0.05, 0.2, 0.0, exercise};
+    }
+};
+
+// Test that nothing is installed by default
+TEST_F(AsyncTest, NoJobByDefault) {
+    EXPECT_EQ(pricer::async::currentJob(), nullptr);
+    EXPECT_NO_THROW(pricer::async::checkpoint());
+}
+
+// Test that a job returns what the engine returns synchronously
+TEST_F(AsyncTest, MatchesSynchronousResult) {
+    const auto engine = std::make_shared<pricer::BlackScholesPricingEngine>();
+    const pricer::PricingResult expected = engine->calculateAll(makeOption());
+
+    const pricer::PricingJob job = pricer::priceAsync(engine, makeOption());
+    const pricer::PricingResult result = job.result.get();
+    EXPECT_EQ(result.price, expected.price);
+    EXPECT_EQ(result.delta, expected.delta);
+    EXPECT_EQ(result.rho, expected.rho);
+}
+
+// Test that finished runs once the result is ready
+TEST_F(AsyncTest, FinishedRunsAfterResult) {
+    std::promise<void> notified;
+    const pricer::PricingJob job = pricer::priceAsync(
+        std::make_shared<pricer::BlackScholesPricingEngine>(), makeOption(), {},
+        [&] { notified.set_value(); });
+
+    notified.get_future().get();
+    EXPECT_EQ(job.result.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
+
+// Test that Monte Carlo streams converging estimates and still prices the
+// same as outside of a job
+TEST_F(AsyncTest, MonteCarloStreamsEstimates) {
+    // Two threads take two chunks each per wave, so the run has several waves
+    const auto engine = std::make_shared<pricer::MonteCarloEngine>(100000, 1, true, 2);
+    engine->setThreadPool(std::make_shared<pricer::ThreadPool>(2));
+    const pricer::PricingResult expected = engine->calculateAll(makeOption());
+
+    std::vector<pricer::PricingProgress> reports;
+    const pricer::PricingJob job = pricer::priceAsync(engine, makeOption(), [&](const pricer::PricingProgress& progress) {
+        reports.push_back(progress);
+    });
+    const pricer::PricingResult result = job.result.get();
+
+    EXPECT_EQ(result.price, expected.price);
+    EXPECT_EQ(result.std_error, expected.std_error);
+    ASSERT_GT(reports.size(), 1u);
+    for (size_t i = 1; i < reports.size(); ++i) {
+        EXPECT_GE(reports[i].fraction, reports[i - 1].fraction);
+        EXPECT_GT(reports[i].estimate.paths, reports[i - 1].estimate.paths);
+    }
+    EXPECT_TRUE(reports.back().has_estimate);
+    EXPECT_EQ(reports.back().fraction, 1.0);
+    EXPECT_EQ(reports.back().estimate.price, result.price);
+    EXPECT_GT(reports.front().estimate.std_error, result.std_error);
+}
+
+// Test that the tree reports the price before the bumped Greeks
+TEST_F(AsyncTest, TreeReportsStages) {
+    const pricer::BinomialTreeEngine engine(200, false);
+    std::vector<pricer::PricingProgress> reports;
+    const pricer::JobControl control{{}, [&](const pricer::PricingProgress& progress) {
+        reports.push_back(progress);
+    }};
+
+    pricer::PricingResult result;
+    {
+        const pricer::async::ScopedJob scope(&control);
+        result = engine.calculateAll(makeOption(pricer::ExerciseStyle::American));
+    }
+
+    ASSERT_EQ(reports.size(), 3u);
+    EXPECT_EQ(reports.front().estimate.price, result.price);
+    EXPECT_EQ(reports.front().estimate.vega, 0.0);
+    EXPECT_EQ(reports.back().fraction, 1.0);
+    EXPECT_EQ(reports.back().estimate.rho, result.rho);
+}
+
+// Test that cancelling stops the engines at their next checkpoint
+TEST_F(AsyncTest, CancelStopsPricing) {
+    const pricer::CancellationToken token;
+    const pricer::JobControl control{token, [&](const pricer::PricingProgress&) { token.cancel(); }};
+    const pricer::async::ScopedJob scope(&control);
+
+    const pricer::MonteCarloEngine monte_carlo(100000, 1, true, 1);
+    EXPECT_THROW((void)monte_carlo.calculateAll(makeOption()), pricer::PricingCancelled);
+    const pricer::MonteCarloEngine american(20000, 50);
+    EXPECT_THROW((void)american.calculateAll(makeOption(pricer::ExerciseStyle::American)),
+                 pricer::PricingCancelled);
+    const pricer::BinomialTreeEngine tree(200);
+    EXPECT_THROW((void)tree.calculateAll(makeOption()), pricer::PricingCancelled);
+}
+
+// Test that the PDE solves, including the bumped ones on the pool, stop once
+// the job is cancelled
+TEST_F(AsyncTest, CancelStopsFiniteDifference) {
+    const pricer::CancellationToken token;
+    token.cancel();
+    const pricer::JobControl control{token, {}};
+    const pricer::async::ScopedJob scope(&control);
+
+    pricer::FiniteDifferenceEngine engine(200, 100);
+    engine.setThreadPool(std::make_shared<pricer::ThreadPool>(2));
+    EXPECT_THROW((void)engine.calculate(makeOption(pricer::ExerciseStyle::American)), pricer::PricingCancelled);
+    EXPECT_THROW((void)engine.calculateAll(makeOption()), pricer::PricingCancelled);
+}
+
+// Test that a job cancelled before it starts never prices
+TEST_F(AsyncTest, CancelledJobThrows) {
+    pricer::ThreadPool pool(1);
+    std::promise<void> release;
+    auto blocker = pool.submit([gate = release.get_future()]() mutable { gate.get(); });
+
+    const pricer::PricingJob job = pricer::priceAsync(
+        std::make_shared<pricer::BinomialTreeEngine>(), makeOption(), {}, {}, &pool);
+    job.token.cancel();
+    release.set_value();
+    blocker.get();
+
+    EXPECT_THROW((void)job.result.get(), pricer::PricingCancelled);
+}
+
+TEST_F(AsyncTest, RequiresEngine) {
+    EXPECT_THROW((void)pricer::priceAsync(nullptr, makeOption()), std::invalid_argument);
+}
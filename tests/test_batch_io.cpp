@@ -0,0 +1,177 @@
+#include "pricer/batch_io.h"
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class BatchIoTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 10; ++i) {
+            batch.add({80.0 + 5.0 * i, 0.25 + 0.25 * (i % 3),
+                       i % 2 == 0 ? pricer::OptionType::Call : pricer::OptionType::Put,
+                       i % 4 == 3 ? pricer::ExerciseStyle::American : pricer::ExerciseStyle::European},
+                      {100.0 + (i % 2), 0.05, 0.2 + 0.01 * i, 0.01});
+        }
+    }
+
+    static std::string encode(const pricer::ContractBatch& contracts, const pricer::BatchFormat format) {
+        std::ostringstream out;
+        pricer::writeContracts(out, contracts, format);
+        return out.str();
+    }
+
+    static pricer::ContractBatch readAll(const std::string& contents) {
+        pricer::ContractReader reader(contents);
+        pricer::ContractBatch chunk;
+        pricer::ContractBatch all;
+        while (reader.next(chunk, 3)) {
+            EXPECT_LE(chunk.size(), 3u);
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                all.add(chunk.contract(i), chunk.market(i));
+            }
+        }
+        return all;
+    }
+
+    static void expectSameContracts(const pricer::ContractBatch& a, const pricer::ContractBatch& b) {
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            EXPECT_EQ(a.strikes()[i], b.strikes()[i]);
+            EXPECT_EQ(a.expiries()[i], b.expiries()[i]);
+            EXPECT_EQ(a.types()[i], b.types()[i]);
+            EXPECT_EQ(a.exercises()[i], b.exercises()[i]);
+            EXPECT_EQ(a.spots()[i], b.spots()[i]);
+            EXPECT_EQ(a.rates()[i], b.rates()[i]);
+            EXPECT_EQ(a.volatilities()[i], b.volatilities()[i]);
+            EXPECT_EQ(a.dividends()[i], b.dividends()[i]);
+        }
+    }
+
+    pricer::ContractBatch batch;
+};
+
+// Test that both formats read back exactly what was written, in chunks
+TEST_F(BatchIoTest, RoundTripsContracts) {
+    const std::string csv = encode(batch, pricer::BatchFormat::Csv);
+    const std::string binary = encode(batch, pricer::BatchFormat::Binary);
+    EXPECT_EQ(pricer::detectContractFormat(csv), pricer::BatchFormat::Csv);
+    EXPECT_EQ(pricer::detectContractFormat(binary), pricer::BatchFormat::Binary);
+
+    expectSameContracts(readAll(csv), batch);
+    expectSameContracts(readAll(binary), batch);
+}
+
+// Test that CSV columns are matched by name, with defaults for the optional ones
+TEST_F(BatchIoTest, CsvColumnsByName) {
+    const std::string csv =
+        "Spot, Strike ,book,Type,expiry,rate,volatility\r\n"
+        "100,95,desk-a,call,0.5,0.05,0.2\r\n"
+        "\n"
+        "101,105,desk-b,P,1,0.04,0.3\n";
+
+    const pricer::ContractBatch contracts = readAll(csv);
+    ASSERT_EQ(contracts.size(), 2u);
+    EXPECT_EQ(contracts.strikes()[0], 95.0);
+    EXPECT_EQ(contracts.spots()[1], 101.0);
+    EXPECT_EQ(contracts.types()[1], pricer::OptionType::Put);
+    EXPECT_EQ(contracts.volatilities()[1], 0.3);
+    EXPECT_EQ(contracts.dividends()[0], 0.0);
+    EXPECT_EQ(contracts.exercises()[0], pricer::ExerciseStyle::European);
+}
+
+// Test that malformed files name the offending line
+TEST_F(BatchIoTest, RejectsMalformedFiles) {
+    EXPECT_THROW(pricer::ContractReader("type,strike,expiry,spot,rate\n"), std::runtime_error);
+
+    const std::string bad_number = "type,strike,expiry,spot,rate,volatility\ncall,100,1,100,0.05,0.2\ncall,1x0,1,100,0.05,0.2\n";
+    pricer::ContractReader reader(bad_number);
+    pricer::ContractBatch chunk;
+    try {
+        (void)reader.next(chunk, 10);
+        FAIL() << "Expected a parse error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos);
+    }
+
+    pricer::ContractReader invalid("type,strike,expiry,spot,rate,volatility\ncall,100,1,-100,0.05,0.2\n");
+    EXPECT_THROW((void)invalid.next(chunk, 10), std::invalid_argument);
+
+    std::string truncated = encode(batch, pricer::BatchFormat::Binary);
+    truncated.resize(truncated.size() - 8);
+    pricer::ContractReader short_reader(truncated);
+    EXPECT_THROW((void)short_reader.next(chunk, 10), std::runtime_error);
+}
+
+// Test that the pipeline writes every result in input order, whatever the chunking
+TEST_F(BatchIoTest, PricesFilesInOrder) {
+    const pricer::BinomialTreeEngine engine(100);
+    std::vector<pricer::PricingResult> expected(batch.size());
+    engine.calculateAllBatch(batch, 0, expected);
+
+    pricer::BatchFilePricer file_pricer(std::make_shared<pricer::ThreadPool>(2));
+    file_pricer.setChunkRows(3);
+    file_pricer.setTaskSize(2);
+
+    std::ostringstream csv;
+    const pricer::BatchRunStats stats =
+        file_pricer.price(engine, encode(batch, pricer::BatchFormat::Binary), csv, pricer::BatchFormat::Csv);
+    EXPECT_EQ(stats.contracts, batch.size());
+    EXPECT_EQ(stats.chunks, 4u);
+
+    std::istringstream lines(csv.str());
+    std::string line;
+    std::getline(lines, line);
+    EXPECT_EQ(line, "price,delta,gamma,theta,vega,rho,std_error");
+    for (const pricer::PricingResult& result : expected) {
+        ASSERT_TRUE(std::getline(lines, line));
+        double price = 0.0;
+        double delta = 0.0;
+        ASSERT_EQ(std::sscanf(line.c_str(), "%lf,%lf", &price, &delta), 2);
+        EXPECT_EQ(price, result.price);
+        EXPECT_EQ(delta, result.delta);
+    }
+    EXPECT_FALSE(std::getline(lines, line));
+
+    // Binary results: header, then one columnar block per chunk
+    std::ostringstream binary;
+    (void)file_pricer.price(engine, encode(batch, pricer::BatchFormat::Csv), binary, pricer::BatchFormat::Binary);
+    const std::string bytes = binary.str();
+    ASSERT_EQ(bytes.size(), 8u + 3u * (8u + 3u * 7u * 8u) + (8u + 7u * 8u));
+    EXPECT_EQ(bytes.compare(0, 4, "OPRB"), 0);
+    std::uint64_t rows = 0;
+    double first_price = 0.0;
+    double first_vega = 0.0;
+    std::memcpy(&rows, bytes.data() + 8, sizeof(rows));
+    std::memcpy(&first_price, bytes.data() + 16, sizeof(first_price));
+    std::memcpy(&first_vega, bytes.data() + 16 + 4 * 3 * 8, sizeof(first_vega));
+    EXPECT_EQ(rows, 3u);
+    EXPECT_EQ(first_price, expected[0].price);
+    EXPECT_EQ(first_vega, expected[0].vega);
+}
+
+TEST_F(BatchIoTest, MapsFiles) {
+    const std::string path = ::testing::TempDir() + "batch_io_contracts.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        pricer::writeContracts(out, batch, pricer::BatchFormat::Binary);
+    }
+    {
+        const pricer::MappedFile file(path);
+        EXPECT_EQ(file.contents(), encode(batch, pricer::BatchFormat::Binary));
+    }
+    std::remove(path.c_str());
+
+    EXPECT_THROW(pricer::MappedFile(::testing::TempDir() + "batch_io_missing.csv"), std::runtime_error);
+}
+
+TEST_F(BatchIoTest, RejectsZeroSizes) {
+    pricer::BatchFilePricer file_pricer;
+    EXPECT_THROW(file_pricer.setChunkRows(0), std::invalid_argument);
+    EXPECT_THROW(file_pricer.setTaskSize(0), std::invalid_argument);
+}
@@ -1,7 +1,9 @@
 #include "pricer/binomial.h"
 #include "pricer/black_scholes.h"
+#include "pricer/contract.h"
 #include "pricer/option.h"
 #include <gtest/gtest.h>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -151,7 +153,7 @@ TEST_F(BinomialTreeTest, Greeks) {
 
     EXPECT_NEAR(bin_delta, bs_delta, tolerance);
     EXPECT_NEAR(bin_gamma, bs_gamma, tolerance);
-    //EXPECT_NEAR(bin_theta, bs_theta, tolerance * 10);  // Wider tolerance for theta
+    EXPECT_NEAR(bin_theta, bs_theta, tolerance);
 }
 
 // Test put-call parity for European options
@@ -216,4 +218,124 @@ TEST_F(BinomialTreeTest, DividendEffect) {
 
     // With high dividends, American call should be worth more than European
     EXPECT_GT(amer_call->price(), eur_call->price());
-}
\ No newline at end of file
+}
+// Test fused lattice Greeks against Black-Scholes
+TEST_F(BinomialTreeTest, CalculateAllVsBlackScholes) {
+    for (const auto& option : {makeEuropeanCall(), makeEuropeanPut()}) {
+        option->setPricingEngine(bs_engine);
+        const pricer::PricingResult bs = option->calculateAll();
+
+        option->setPricingEngine(bin_engine);
+        const pricer::PricingResult bin = option->calculateAll();
+
+        EXPECT_NEAR(bin.price, bs.price, tolerance);
+        EXPECT_NEAR(bin.delta, bs.delta, tolerance);
+        EXPECT_NEAR(bin.gamma, bs.gamma, tolerance);
+        EXPECT_NEAR(bin.theta, bs.theta, tolerance);
+        EXPECT_NEAR(bin.vega, bs.vega, tolerance);
+        EXPECT_NEAR(bin.rho, bs.rho, tolerance);
+    }
+}
+
+// Test that rolling induction matches the full tree and scales to large trees
+TEST_F(BinomialTreeTest, RollingMatchesFullTree) {
+    EXPECT_EQ(bin_engine->getTreeStorage(), pricer::TreeStorage::Rolling);
+
+    auto full = std::make_shared<pricer::BinomialTreeEngine>(1000);
+    full->setTreeStorage(pricer::TreeStorage::FullTree);
+
+    for (const auto& option : {makeEuropeanCall(), makeAmericanPut()}) {
+        option->setPricingEngine(full);
+        const pricer::PricingResult expected = option->calculateAll();
+
+        option->setPricingEngine(bin_engine);
+        const pricer::PricingResult rolling = option->calculateAll();
+
+        EXPECT_NEAR(rolling.price, expected.price, 1e-10);
+        EXPECT_NEAR(rolling.delta, expected.delta, 1e-10);
+        EXPECT_NEAR(rolling.gamma, expected.gamma, 1e-10);
+        EXPECT_NEAR(rolling.theta, expected.theta, 1e-10);
+    }
+
+    // 10k steps (20k with extrapolation) would need gigabytes as a full tree
+    const auto option = makeAmericanPut();
+    option->setPricingEngine(std::make_shared<pricer::BinomialTreeEngine>(10000));
+    const double large = option->price();
+    option->setPricingEngine(bin_engine);
+    EXPECT_NEAR(large, option->price(), 1e-3);
+}
+
+// Test the lattice Greeks of an American put against bumped re-pricing
+TEST_F(BinomialTreeTest, LatticeGreeksVsBumpedPrices) {
+    const auto option = makeAmericanPut();
+    option->setPricingEngine(bin_engine);
+    const pricer::PricingResult lattice = option->calculateAll();
+
+    auto price_at = [&](double spot, double expiry) {
+        const auto bumped = makeAmericanPut();
+        bumped->setSpot(spot);
+        bumped->setExpiry(expiry);
+        bumped->setPricingEngine(bin_engine);
+        return bumped->price();
+    };
+
+    const double h = 1.0;
+    const double up = price_at(100.0 + h, 1.0);
+    const double down = price_at(100.0 - h, 1.0);
+    const double dt = 1.0 / 365.0;
+
+    EXPECT_DOUBLE_EQ(lattice.price, option->price());
+    EXPECT_NEAR(lattice.delta, (up - down) / (2.0 * h), 1e-3);
+    // Bumped gammas carry the tree's odd-even oscillation, the lattice one does not
+    EXPECT_NEAR(lattice.gamma, (up - 2.0 * lattice.price + down) / (h * h), 2e-3);
+    EXPECT_NEAR(lattice.theta, -(price_at(100.0, 1.0 + dt) - price_at(100.0, 1.0 - dt)) / (2.0 * dt) / 365.0, 1e-4);
+    EXPECT_DOUBLE_EQ(option->delta(), lattice.delta);
+
+    option->setPricingEngine(std::make_shared<pricer::BinomialTreeEngine>(4000));
+    const pricer::PricingResult fine = option->calculateAll();
+    EXPECT_NEAR(fine.delta, lattice.delta, 1e-4);
+    EXPECT_NEAR(fine.gamma, lattice.gamma, 1e-4);
+    EXPECT_NEAR(fine.theta, lattice.theta, 1e-5);
+}
+
+// Batch pricing groups contracts by type and style; every group must match scalar pricing
+TEST_F(BinomialTreeTest, BatchMatchesScalar) {
+    auto engine = std::make_shared<pricer::BinomialTreeEngine>(200);
+
+    // Strikes on one volatility share their spot lattices; 110 gets its own
+    pricer::ContractBatch batch;
+    for (const double strike : {90.0, 100.0, 110.0}) {
+        const pricer::MarketState market{100.0, 0.05, strike > 100.0 ? 0.3 : 0.25, 0.02};
+        for (const auto type : {pricer::OptionType::Put, pricer::OptionType::Call}) {
+            for (const auto exercise : {pricer::ExerciseStyle::American, pricer::ExerciseStyle::European}) {
+                batch.add({strike, 0.75, type, exercise}, market);
+            }
+        }
+    }
+
+    std::vector<double> prices(batch.size());
+    engine->priceBatch(batch, prices);
+
+    std::vector<pricer::PricingResult> results(batch.size() - 2);
+    engine->calculateAllBatch(batch, 2, results);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const pricer::OptionParameters option(batch.contract(i), batch.market(i));
+        EXPECT_DOUBLE_EQ(prices[i], engine->calculate(option));
+
+        if (i >= 2) {
+            const pricer::PricingResult expected = engine->calculateAll(option);
+            const pricer::PricingResult& result = results[i - 2];
+            EXPECT_DOUBLE_EQ(result.price, expected.price);
+            EXPECT_DOUBLE_EQ(result.delta, expected.delta);
+            EXPECT_DOUBLE_EQ(result.gamma, expected.gamma);
+            EXPECT_DOUBLE_EQ(result.theta, expected.theta);
+            EXPECT_NEAR(result.vega, expected.vega, 1e-10);
+            EXPECT_NEAR(result.rho, expected.rho, 1e-10);
+        }
+    }
+
+    std::vector<double> wrong(batch.size() + 1);
+    EXPECT_THROW(engine->priceBatch(batch, wrong), std::invalid_argument);
+    EXPECT_THROW(engine->calculateAllBatch(batch, 3, results), std::out_of_range);
+}
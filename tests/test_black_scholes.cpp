@@ -1,8 +1,11 @@
 #include "pricer/black_scholes.h"
 #include "pricer/option.h"
+#include "pricer/utils.h"
 #include <gtest/gtest.h>
 #include <memory>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 class BlackScholesTest : public ::testing::Test {
 protected:
@@ -192,4 +195,152 @@ TEST_F(BlackScholesTest, TimeDecay) {
 
     // Option with less time value should be worth less (all else equal)
     EXPECT_LT(shorter_option->price(), original_price);
-}
\ No newline at end of file
+}
+
+// Test batch pricing against the scalar engine across a chain
+TEST_F(BlackScholesTest, BatchMatchesScalar) {
+    const auto bs = std::make_shared<pricer::BlackScholesPricingEngine>();
+
+    std::vector<double> spot, strike, expiry, rate, vol, div;
+    std::vector<pricer::OptionType> type;
+    for (int i = 0; i < 101; ++i) {
+        spot.push_back(100.0);
+        strike.push_back(50.0 + i);
+        expiry.push_back(0.05 + 0.02 * i);
+        rate.push_back(0.01 + 0.0005 * i);
+        vol.push_back(0.1 + 0.004 * i);
+        div.push_back(i % 3 == 0 ? 0.0 : 0.02);
+        type.push_back(i % 2 == 0 ? pricer::OptionType::Call : pricer::OptionType::Put);
+    }
+
+    std::vector<double> prices(spot.size());
+    bs->priceBatch(spot, strike, expiry, rate, vol, div, type, prices);
+
+    for (size_t i = 0; i < spot.size(); ++i) {
+        pricer::EuropeanOption option(type[i], strike[i], expiry[i], spot[i], rate[i], vol[i], div[i]);
+        option.setPricingEngine(bs);
+        EXPECT_NEAR(prices[i], option.price(), 1e-12) << "contract " << i;
+    }
+}
+
+// Test batch pricing rejects mismatched or invalid inputs
+TEST_F(BlackScholesTest, BatchInvalidInputs) {
+    const pricer::BlackScholesPricingEngine bs;
+    std::vector<double> ones(4, 1.0);
+    std::vector<pricer::OptionType> types(4, pricer::OptionType::Call);
+    std::vector<double> out(3);
+
+    EXPECT_THROW(bs.priceBatch(ones, ones, ones, ones, ones, ones, types, out), std::invalid_argument);
+
+    out.resize(4);
+    std::vector<double> bad_vol = {0.2, 0.2, 0.0, 0.2};
+    EXPECT_THROW(bs.priceBatch(ones, ones, ones, ones, bad_vol, ones, types, out), std::invalid_argument);
+}
+
+// Test fused evaluation matches the individual methods
+TEST_F(BlackScholesTest, CalculateAllMatchesIndividual) {
+    for (const auto& option : {makeStandardCall(), makeStandardPut()}) {
+        option->setDividend(0.02);
+        option->setPricingEngine(engine);
+
+        const pricer::PricingResult result = option->calculateAll();
+        EXPECT_NEAR(result.price, option->price(), 1e-12);
+        EXPECT_NEAR(result.delta, option->delta(), 1e-12);
+        EXPECT_NEAR(result.gamma, option->gamma(), 1e-12);
+        EXPECT_NEAR(result.theta, option->theta(), 1e-12);
+        EXPECT_NEAR(result.vega, option->vega(), 1e-12);
+        EXPECT_NEAR(result.rho, option->rho(), 1e-12);
+    }
+}
+
+// Test the vectorized batch Greeks against the scalar fused path
+TEST_F(BlackScholesTest, CalculateAllBatch) {
+    pricer::ContractBatch batch;
+    for (int i = 0; i < 300; ++i) {
+        batch.add({60.0 + 0.3 * i, 0.1 + 0.01 * (i % 50), i % 2 ? pricer::OptionType::Put : pricer::OptionType::Call},
+                  {100.0, 0.04, 0.1 + 0.002 * i, 0.02});
+    }
+
+    const pricer::BlackScholesPricingEngine bs;
+    std::vector<pricer::PricingResult> results(batch.size() - 10);
+    bs.calculateAllBatch(batch, 10, results);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const pricer::PricingResult expected = bs.calculateAll({batch.contract(10 + i), batch.market(10 + i)});
+        EXPECT_NEAR(results[i].price, expected.price, 1e-10);
+        EXPECT_NEAR(results[i].delta, expected.delta, 1e-12);
+        EXPECT_NEAR(results[i].gamma, expected.gamma, 1e-12);
+        EXPECT_NEAR(results[i].theta, expected.theta, 1e-12);
+        EXPECT_NEAR(results[i].vega, expected.vega, 1e-12);
+        EXPECT_NEAR(results[i].rho, expected.rho, 1e-12);
+    }
+
+    std::vector<pricer::PricingResult> too_many(batch.size());
+    EXPECT_THROW(bs.calculateAllBatch(batch, 1, too_many), std::out_of_range);
+}
+
+// Test that implied volatility recovers the volatility that produced the price
+TEST_F(BlackScholesTest, ImpliedVolatilityRoundTrip) {
+    std::vector<double> price, spot, strike, expiry, rate, dividend, sigma, tolerance;
+    std::vector<pricer::OptionType> type;
+    for (const double K : {60.0, 85.0, 100.0, 115.0, 150.0}) {
+        for (const double T : {0.05, 0.5, 2.0}) {
+            for (const double vol : {0.05, 0.2, 0.6, 1.5}) {
+                for (const auto t : {pricer::OptionType::Call, pricer::OptionType::Put}) {
+                    // Rounding of the price alone moves sigma by about eps * price / vega
+                    const pricer::OptionParameters params(t, K, T, 100.0, 0.03, vol, 0.01);
+                    const double p = engine->calculate(params);
+                    const double vega = engine->calculateVega(params) * 100.0;
+                    const double tol = 1e-10 * vol + 64.0 * std::numeric_limits<double>::epsilon() * p / vega;
+                    if (p < 1e-12 || !(tol < 0.01 * vol)) {
+                        continue;  // no volatility information left
+                    }
+                    tolerance.push_back(tol);
+                    price.push_back(p);
+                    spot.push_back(100.0);
+                    strike.push_back(K);
+                    expiry.push_back(T);
+                    rate.push_back(0.03);
+                    dividend.push_back(0.01);
+                    sigma.push_back(vol);
+                    type.push_back(t);
+                }
+            }
+        }
+    }
+
+    ASSERT_GT(price.size(), 100u);
+
+    std::vector<double> implied(price.size());
+    pricer::utils::impliedVolatilityBatch(price, spot, strike, expiry, rate, dividend, type, implied);
+    for (size_t i = 0; i < price.size(); ++i) {
+        EXPECT_NEAR(implied[i], sigma[i], tolerance[i]) << "K=" << strike[i] << " T=" << expiry[i];
+        EXPECT_NEAR(pricer::utils::impliedVolatility(price[i], spot[i], strike[i], rate[i], expiry[i],
+                                                     dividend[i], type[i] == pricer::OptionType::Call),
+                    implied[i], 1e-14);
+    }
+}
+
+// Test that prices outside the no-arbitrage bounds are rejected
+TEST_F(BlackScholesTest, ImpliedVolatilityBounds) {
+    // Below intrinsic and above the discounted spot
+    EXPECT_THROW(pricer::utils::impliedVolatility(10.0, 100.0, 80.0, 0.05, 1.0, 0.0, true), std::invalid_argument);
+    EXPECT_THROW(pricer::utils::impliedVolatility(101.0, 100.0, 80.0, 0.05, 1.0, 0.0, true), std::invalid_argument);
+    EXPECT_THROW(pricer::utils::impliedVolatility(5.0, 100.0, 80.0, 0.05, 0.0, 0.0, true), std::invalid_argument);
+
+    const std::vector<double> price = {-1.0, 10.450583572185565};
+    const std::vector<double> spot = {100.0, 100.0};
+    const std::vector<double> strike = {100.0, 100.0};
+    const std::vector<double> expiry = {1.0, 1.0};
+    const std::vector<double> rate = {0.05, 0.05};
+    const std::vector<double> dividend = {0.0, 0.0};
+    const std::vector<pricer::OptionType> type = {pricer::OptionType::Call, pricer::OptionType::Call};
+    std::vector<double> implied(2);
+    pricer::utils::impliedVolatilityBatch(price, spot, strike, expiry, rate, dividend, type, implied);
+    EXPECT_TRUE(std::isnan(implied[0]));
+    EXPECT_NEAR(implied[1], 0.2, 1e-12);
+
+    std::vector<double> short_out(1);
+    EXPECT_THROW(pricer::utils::impliedVolatilityBatch(price, spot, strike, expiry, rate, dividend, type, short_out),
+                 std::invalid_argument);
+}
@@ -0,0 +1,161 @@
+#include "pricer/finite_difference.h"
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+class FiniteDifferenceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fd_engine = std::make_shared<pricer::FiniteDifferenceEngine>();
+        bs_engine = pricer::makeBlackScholesPricingEngine();
+        tree_engine = pricer::makeBinomialTreeEngine(1000, true);
+    }
+
+    static pricer::OptionParameters makeOption(const pricer::OptionType type,
+                                               const pricer::ExerciseStyle exercise,
+                                               const double spot = 100.0,
+                                               const double strike = 100.0,
+                                               const double dividend = 0.0) {
+        return {type, strike, 1.0, spot, 0.05, 0.2, dividend, exercise};
+    }
+
+    std::shared_ptr<pricer::FiniteDifferenceEngine> fd_engine;
+    std::shared_ptr<pricer::PricingEngine> bs_engine;
+    std::shared_ptr<pricer::PricingEngine> tree_engine;
+};
+
+// Price and Greeks of European options against the closed form
+TEST_F(FiniteDifferenceTest, EuropeanVsBlackScholes) {
+    for (const auto type : {pricer::OptionType::Call, pricer::OptionType::Put}) {
+        for (const double spot : {80.0, 100.0, 125.0}) {
+            const auto option = makeOption(type, pricer::ExerciseStyle::European, spot, 100.0, 0.02);
+            const pricer::PricingResult fd = fd_engine->calculateAll(option);
+            const pricer::PricingResult bs = bs_engine->calculateAll(option);
+
+            EXPECT_NEAR(fd.price, bs.price, 1e-3) << "spot " << spot;
+            EXPECT_NEAR(fd.delta, bs.delta, 1e-4) << "spot " << spot;
+            EXPECT_NEAR(fd.gamma, bs.gamma, 1e-5) << "spot " << spot;
+            EXPECT_NEAR(fd.theta, bs.theta, 1e-5) << "spot " << spot;
+            EXPECT_NEAR(fd.vega, bs.vega, 1e-3) << "spot " << spot;
+            EXPECT_NEAR(fd.rho, bs.rho, 1e-3) << "spot " << spot;
+        }
+    }
+}
+
+// American prices match a Richardson-extrapolated tree and carry an exercise premium
+TEST_F(FiniteDifferenceTest, AmericanVsBinomial) {
+    struct Case {
+        pricer::OptionType type;
+        double spot;
+        double strike;
+        double dividend;
+    };
+    const Case cases[] = {
+        {pricer::OptionType::Put, 100.0, 100.0, 0.0},
+        {pricer::OptionType::Put, 90.0, 100.0, 0.0},
+        {pricer::OptionType::Call, 100.0, 90.0, 0.06},
+    };
+
+    for (const auto& c : cases) {
+        const auto american = makeOption(c.type, pricer::ExerciseStyle::American, c.spot, c.strike, c.dividend);
+        const auto european = makeOption(c.type, pricer::ExerciseStyle::European, c.spot, c.strike, c.dividend);
+        const pricer::PricingResult fd = fd_engine->calculateAll(american);
+        const pricer::PricingResult tree = tree_engine->calculateAll(american);
+
+        EXPECT_NEAR(fd.price, tree.price, 1e-3) << "spot " << c.spot;
+        EXPECT_NEAR(fd.delta, tree.delta, 1e-4) << "spot " << c.spot;
+        EXPECT_NEAR(fd.gamma, tree.gamma, 1e-4) << "spot " << c.spot;
+        EXPECT_GT(fd.price, fd_engine->calculate(european) + 0.01) << "spot " << c.spot;
+    }
+}
+
+// Without dividends early exercise of a call is never optimal
+TEST_F(FiniteDifferenceTest, AmericanCallWithoutDividendIsEuropean) {
+    const auto american = makeOption(pricer::OptionType::Call, pricer::ExerciseStyle::American);
+    const double bs_price = bs_engine->calculate(american);
+
+    EXPECT_NEAR(fd_engine->calculate(american), bs_price, 1e-3);
+}
+
+// Doubling both grid resolutions cuts the European error about fourfold
+TEST_F(FiniteDifferenceTest, SecondOrderConvergence) {
+    const auto option = makeOption(pricer::OptionType::Put, pricer::ExerciseStyle::European, 95.0);
+    const double exact = bs_engine->calculate(option);
+
+    double previous_error = 0.0;
+    for (const size_t steps : {100, 200, 400}) {
+        const pricer::FiniteDifferenceEngine engine(steps, steps / 2);
+        const double error = std::abs(engine.calculate(option) - exact);
+        if (previous_error > 0.0) {
+            EXPECT_LT(error, previous_error / 3.0) << steps << " space steps";
+        }
+        previous_error = error;
+    }
+}
+
+// High-variance options, where the grid spans many times the strike, still
+// converge to Black-Scholes as the spot axis is refined
+TEST_F(FiniteDifferenceTest, HighVarianceRefinement) {
+    const pricer::OptionParameters options[] = {
+        {pricer::OptionType::Put, 100.0, 2.0, 100.0, 0.03, 1.2, 0.0, pricer::ExerciseStyle::European},
+        {pricer::OptionType::Put, 100.0, 5.0, 100.0, 0.03, 0.8, 0.0, pricer::ExerciseStyle::European},
+        {pricer::OptionType::Call, 100.0, 1.0, 110.0, 0.03, 2.0, 0.0, pricer::ExerciseStyle::European},
+    };
+    for (const auto& option : options) {
+        const double exact = bs_engine->calculate(option);
+
+        double previous_error = 0.0;
+        for (const size_t steps : {100, 200, 400, 800}) {
+            const pricer::FiniteDifferenceEngine engine(steps, 400);
+            const double error = std::abs(engine.calculate(option) - exact);
+            if (previous_error > 0.0) {
+                EXPECT_LT(error, previous_error) << steps << " space steps";
+            }
+            previous_error = error;
+        }
+        EXPECT_LT(previous_error, 2e-3 * exact) << "sigma sqrt(T) "
+                                                << option.getVolatility() * std::sqrt(option.getExpiry());
+    }
+}
+
+// The two early-exercise methods solve the same linear complementarity problem
+TEST_F(FiniteDifferenceTest, PsorMatchesBrennanSchwartz) {
+    const auto option = makeOption(pricer::OptionType::Put, pricer::ExerciseStyle::American, 95.0, 100.0, 0.01);
+    const double brennan_schwartz = fd_engine->calculate(option);
+
+    fd_engine->setEarlyExercise(pricer::EarlyExercise::PSOR);
+    EXPECT_NEAR(fd_engine->calculate(option), brennan_schwartz, 1e-8);
+}
+
+// Plain Crank-Nicolson rings at the strike of a short-dated option; Rannacher steps damp it
+TEST_F(FiniteDifferenceTest, RannacherDampsGammaOscillations) {
+    const pricer::OptionParameters option(pricer::OptionType::Call, 100.0, 0.05, 100.0, 0.05, 0.2);
+    const double exact = bs_engine->calculateGamma(option);
+
+    pricer::FiniteDifferenceEngine engine(200, 20);
+    EXPECT_NEAR(engine.calculateGamma(option), exact, 1e-3);
+
+    engine.setRannacherSteps(0);
+    EXPECT_GT(std::abs(engine.calculateGamma(option) - exact), 0.1);
+}
+
+TEST_F(FiniteDifferenceTest, CalculateAllMatchesIndividualGreeks) {
+    const auto option = makeOption(pricer::OptionType::Put, pricer::ExerciseStyle::American, 105.0);
+    const pricer::PricingResult all = fd_engine->calculateAll(option);
+
+    EXPECT_DOUBLE_EQ(all.price, fd_engine->calculate(option));
+    EXPECT_DOUBLE_EQ(all.delta, fd_engine->calculateDelta(option));
+    EXPECT_DOUBLE_EQ(all.gamma, fd_engine->calculateGamma(option));
+    EXPECT_DOUBLE_EQ(all.theta, fd_engine->calculateTheta(option));
+    EXPECT_DOUBLE_EQ(all.vega, fd_engine->calculateVega(option));
+    EXPECT_DOUBLE_EQ(all.rho, fd_engine->calculateRho(option));
+}
+
+TEST_F(FiniteDifferenceTest, InvalidGrid) {
+    EXPECT_THROW(pricer::FiniteDifferenceEngine(3, 100), std::invalid_argument);
+    EXPECT_THROW(pricer::FiniteDifferenceEngine(200, 0), std::invalid_argument);
+    EXPECT_THROW(fd_engine->setTimeSteps(0), std::invalid_argument);
+}
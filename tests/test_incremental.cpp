@@ -0,0 +1,124 @@
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/incremental.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+class IncrementalPricerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        engine = pricer::makeBlackScholesPricingEngine();
+        first = pricer.addUnderlying({100.0, 0.03, 0.20, 0.01});
+        second = pricer.addUnderlying({50.0, 0.03, 0.30, 0.0});
+
+        for (int i = 0; i < 10; ++i) {
+            const pricer::ContractSpec contract{90.0 + 2.0 * i, 0.5,
+                                                i % 2 ? pricer::OptionType::Put : pricer::OptionType::Call};
+            pricer.addPosition(contract, first, i % 3 ? 10.0 : -4.0, engine);
+        }
+        for (int i = 0; i < 6; ++i) {
+            pricer.addPosition({45.0 + 2.0 * i, 1.0}, second, 5.0, engine);
+        }
+    }
+
+    // Book priced from scratch at the pricer's current market
+    pricer::PortfolioResult fullReprice() const {
+        pricer::Portfolio book;
+        for (int i = 0; i < 10; ++i) {
+            book.add({90.0 + 2.0 * i, 0.5, i % 2 ? pricer::OptionType::Put : pricer::OptionType::Call},
+                     pricer.market(first), i % 3 ? 10.0 : -4.0, engine);
+        }
+        for (int i = 0; i < 6; ++i) {
+            book.add({45.0 + 2.0 * i, 1.0}, pricer.market(second), 5.0, engine);
+        }
+        return pricer::PortfolioPricer().price(book);
+    }
+
+    std::shared_ptr<pricer::PricingEngine> engine;
+    pricer::IncrementalPricer pricer;
+    size_t first = 0;
+    size_t second = 0;
+};
+
+// Test that only positions on a moved underlying are repriced
+TEST_F(IncrementalPricerTest, RepricesOnlyWhatMoved) {
+    pricer.reprice();
+    EXPECT_EQ(pricer.lastRepriced(), 16u);
+
+    pricer.reprice();
+    EXPECT_EQ(pricer.lastRepriced(), 0u);
+
+    pricer.setSpot(second, 52.0);
+    pricer.setRate(second, 0.04);
+    const pricer::PortfolioResult& result = pricer.reprice();
+    EXPECT_EQ(pricer.lastRepriced(), 6u);
+    EXPECT_EQ(pricer.lastApproximated(), 0u);
+
+    const pricer::PortfolioResult expected = fullReprice();
+    for (size_t p = 0; p < pricer.size(); ++p) {
+        EXPECT_NEAR(result.positions[p].price, expected.positions[p].price, 1e-12);
+        EXPECT_NEAR(result.positions[p].vega, expected.positions[p].vega, 1e-12);
+    }
+    EXPECT_NEAR(result.total.price, expected.total.price, 1e-9);
+    EXPECT_NEAR(result.total.delta, expected.total.delta, 1e-9);
+
+    EXPECT_THROW(pricer.setSpot(first, -1.0), std::invalid_argument);
+    EXPECT_THROW(pricer.setVolatility(5, 0.2), std::out_of_range);
+    EXPECT_THROW(pricer.addPosition({100.0, 1.0}, first, 1.0, nullptr), std::invalid_argument);
+}
+
+// Test the delta-gamma update for small spot moves and the fallback beyond it
+TEST_F(IncrementalPricerTest, TaylorFastPath) {
+    pricer.setTaylorThreshold(0.01);
+    pricer.reprice();
+
+    pricer.setSpot(first, 100.5);
+    const pricer::PortfolioResult& small = pricer.reprice();
+    EXPECT_EQ(pricer.lastApproximated(), 10u);
+    EXPECT_EQ(pricer.lastRepriced(), 0u);
+
+    pricer::PortfolioResult expected = fullReprice();
+    for (size_t p = 0; p < 10; ++p) {
+        EXPECT_NEAR(small.positions[p].price, expected.positions[p].price, 1e-3);
+        EXPECT_NEAR(small.positions[p].delta, expected.positions[p].delta, 1e-3);
+    }
+
+    // Moves are measured from the last full pricing, so drift is bounded
+    pricer.setSpot(first, 101.5);
+    pricer.reprice();
+    EXPECT_EQ(pricer.lastRepriced(), 10u);
+
+    // Any other input invalidates the expansion
+    pricer.setSpot(first, 101.6);
+    pricer.setVolatility(first, 0.22);
+    const pricer::PortfolioResult& moved = pricer.reprice();
+    EXPECT_EQ(pricer.lastRepriced(), 10u);
+
+    expected = fullReprice();
+    EXPECT_NEAR(moved.total.price, expected.total.price, 1e-9);
+    EXPECT_NEAR(moved.total.vega, expected.total.vega, 1e-9);
+}
+
+// Test that a reprice that throws keeps its work queued for the next one
+TEST_F(IncrementalPricerTest, FailedRepriceKeepsWorkQueued) {
+    pricer.reprice();
+    const double total = pricer.result().total.price;
+
+    // The tree's vega bump takes this volatility below zero
+    const size_t third = pricer.addUnderlying({80.0, 0.03, 5e-5, 0.0});
+    const auto tree = pricer::makeBinomialTreeEngine(100);
+    const size_t position = pricer.addPosition({80.0, 1.0}, third, 2.0, tree);
+    pricer.setSpot(first, 103.0);
+
+    EXPECT_THROW(pricer.reprice(), std::invalid_argument);
+    EXPECT_EQ(pricer.result().total.price, total);
+
+    pricer.setVolatility(third, 0.25);
+    const pricer::PortfolioResult& result = pricer.reprice();
+    EXPECT_EQ(pricer.lastRepriced(), 11u);
+
+    const pricer::PricingResult expected = tree->calculateAll({{80.0, 1.0}, pricer.market(third)});
+    EXPECT_NEAR(result.positions[position].price, expected.price, 1e-12);
+    EXPECT_NEAR(result.positions[0].price, fullReprice().positions[0].price, 1e-12);
+}
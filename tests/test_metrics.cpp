@@ -0,0 +1,141 @@
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/metrics.h"
+#include "pricer/monte_carlo.h"
+#include "pricer/thread_pool.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+class MetricsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        pricer::metrics::reset();
+    }
+
+    void TearDown() override {
+        pricer::metrics::setEnabled(false);
+        pricer::metrics::reset();
+    }
+
+    static pricer::OptionParameters makeOption(const pricer::ExerciseStyle exercise = pricer::ExerciseStyle::European) {
+        return {pricer::OptionType::Put, 100.0, 1.0, 100.0, 0.05, 0.2, 0.0, exercise};
+    }
+};
+
+// Nothing is recorded until collection is switched on
+TEST_F(MetricsTest, DisabledByDefault) {
+    EXPECT_FALSE(pricer::metrics::enabled());
+
+    const pricer::BlackScholesPricingEngine engine;
+    (void)engine.calculate(makeOption());
+
+    EXPECT_EQ(pricer::metrics::snapshot().engine(pricer::MetricsEngine::BlackScholes).calls, 0u);
+}
+
+#if OPTIONS_PRICER_ENABLE_METRICS
+// Scalar and batch calls count once each, batches with their length
+TEST_F(MetricsTest, CountsCallsAndContracts) {
+    pricer::metrics::setEnabled(true);
+    const pricer::BlackScholesPricingEngine engine;
+    (void)engine.calculate(makeOption());
+    (void)engine.calculateAll(makeOption());
+
+    const std::vector<double> ones(100, 1.0);
+    const std::vector<pricer::OptionType> types(100, pricer::OptionType::Call);
+    std::vector<double> out(100);
+    engine.priceBatch(ones, ones, ones, ones, ones, ones, types, out);
+
+    const pricer::EngineMetrics metrics = pricer::metrics::snapshot().engine(pricer::MetricsEngine::BlackScholes);
+    EXPECT_EQ(metrics.calls, 3u);
+    EXPECT_EQ(metrics.contracts, 102u);
+    EXPECT_EQ(metrics.latency.total(), 3u);
+    EXPECT_GT(metrics.total_ns, 0u);
+    EXPECT_GT(metrics.nanosecondsPerCall(), 0.0);
+}
+
+// calculateAll of a tree calls calculate for vega and rho; only the outer call counts
+TEST_F(MetricsTest, NestedCallsCountOnce) {
+    pricer::metrics::setEnabled(true);
+    const pricer::BinomialTreeEngine engine(100, false);
+    (void)engine.calculateAll(makeOption(pricer::ExerciseStyle::American));
+
+    const pricer::EngineMetrics metrics = pricer::metrics::snapshot().engine(pricer::MetricsEngine::BinomialTree);
+    EXPECT_EQ(metrics.calls, 1u);
+    // One tree for the lattice Greeks and four bumped ones
+    EXPECT_GE(metrics.nodes, 5u * 101u * 102u / 2u);
+    EXPECT_GT(metrics.nodesPerSecond(), 0.0);
+}
+
+TEST_F(MetricsTest, CountsMonteCarloPaths) {
+    pricer::metrics::setEnabled(true);
+    const pricer::MonteCarloEngine engine(20000, 10);
+    (void)engine.simulate(makeOption());
+
+    const pricer::EngineMetrics metrics = pricer::metrics::snapshot().engine(pricer::MetricsEngine::MonteCarlo);
+    EXPECT_EQ(metrics.calls, 1u);
+    EXPECT_EQ(metrics.paths, 20000u);
+    EXPECT_GT(metrics.pathsPerSecond(), 0.0);
+}
+
+TEST_F(MetricsTest, ScopedTimerAndReset) {
+    pricer::metrics::setEnabled(true);
+    {
+        PRICER_METRICS_TIMER(pricer::MetricsEngine::FiniteDifference, 4);
+        PRICER_METRICS_ADD(pricer::MetricsEngine::FiniteDifference, pricer::MetricsCounter::Nodes, 7);
+    }
+    pricer::PricingMetrics snapshot = pricer::metrics::snapshot();
+    EXPECT_EQ(snapshot.engine(pricer::MetricsEngine::FiniteDifference).calls, 1u);
+    EXPECT_EQ(snapshot.engine(pricer::MetricsEngine::FiniteDifference).contracts, 4u);
+    EXPECT_EQ(snapshot.engine(pricer::MetricsEngine::FiniteDifference).nodes, 7u);
+
+    pricer::metrics::reset();
+    snapshot = pricer::metrics::snapshot();
+    EXPECT_EQ(snapshot.engine(pricer::MetricsEngine::FiniteDifference).calls, 0u);
+    EXPECT_EQ(snapshot.engine(pricer::MetricsEngine::FiniteDifference).latency.total(), 0u);
+}
+#endif
+
+TEST_F(MetricsTest, HistogramQuantiles) {
+    pricer::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.quantile(0.5), 0.0);
+
+    histogram.counts[3] = 90;   // [8, 16) ns
+    histogram.counts[10] = 10;  // [1024, 2048) ns
+    EXPECT_EQ(histogram.total(), 100u);
+    EXPECT_EQ(histogram.quantile(0.0), 16.0);
+    EXPECT_EQ(histogram.quantile(0.5), 16.0);
+    EXPECT_EQ(histogram.quantile(0.99), 2048.0);
+}
+
+// Pool counters are always on and include every live pool in the total
+TEST_F(MetricsTest, ThreadPoolCounters) {
+    pricer::ThreadPool pool(2);
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 8; ++i) {
+        futures.push_back(pool.submit([] {}));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    // A task counts as run just after its future is ready
+    pricer::ThreadPoolMetrics metrics = pool.metrics();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (metrics.tasks_run < 8 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+        metrics = pool.metrics();
+    }
+
+    EXPECT_EQ(metrics.workers, 2u);
+    EXPECT_EQ(metrics.tasks_queued, 8u);
+    EXPECT_EQ(metrics.tasks_run, 8u);
+    EXPECT_EQ(metrics.queue_depth, 0u);
+    EXPECT_GE(metrics.max_queue_depth, 1u);
+
+    const pricer::ThreadPoolMetrics total = pricer::metrics::snapshot().thread_pools;
+    EXPECT_GE(total.workers, 2u);
+    EXPECT_GE(total.tasks_queued, metrics.tasks_queued);
+}
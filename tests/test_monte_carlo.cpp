@@ -1,4 +1,5 @@
 #include "pricer/monte_carlo.h"
+#include "pricer/binomial.h"
 #include "pricer/black_scholes.h"
 #include "pricer/option.h"
 #include <gtest/gtest.h>
@@ -6,6 +7,9 @@
 #include <chrono>
 #include <vector>
 #include <numeric>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
 
 class MonteCarloTest : public ::testing::Test {
 protected:
@@ -115,7 +119,8 @@ TEST_F(MonteCarloTest, GreeksVsBlackScholes) {
     EXPECT_NEAR(mc_theta, bs_theta, tolerance * 10); // Wider tolerance for theta
 }
 
-// Test convergence with increasing number of paths
+// Test convergence with increasing number of paths: the standard error
+// shrinks as 1/sqrt(N) and the price stays within it of Black-Scholes
 TEST_F(MonteCarloTest, Convergence) {
     auto option = makeEuropeanCall();
 
@@ -123,18 +128,21 @@ TEST_F(MonteCarloTest, Convergence) {
     double bs_price = option->price();
 
     std::vector<size_t> path_counts = {1000, 10000, 100000, 1000000};
-    std::vector<double> errors;
+    std::vector<double> std_errors;
 
     for (size_t paths : path_counts) {
         auto mc = std::make_shared<pricer::MonteCarloEngine>(paths, 252, true, 8);
         option->setPricingEngine(mc);
-        double price = option->price();
-        errors.push_back(std::abs(price - bs_price));
+        const double price = option->price();
+        const auto ci = mc->getConfidenceInterval(*option);
+        const double std_error = (ci.second - ci.first) / (2.0 * 1.96);
+        EXPECT_NEAR(price, bs_price, 3.0 * std_error) << paths << " paths";
+        std_errors.push_back(std_error);
     }
 
-    // Verify that error decreases with more paths
-    for (size_t i = 1; i < errors.size(); ++i) {
-        EXPECT_LT(errors[i], errors[i-1]);
+    // Ten times the paths should cut the standard error by about sqrt(10)
+    for (size_t i = 1; i < std_errors.size(); ++i) {
+        EXPECT_NEAR(std_errors[i - 1] / std_errors[i], std::sqrt(10.0), 0.5);
     }
 }
 
@@ -152,12 +160,12 @@ TEST_F(MonteCarloTest, AntitheticVarianceReduction) {
 
     for (int i = 0; i < 10; ++i) {
         option->setPricingEngine(mc_no_antithetic);
-        //option->price();  // Calculate price to update confidence interval
+        option->price();  // Calculate price to update confidence interval
         auto ci1 = mc_no_antithetic->getConfidenceInterval(*option);
         errors_no_antithetic.push_back(ci1.second - ci1.first);
 
         option->setPricingEngine(mc_with_antithetic);
-        //option->price();  // Calculate price to update confidence interval
+        option->price();  // Calculate price to update confidence interval
         auto ci2 = mc_with_antithetic->getConfidenceInterval(*option);
         errors_with_antithetic.push_back(ci2.second - ci2.first);
     }
@@ -177,6 +185,9 @@ TEST_F(MonteCarloTest, AntitheticVarianceReduction) {
 
 // Test parallel execution performance
 TEST_F(MonteCarloTest, ParallelPerformance) {
+    if (std::thread::hardware_concurrency() < 2) {
+        GTEST_SKIP() << "Needs more than one core";
+    }
     const auto option = makeEuropeanCall();
 
     // Create single-threaded and multi-threaded engines
@@ -224,4 +235,434 @@ TEST_F(MonteCarloTest, TimeStepSensitivity) {
     for (size_t i = 1; i < errors.size(); ++i) {
         EXPECT_LE(errors[i], errors[i-1] * 1.1);  // Allow 10% tolerance
     }
-}
\ No newline at end of file
+}
+// Test fused Greeks from one path set against Black-Scholes
+TEST_F(MonteCarloTest, CalculateAllVsBlackScholes) {
+    const auto option = makeEuropeanCall();
+
+    option->setPricingEngine(bs_engine);
+    const pricer::PricingResult bs = option->calculateAll();
+
+    mc_engine->setNumPaths(200000);
+    option->setPricingEngine(mc_engine);
+    const pricer::PricingResult mc = option->calculateAll();
+
+    EXPECT_NEAR(mc.price, bs.price, tolerance);
+    EXPECT_NEAR(mc.delta, bs.delta, 0.01);
+    EXPECT_NEAR(mc.gamma, bs.gamma, 0.005);
+    EXPECT_NEAR(mc.theta, bs.theta, 0.005);
+    EXPECT_NEAR(mc.vega, bs.vega, 0.01);
+    EXPECT_NEAR(mc.rho, bs.rho, 0.01);
+}
+
+// Test path generation into a reusable caller buffer
+TEST_F(MonteCarloTest, GeneratePathIntoBuffer) {
+    const auto option = makeEuropeanCall();
+    const pricer::MonteCarloEngine engine(1000, 50, false, 1);
+
+    std::vector<double> path(engine.getNumSteps() + 1);
+    engine.generatePath(*option, 7, path);
+
+    EXPECT_DOUBLE_EQ(path.front(), option->getSpot());
+    for (double s : path) {
+        EXPECT_GT(s, 0.0);
+    }
+
+    std::vector<double> wrong_size(engine.getNumSteps());
+    EXPECT_THROW(engine.generatePath(*option, 7, wrong_size), std::invalid_argument);
+
+    // Path i is a pure function of the seed and i
+    std::vector<double> again(engine.getNumSteps() + 1);
+    engine.generatePath(*option, 7, again);
+    EXPECT_EQ(path, again);
+}
+
+// Test exact terminal sampling against the full path generator
+TEST_F(MonteCarloTest, TerminalSamplingMatchesFullPath) {
+    const auto option = makeEuropeanPut();
+    option->setPricingEngine(bs_engine);
+    const double bs_price = option->price();
+
+    const auto terminal = std::make_shared<pricer::MonteCarloEngine>(200000, 252, true, 4);
+    terminal->setPathSampling(pricer::PathSampling::Terminal);
+    const auto full = std::make_shared<pricer::MonteCarloEngine>(200000, 252, true, 4);
+    full->setPathSampling(pricer::PathSampling::FullPath);
+
+    option->setPricingEngine(terminal);
+    const double terminal_price = option->price();
+    const auto [terminal_lo, terminal_hi] = terminal->getConfidenceInterval(*option);
+
+    option->setPricingEngine(full);
+    const double full_price = option->price();
+
+    EXPECT_NEAR(terminal_price, bs_price, tolerance);
+    EXPECT_NEAR(full_price, bs_price, tolerance);
+    EXPECT_TRUE(bs_price >= terminal_lo && bs_price <= terminal_hi);
+    EXPECT_EQ(pricer::MonteCarloEngine().getPathSampling(), pricer::PathSampling::Automatic);
+}
+
+// Test every Greek estimator against Black-Scholes for calls and puts
+TEST_F(MonteCarloTest, GreekMethodsVsBlackScholes) {
+    const pricer::GreekMethod methods[] = {
+        pricer::GreekMethod::Pathwise,
+        pricer::GreekMethod::LikelihoodRatio,
+        pricer::GreekMethod::CommonRandomNumbers
+    };
+    EXPECT_EQ(pricer::MonteCarloEngine().getGreekMethod(), pricer::GreekMethod::Pathwise);
+
+    std::unique_ptr<pricer::Option> options[] = {makeEuropeanCall(), makeEuropeanPut()};
+    for (const auto& option : options) {
+        option->setPricingEngine(bs_engine);
+        const pricer::PricingResult bs = option->calculateAll();
+
+        for (const auto method : methods) {
+            const auto mc = std::make_shared<pricer::MonteCarloEngine>(400000, 252, true, 4);
+            mc->setGreekMethod(method);
+            option->setPricingEngine(mc);
+            const pricer::PricingResult result = option->calculateAll();
+
+            EXPECT_NEAR(result.price, bs.price, tolerance);
+            EXPECT_NEAR(result.delta, bs.delta, 0.01);
+            EXPECT_NEAR(result.gamma, bs.gamma, 0.001);
+            EXPECT_NEAR(result.theta, bs.theta, 0.001);
+            EXPECT_NEAR(result.vega, bs.vega, 0.01);
+            EXPECT_NEAR(result.rho, bs.rho, 0.01);
+
+            // Individual Greeks come from the same single simulation
+            EXPECT_DOUBLE_EQ(option->delta(), result.delta);
+        }
+    }
+}
+
+// Test that every requested path is simulated regardless of thread count
+TEST_F(MonteCarloTest, ChunkedPathsIndependentOfThreads) {
+    const auto option = makeEuropeanCall();
+
+    const auto single = std::make_shared<pricer::MonteCarloEngine>(20001, 1, false, 1);
+    const auto multi = std::make_shared<pricer::MonteCarloEngine>(20001, 1, false, 3);
+    multi->setThreadPool(std::make_shared<pricer::ThreadPool>(3));
+
+    option->setPricingEngine(single);
+    const double single_price = option->price();
+    option->setPricingEngine(multi);
+    const double multi_price = option->price();
+
+    EXPECT_DOUBLE_EQ(single_price, multi_price);
+}
+
+// Test that prices depend only on the seed and generator, not on threading
+TEST_F(MonteCarloTest, SeededStreamsReproducible) {
+    const auto option = makeEuropeanPut();
+    option->setPricingEngine(bs_engine);
+    const double bs_price = option->price();
+
+    for (const auto generator : {pricer::RandomGenerator::Philox4x32,
+                                 pricer::RandomGenerator::Threefry2x64}) {
+        const auto reference = std::make_shared<pricer::MonteCarloEngine>(100000, 12, true, 1);
+        reference->setRandomGenerator(generator);
+        reference->setPathSampling(pricer::PathSampling::FullPath);
+        reference->setSeed(2025);
+        option->setPricingEngine(reference);
+        const double reference_price = option->price();
+        EXPECT_NEAR(reference_price, bs_price, tolerance);
+
+        const auto threaded = std::make_shared<pricer::MonteCarloEngine>(100000, 12, true, 4);
+        threaded->setThreadPool(std::make_shared<pricer::ThreadPool>(4));
+        threaded->setRandomGenerator(generator);
+        threaded->setPathSampling(pricer::PathSampling::FullPath);
+        threaded->setSeed(2025);
+        option->setPricingEngine(threaded);
+        EXPECT_EQ(option->price(), reference_price);
+
+        threaded->setSeed(2026);
+        EXPECT_NE(option->price(), reference_price);
+    }
+}
+
+// Test randomized QMC accuracy and its reported error against pseudo-random paths
+TEST_F(MonteCarloTest, SobolBrownianBridge) {
+    const auto option = makeEuropeanCall();
+    option->setPricingEngine(bs_engine);
+    const double bs_price = option->price();
+
+    const auto qmc = std::make_shared<pricer::MonteCarloEngine>(1 << 16, 64, false, 4);
+    qmc->setSequenceType(pricer::SequenceType::Sobol);
+    qmc->setPathSampling(pricer::PathSampling::FullPath);
+    option->setPricingEngine(qmc);
+    const double qmc_price = option->price();
+    const auto [qmc_lo, qmc_hi] = qmc->getConfidenceInterval(*option);
+
+    const auto mc = std::make_shared<pricer::MonteCarloEngine>(1 << 16, 64, false, 4);
+    option->setPricingEngine(mc);
+    const double mc_price = option->price();
+    const auto [mc_lo, mc_hi] = mc->getConfidenceInterval(*option);
+
+    EXPECT_NEAR(qmc_price, bs_price, 2e-3);
+    EXPECT_NEAR(mc_price, bs_price, tolerance);
+    EXPECT_TRUE(bs_price >= qmc_lo && bs_price <= qmc_hi);
+    EXPECT_LT((qmc_hi - qmc_lo) * 20.0, mc_hi - mc_lo);
+
+    // Greeks come from the same points
+    const pricer::PricingResult greeks = qmc->calculateAll(*option);
+    option->setPricingEngine(bs_engine);
+    EXPECT_NEAR(greeks.delta, option->delta(), 1e-3);
+    EXPECT_NEAR(greeks.vega, option->vega(), 1e-3);
+
+    // Bridged paths are reproducible per index as well
+    std::vector<double> path(qmc->getNumSteps() + 1);
+    std::vector<double> again(qmc->getNumSteps() + 1);
+    qmc->generatePath(*option, 3, path);
+    qmc->generatePath(*option, 3, again);
+    EXPECT_DOUBLE_EQ(path.front(), option->getSpot());
+    EXPECT_EQ(path, again);
+}
+
+// Test that the control variates narrow the interval without biasing the price
+TEST_F(MonteCarloTest, ControlVariates) {
+    const auto option = makeEuropeanCall();
+    option->setPricingEngine(bs_engine);
+    const double bs_price = option->price();
+
+    auto engine = std::make_shared<pricer::MonteCarloEngine>(1 << 16, 1, false, 4);
+    EXPECT_EQ(engine->getControlVariate(), pricer::ControlVariate::None);
+    option->setPricingEngine(engine);
+    option->price();
+    const auto [plain_lo, plain_hi] = engine->getConfidenceInterval(*option);
+
+    engine->setControlVariate(pricer::ControlVariate::TerminalSpot);
+    const double controlled = option->price();
+    const auto [lo, hi] = engine->getConfidenceInterval(*option);
+    EXPECT_NEAR(controlled, bs_price, tolerance);
+    EXPECT_LT((hi - lo) * 2.0, plain_hi - plain_lo);
+
+    // The price is controlled, the Greeks are unchanged
+    const pricer::PricingResult all = engine->calculateAll(*option);
+    EXPECT_DOUBLE_EQ(all.price, controlled);
+
+    // A European payoff is its own perfect control
+    engine->setControlVariate(pricer::ControlVariate::BlackScholes);
+    EXPECT_NEAR(option->price(), bs_price, 1e-10);
+}
+
+// Test that an adaptive run stops at the target error, at the same path count on any pool
+TEST_F(MonteCarloTest, AdaptiveTargetStdError) {
+    const pricer::OptionParameters option(pricer::OptionType::Call, 100.0, 1.0, 100.0, 0.05, 0.2);
+    const double bs_price = bs_engine->calculate(option);
+
+    pricer::MonteCarloEngine engine(1 << 22, 1, false, 4);
+    engine.setThreadPool(std::make_shared<pricer::ThreadPool>(4));
+    engine.setTargetStdError(0.05);
+    const pricer::PricingResult result = engine.simulate(option);
+    EXPECT_LE(result.std_error, 0.05);
+    EXPECT_GT(result.std_error, 0.04);
+    EXPECT_LT(result.paths, std::size_t{1} << 22);
+    EXPECT_NEAR(result.price, bs_price, 4.0 * result.std_error);
+
+    pricer::MonteCarloEngine serial(1 << 22, 1, false, 1);
+    serial.setTargetStdError(0.05);
+    const pricer::PricingResult again = serial.simulate(option);
+    EXPECT_EQ(again.paths, result.paths);
+    EXPECT_DOUBLE_EQ(again.price, result.price);
+
+    // num_paths still caps the run, and the Greeks use the same paths
+    engine.setTargetStdError(1e-6);
+    engine.setNumPaths(50000);
+    EXPECT_EQ(engine.simulate(option).paths, 50000u);
+    EXPECT_EQ(engine.calculateAll(option).paths, 50000u);
+}
+
+// Test that a time budget ends the run after the first wave of chunks
+TEST_F(MonteCarloTest, AdaptiveTimeBudget) {
+    const pricer::OptionParameters option(pricer::OptionType::Put, 100.0, 1.0, 100.0, 0.05, 0.2);
+
+    pricer::MonteCarloEngine engine(1 << 24, 1, true, 2);
+    engine.setTimeBudget(std::chrono::nanoseconds(1));
+    const pricer::PricingResult result = engine.simulate(option);
+    EXPECT_GT(result.paths, 0u);
+    EXPECT_LT(result.paths, std::size_t{1} << 24);
+    EXPECT_GT(result.std_error, 0.0);
+    EXPECT_NEAR(result.price, bs_engine->calculate(option), 4.0 * result.std_error);
+}
+
+// Test that the standard error survives payoffs whose mean dwarfs their spread
+TEST_F(MonteCarloTest, StableVarianceOfLargePayoffs) {
+    const double spot = 1e8;
+    const double sigma = 1e-9;
+    const std::size_t num_paths = 100000;
+    const pricer::OptionParameters option(pricer::OptionType::Call, 1.0, 1.0, spot, 0.0, sigma);
+
+    const pricer::MonteCarloEngine engine(num_paths, 1, false, 2);
+    const pricer::PricingResult result = engine.simulate(option);
+
+    // S_T - K has standard deviation close to S sigma sqrt(T)
+    const double expected = spot * sigma / std::sqrt(static_cast<double>(num_paths));
+    EXPECT_NEAR(result.std_error / expected, 1.0, 0.02);
+    EXPECT_EQ(result.paths, num_paths);
+}
+
+// Test that American options are priced by least squares, not as European
+TEST_F(MonteCarloTest, LeastSquaresAmericanPut) {
+    const auto option = makeAmericanPut();
+    const double tree_price = pricer::BinomialTreeEngine(2000).calculate(*option);
+    const double european = bs_engine->calculate(*makeEuropeanPut());
+
+    const auto engine = std::make_shared<pricer::MonteCarloEngine>(100000, 50, true, 2);
+    engine->setThreadPool(std::make_shared<pricer::ThreadPool>(2));
+    option->setPricingEngine(engine);
+    const pricer::PricingResult result = engine->simulate(*option);
+
+    EXPECT_EQ(result.paths, 100000u);
+    EXPECT_GT(result.std_error, 0.0);
+    EXPECT_GT(result.price, european + 0.3);
+    EXPECT_NEAR(result.price, tree_price, 0.05);
+    EXPECT_DOUBLE_EQ(option->price(), result.price);
+
+    // Chunks are reduced in order, so the pool size does not matter
+    const pricer::MonteCarloEngine serial(100000, 50, true, 1);
+    EXPECT_DOUBLE_EQ(serial.simulate(*option).price, result.price);
+
+    // Deep in the money the put is exercised today
+    const pricer::OptionParameters deep(pricer::OptionType::Put, 100.0, 1.0, 50.0, 0.05, 0.2, 0.0,
+                                        pricer::ExerciseStyle::American);
+    EXPECT_DOUBLE_EQ(engine->calculate(deep), 50.0);
+
+    // Without dividends the American call is worth the European one
+    const pricer::OptionParameters call(pricer::OptionType::Call, 100.0, 1.0, 100.0, 0.05, 0.2, 0.0,
+                                        pricer::ExerciseStyle::American);
+    const pricer::PricingResult call_result = engine->simulate(call);
+    EXPECT_NEAR(call_result.price, bs_engine->calculate(*makeEuropeanCall()), 4.0 * call_result.std_error);
+}
+
+// Test the American Greeks against a fine tree
+TEST_F(MonteCarloTest, LeastSquaresAmericanGreeks) {
+    const auto option = makeAmericanPut();
+    const pricer::PricingResult tree = pricer::BinomialTreeEngine(2000).calculateAll(*option);
+
+    const pricer::MonteCarloEngine engine(100000, 50, true, 2);
+    const pricer::PricingResult result = engine.calculateAll(*option);
+
+    EXPECT_DOUBLE_EQ(result.price, engine.calculate(*option));
+    EXPECT_NEAR(result.delta, tree.delta, 0.01);
+    EXPECT_NEAR(result.gamma, tree.gamma, 0.005);
+    EXPECT_NEAR(result.theta, tree.theta, 0.002);
+    EXPECT_NEAR(result.vega, tree.vega, 0.04);
+    EXPECT_NEAR(result.rho, tree.rho, 0.04);
+}
+
+namespace {
+    double standardNormalCdf(const double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+}
+
+// Test the discrete geometric Asian against its closed form, and the arithmetic one against it
+TEST_F(MonteCarloTest, AsianPayoffs) {
+    const double S = 100.0, K = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    const std::size_t dates = 12;
+    const pricer::OptionParameters option(pricer::OptionType::Call, K, T, S, r, sigma);
+
+    // log G is normal: mean over the dates of log S_t, variance sigma^2 * mean of min(t_i, t_j)
+    double mean_time = 0.0;
+    double covariance = 0.0;
+    for (std::size_t i = 1; i <= dates; ++i) {
+        mean_time += i * T / dates / dates;
+        for (std::size_t j = 1; j <= dates; ++j) {
+            covariance += std::min(i, j) * T / dates / (dates * dates);
+        }
+    }
+    const double mu = std::log(S) + (r - 0.5 * sigma * sigma) * mean_time;
+    const double var = sigma * sigma * covariance;
+    const double d1 = (mu - std::log(K) + var) / std::sqrt(var);
+    const double geometric = std::exp(-r * T) * (std::exp(mu + 0.5 * var) * standardNormalCdf(d1)
+                                                 - K * standardNormalCdf(d1 - std::sqrt(var)));
+
+    pricer::MonteCarloEngine engine(100000, dates, true, 2);
+    engine.setPayoff(pricer::AsianPayoff{pricer::AsianAveraging::Geometric});
+    const pricer::PricingResult result = engine.simulate(option);
+    EXPECT_NEAR(result.price, geometric, 4.0 * result.std_error);
+
+    // Averaging lowers the price; the arithmetic mean is never below the geometric one
+    engine.setPayoff(pricer::AsianPayoff{});
+    const double arithmetic = engine.calculate(option);
+    EXPECT_GT(arithmetic, result.price);
+    EXPECT_LT(arithmetic, bs_engine->calculate(option));
+}
+
+// Test the bridge-corrected barrier against the continuously monitored closed form
+TEST_F(MonteCarloTest, BarrierPayoffs) {
+    const double S = 100.0, K = 100.0, T = 1.0, r = 0.05, sigma = 0.2, B = 90.0;
+    const pricer::OptionParameters option(pricer::OptionType::Call, K, T, S, r, sigma);
+
+    // Down-and-in call with B < K (Reiner-Rubinstein), and in-out parity
+    const double lambda = (r + 0.5 * sigma * sigma) / (sigma * sigma);
+    const double y = std::log(B * B / (S * K)) / (sigma * std::sqrt(T)) + lambda * sigma * std::sqrt(T);
+    const double down_in = S * std::pow(B / S, 2.0 * lambda) * standardNormalCdf(y)
+                           - K * std::exp(-r * T) * std::pow(B / S, 2.0 * lambda - 2.0)
+                             * standardNormalCdf(y - sigma * std::sqrt(T));
+    const double down_out = bs_engine->calculate(option) - down_in;
+
+    pricer::MonteCarloEngine engine(100000, 50, true, 2);
+    engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::DownAndOut, B});
+    const pricer::PricingResult out = engine.simulate(option);
+    EXPECT_NEAR(out.price, down_out, 4.0 * out.std_error);
+
+    engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::DownAndIn, B});
+    const pricer::PricingResult in = engine.simulate(option);
+    EXPECT_NEAR(in.price, down_in, 4.0 * in.std_error);
+
+    // Checking only at the dates misses crossings, so the knock-out is worth more
+    engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::DownAndOut, B, 0.0, false});
+    EXPECT_GT(engine.calculate(option), down_out + 0.3);
+
+    // Starting beyond the barrier, a knock-out pays only its rebate
+    engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::UpAndOut, 95.0, 2.0});
+    EXPECT_NEAR(engine.calculate(option), 2.0 * std::exp(-r * T), 1e-12);
+
+    EXPECT_THROW(engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::UpAndOut, 0.0}), std::invalid_argument);
+    EXPECT_THROW(engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::UpAndOut, 120.0, -1.0}),
+                 std::invalid_argument);
+}
+
+// Test the corrected floating-strike lookback against the continuously monitored closed form
+TEST_F(MonteCarloTest, LookbackPayoffs) {
+    const double S = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    const pricer::OptionParameters option(pricer::OptionType::Call, 100.0, T, S, r, sigma);
+
+    // Goldman-Sosin-Gatto with the running minimum at today's spot
+    const double a1 = (r + 0.5 * sigma * sigma) * std::sqrt(T) / sigma;
+    const double a2 = a1 - sigma * std::sqrt(T);
+    const double a3 = (-r + 0.5 * sigma * sigma) * std::sqrt(T) / sigma;
+    const double ratio = sigma * sigma / (2.0 * r);
+    const double exact = S * standardNormalCdf(a1) - S * ratio * standardNormalCdf(-a1)
+                         - S * std::exp(-r * T) * (standardNormalCdf(a2) - ratio * standardNormalCdf(-a3));
+
+    pricer::MonteCarloEngine engine(100000, 100, true, 2);
+    engine.setPayoff(pricer::LookbackPayoff{});
+    const pricer::PricingResult corrected = engine.simulate(option);
+    EXPECT_NEAR(corrected.price, exact, 4.0 * corrected.std_error + 0.01 * exact);
+
+    engine.setPayoff(pricer::LookbackPayoff{pricer::LookbackStrike::Floating, false});
+    EXPECT_LT(engine.calculate(option), exact - 0.5);
+
+    // A fixed-strike call on the maximum is worth more than the European call
+    engine.setPayoff(pricer::LookbackPayoff{pricer::LookbackStrike::Fixed});
+    EXPECT_GT(engine.calculate(option), bs_engine->calculate(option));
+}
+
+// Test that path-dependent Greeks come from repricing, and that they are European only
+TEST_F(MonteCarloTest, PathDependentGreeks) {
+    const pricer::OptionParameters option(pricer::OptionType::Call, 100.0, 1.0, 100.0, 0.05, 0.2);
+    pricer::MonteCarloEngine engine(50000, 50, true, 2);
+    engine.setPayoff(pricer::BarrierPayoff{pricer::BarrierType::DownAndOut, 90.0});
+
+    const pricer::PricingResult result = engine.calculateAll(option);
+    EXPECT_DOUBLE_EQ(result.price, engine.calculate(option));
+    // The barrier below the spot adds to the vanilla delta
+    EXPECT_GT(result.delta, bs_engine->calculateDelta(option));
+    EXPECT_GT(result.vega, 0.0);
+    EXPECT_LT(result.vega, bs_engine->calculateVega(option));
+
+    const pricer::OptionParameters american(pricer::OptionType::Call, 100.0, 1.0, 100.0, 0.05, 0.2, 0.0,
+                                            pricer::ExerciseStyle::American);
+    EXPECT_THROW(engine.calculate(american), std::invalid_argument);
+}
@@ -0,0 +1,100 @@
+#include "pricer/black_scholes.h"
+#include "pricer/normal.h"
+#include "pricer/utils.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Extended-precision reference; erfc alone loses digits to the rounding of -x/sqrt(2)
+double referenceCDF(double x) {
+    return static_cast<double>(0.5L * std::erfc(-static_cast<long double>(x) / std::sqrt(2.0L)));
+}
+
+} // namespace
+
+class NormalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (double x = -37.0; x <= 8.5; x += 0.0137) {
+            grid.push_back(x);
+        }
+    }
+
+    std::vector<double> grid;
+};
+
+TEST_F(NormalTest, CDFAccuracyTiers) {
+    for (double x : grid) {
+        const double ref = referenceCDF(x);
+        EXPECT_NEAR(pricer::normalCDF(x), ref, 1e-14 * ref + 1e-300) << "x = " << x;
+        EXPECT_NEAR(pricer::normalCDF(x, pricer::NormalAccuracy::Fast), ref, 1e-7 * ref + 1e-15) << "x = " << x;
+    }
+
+    EXPECT_DOUBLE_EQ(pricer::normalCDF(0.0), 0.5);
+    EXPECT_EQ(pricer::normalCDF(-40.0), 0.0);
+    EXPECT_EQ(pricer::normalCDF(40.0), 1.0);
+}
+
+TEST_F(NormalTest, PDFAndInverse) {
+    for (double x : grid) {
+        EXPECT_NEAR(pricer::normalPDF(x), std::exp(-0.5 * x * x) / std::sqrt(2.0 * M_PI),
+                    1e-14 * pricer::normalPDF(x)) << "x = " << x;
+    }
+
+    for (double p : {1e-300, 1e-20, 1e-8, 0.01, 0.2, 0.5, 0.7, 0.975, 1.0 - 1e-12}) {
+        const double x = pricer::inverseNormalCDF(p);
+        EXPECT_NEAR(referenceCDF(x), p, 1e-13 * std::min(p, 1.0 - p) + 1e-16 * p) << "p = " << p;
+    }
+    EXPECT_THROW(pricer::utils::inverseNormalCDF(0.0), std::invalid_argument);
+    EXPECT_THROW(pricer::utils::inverseNormalCDF(1.0), std::invalid_argument);
+}
+
+TEST_F(NormalTest, SpanOverloadsMatchScalar) {
+    std::vector<double> cdf(grid.size()), fast(grid.size()), pdf(grid.size());
+    pricer::normalCDF(grid, cdf);
+    pricer::normalCDF(grid, fast, pricer::NormalAccuracy::Fast);
+    pricer::normalPDF(grid, pdf);
+    for (size_t i = 0; i < grid.size(); ++i) {
+        EXPECT_DOUBLE_EQ(cdf[i], pricer::normalCDF(grid[i]));
+        EXPECT_DOUBLE_EQ(fast[i], pricer::normalCDF(grid[i], pricer::NormalAccuracy::Fast));
+        EXPECT_DOUBLE_EQ(pdf[i], pricer::normalPDF(grid[i]));
+        EXPECT_DOUBLE_EQ(cdf[i], pricer::utils::normalCDF(grid[i]));
+    }
+
+    std::vector<double> p(cdf.begin() + 1000, cdf.end() - 100), x(p.size());
+    pricer::inverseNormalCDF(p, x);
+    for (size_t i = 0; i < p.size(); ++i) {
+        EXPECT_DOUBLE_EQ(x[i], pricer::inverseNormalCDF(p[i]));
+    }
+
+    std::vector<double> shortOut(3);
+    EXPECT_THROW(pricer::normalCDF(grid, shortOut), std::invalid_argument);
+    EXPECT_THROW(pricer::normalPDF(grid, shortOut), std::invalid_argument);
+    EXPECT_THROW(pricer::inverseNormalCDF(grid, shortOut), std::invalid_argument);
+}
+
+TEST_F(NormalTest, BlackScholesPathsAgree) {
+    const size_t n = 64;
+    std::vector<double> spot(n, 100.0), strike(n), expiry(n, 0.75), rate(n, 0.04), vol(n), dividend(n, 0.01), out(n);
+    std::vector<pricer::OptionType> type(n);
+    for (size_t i = 0; i < n; ++i) {
+        strike[i] = 40.0 + 2.5 * i;
+        vol[i] = 0.05 + 0.01 * (i % 20);
+        type[i] = i % 2 ? pricer::OptionType::Put : pricer::OptionType::Call;
+    }
+
+    for (auto accuracy : {pricer::NormalAccuracy::Full, pricer::NormalAccuracy::Fast}) {
+        pricer::BlackScholesPricingEngine engine;
+        engine.setNormalAccuracy(accuracy);
+        engine.priceBatch(spot, strike, expiry, rate, vol, dividend, type, out);
+        for (size_t i = 0; i < n; ++i) {
+            const pricer::OptionParameters option(type[i], strike[i], expiry[i], spot[i], rate[i], vol[i], dividend[i]);
+            const double scalar = engine.calculate(option);
+            EXPECT_NEAR(out[i], scalar, 1e-12 * (1.0 + scalar)) << "contract " << i;
+        }
+    }
+}
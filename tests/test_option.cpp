@@ -0,0 +1,162 @@
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/monte_carlo.h"
+#include "pricer/option.h"
+#include "pricer/thread_pool.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+class OptionParametersTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<pricer::Option> makeAmericanPut() {
+        return std::make_unique<pricer::AmericanOption>(
+            pricer::OptionType::Put,
+            100.0,  // Strike
+            1.0,    // Expiry
+            100.0,  // Spot
+            0.05,   // Rate
+            0.2,    // Volatility
+            0.0     // No dividend
+        );
+    }
+};
+
+// Test that snapshots copy the option and bumps leave the original alone
+TEST_F(OptionParametersTest, SnapshotsAndBumps) {
+    const auto option = makeAmericanPut();
+    const pricer::OptionParameters params = option->parameters();
+
+    EXPECT_EQ(params.getType(), pricer::OptionType::Put);
+    EXPECT_TRUE(params.isAmerican());
+    EXPECT_DOUBLE_EQ(params.getStrike(), 100.0);
+
+    const pricer::OptionParameters bumped = params.withSpot(101.0).withVolatility(0.25);
+    EXPECT_DOUBLE_EQ(bumped.getSpot(), 101.0);
+    EXPECT_DOUBLE_EQ(bumped.getVolatility(), 0.25);
+    EXPECT_DOUBLE_EQ(params.getSpot(), 100.0);
+    EXPECT_TRUE(bumped.isAmerican());
+
+    EXPECT_THROW((void)params.withVolatility(-0.1), std::invalid_argument);
+    EXPECT_THROW(pricer::OptionParameters(pricer::OptionType::Call, 100.0, 0.0, 100.0, 0.05, 0.2),
+                 std::invalid_argument);
+}
+
+// Test that one engine and one option can be priced from many threads at once
+TEST_F(OptionParametersTest, SharedEngineAcrossThreads) {
+    const auto option = makeAmericanPut();
+    const auto engine = std::make_shared<pricer::BinomialTreeEngine>(500);
+    option->setPricingEngine(engine);
+    const pricer::PricingResult expected = option->calculateAll();
+
+    pricer::ThreadPool pool(4);
+    std::vector<pricer::PricingResult> results(32);
+    pool.parallelFor(results.size(), [&](size_t i) { results[i] = option->calculateAll(); });
+
+    for (const auto& result : results) {
+        EXPECT_DOUBLE_EQ(result.price, expected.price);
+        EXPECT_DOUBLE_EQ(result.delta, expected.delta);
+        EXPECT_DOUBLE_EQ(result.vega, expected.vega);
+    }
+    EXPECT_DOUBLE_EQ(option->getVolatility(), 0.2);
+}
+
+// Test that simulation statistics travel with the result
+TEST_F(OptionParametersTest, MonteCarloStatisticsInResult) {
+    const pricer::OptionParameters params(pricer::OptionType::Call, 100.0, 1.0, 100.0, 0.05, 0.2);
+    const pricer::MonteCarloEngine engine(20000, 1, false, 2);
+
+    const pricer::PricingResult result = engine.simulate(params);
+    EXPECT_GT(result.std_error, 0.0);
+    EXPECT_DOUBLE_EQ(result.price, engine.calculate(params));
+    EXPECT_DOUBLE_EQ(engine.calculateAll(params).std_error, result.std_error);
+
+    const auto [lo, hi] = result.confidenceInterval();
+    EXPECT_EQ(engine.getConfidenceInterval(params), result.confidenceInterval());
+    EXPECT_NEAR(hi - lo, 2.0 * 1.96 * result.std_error, 1e-12);
+
+    // Closed-form engines report no error
+    EXPECT_DOUBLE_EQ(pricer::BlackScholesPricingEngine().calculateAll(params).std_error, 0.0);
+}
+
+// Test that plain values build options, snapshots and batches
+TEST_F(OptionParametersTest, ContractValueTypes) {
+    const pricer::ContractSpec contract{100.0, 1.0, pricer::OptionType::Put, pricer::ExerciseStyle::European};
+    const pricer::MarketState market{100.0, 0.05, 0.2, 0.0};
+
+    // The wrapper classes fix the exercise style whatever the spec says
+    const pricer::AmericanOption american(contract, market);
+    EXPECT_EQ(american.getExercise(), pricer::ExerciseStyle::American);
+    EXPECT_DOUBLE_EQ(american.getVolatility(), 0.2);
+
+    const auto binomial = std::make_shared<pricer::BinomialTreeEngine>(200);
+    const auto wrapped = makeAmericanPut();
+    wrapped->setPricingEngine(binomial);
+    EXPECT_DOUBLE_EQ(binomial->calculate({american.contract(), market}), wrapped->price());
+
+    pricer::ContractBatch batch;
+    batch.reserve(3);
+    for (const double strike : {90.0, 100.0, 110.0}) {
+        batch.add({strike, 1.0, pricer::OptionType::Call}, market);
+    }
+    EXPECT_EQ(batch.size(), 3u);
+    EXPECT_THROW(batch.add({100.0, -1.0}, market), std::invalid_argument);
+    EXPECT_EQ(batch.size(), 3u);
+
+    const pricer::BlackScholesPricingEngine bs;
+    std::vector<double> prices(batch.size());
+    bs.priceBatch(batch, prices);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_NEAR(prices[i], bs.calculate({batch.contract(i), batch.market(i)}), 1e-12);
+    }
+}
+
+// Contracts sharing spot, rate, dividend and expiry share one entry of expiry terms
+TEST_F(OptionParametersTest, BatchExpiryTerms) {
+    const pricer::MarketState first{100.0, 0.05, 0.2, 0.01};
+    const pricer::MarketState second{50.0, 0.05, 0.3, 0.01};
+
+    pricer::ContractBatch batch;
+    for (const double expiry : {0.5, 2.0}) {
+        for (const double strike : {90.0, 100.0, 110.0}) {
+            batch.add({strike, expiry, pricer::OptionType::Call}, first);
+            batch.add({strike / 2.0, expiry, pricer::OptionType::Put}, second);
+        }
+    }
+    // Only the volatility differs, so this reuses the first entry
+    batch.add({100.0, 0.5, pricer::OptionType::Call}, {100.0, 0.05, 0.4, 0.01});
+
+    ASSERT_EQ(batch.expiryTerms().size(), 4u);
+    ASSERT_EQ(batch.termIndices().size(), batch.size());
+    EXPECT_EQ(batch.termIndices()[0], batch.termIndices()[2]);
+    EXPECT_EQ(batch.termIndices()[0], batch.termIndices()[batch.size() - 1]);
+    EXPECT_NE(batch.termIndices()[0], batch.termIndices()[1]);
+    EXPECT_NE(batch.termIndices()[0], batch.termIndices()[6]);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const pricer::ExpiryTerms& terms = batch.expiryTerms()[batch.termIndices()[i]];
+        const double T = batch.expiries()[i];
+        const double r = batch.rates()[i];
+        const double q = batch.dividends()[i];
+        EXPECT_DOUBLE_EQ(terms.sqrt_expiry, std::sqrt(T));
+        EXPECT_DOUBLE_EQ(terms.rate_discount, std::exp(-r * T));
+        EXPECT_DOUBLE_EQ(terms.dividend_discount, std::exp(-q * T));
+        EXPECT_DOUBLE_EQ(terms.log_forward, std::log(batch.spots()[i]) + (r - q) * T);
+    }
+
+    // Priced through the shared terms, the batch matches the scalar formulas
+    const pricer::BlackScholesPricingEngine bs;
+    std::vector<double> prices(batch.size());
+    bs.priceBatch(batch, prices);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_NEAR(prices[i], bs.calculate({batch.contract(i), batch.market(i)}), 1e-12);
+    }
+
+    batch.clear();
+    EXPECT_TRUE(batch.expiryTerms().empty());
+    batch.add({100.0, 1.0}, second);
+    EXPECT_EQ(batch.termIndices()[0], 0u);
+    EXPECT_DOUBLE_EQ(batch.expiryTerms()[0].log_forward, std::log(50.0) + 0.04);
+}
@@ -0,0 +1,66 @@
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/portfolio.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+class PortfolioTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        bs_engine = pricer::makeBlackScholesPricingEngine();
+        bin_engine = pricer::makeBinomialTreeEngine(200);
+
+        // Alternate engines so both groups interleave in position order
+        for (int i = 0; i < 40; ++i) {
+            const pricer::ContractSpec contract{80.0 + i, 0.25 + 0.05 * (i % 5),
+                                                i % 2 ? pricer::OptionType::Put : pricer::OptionType::Call,
+                                                i % 3 ? pricer::ExerciseStyle::European : pricer::ExerciseStyle::American};
+            const pricer::MarketState market{100.0, 0.03, 0.15 + 0.01 * (i % 7), 0.01};
+            book.add(contract, market, i % 4 ? 10.0 : -5.0, i % 3 ? bs_engine : bin_engine);
+        }
+    }
+
+    std::shared_ptr<pricer::PricingEngine> bs_engine;
+    std::shared_ptr<pricer::PricingEngine> bin_engine;
+    pricer::Portfolio book;
+};
+
+// Test that positions keep their order and engines are grouped
+TEST_F(PortfolioTest, GroupsByEngine) {
+    EXPECT_EQ(book.size(), 40u);
+    ASSERT_EQ(book.groups().size(), 2u);
+    EXPECT_EQ(&book.engine(0), bin_engine.get());
+    EXPECT_EQ(&book.engine(1), bs_engine.get());
+    EXPECT_DOUBLE_EQ(book.contract(7).strike, 87.0);
+    EXPECT_DOUBLE_EQ(book.quantity(4), -5.0);
+
+    EXPECT_THROW(book.add({100.0, 1.0}, {100.0, 0.0, 0.2, 0.0}, 1.0, nullptr), std::invalid_argument);
+}
+
+// Test per-position results and book totals against pricing one by one
+TEST_F(PortfolioTest, MatchesPositionByPosition) {
+    pricer::PortfolioPricer pricer(std::make_shared<pricer::ThreadPool>(4));
+    pricer.setChunkSize(3);
+    const pricer::PortfolioResult result = pricer.price(book);
+    ASSERT_EQ(result.positions.size(), book.size());
+
+    pricer::PricingResult total;
+    for (size_t p = 0; p < book.size(); ++p) {
+        const pricer::PricingResult expected = book.engine(p).calculateAll({book.contract(p), book.market(p)});
+        EXPECT_NEAR(result.positions[p].price, expected.price, 1e-10);
+        EXPECT_NEAR(result.positions[p].delta, expected.delta, 1e-10);
+        EXPECT_NEAR(result.positions[p].gamma, expected.gamma, 1e-10);
+        EXPECT_NEAR(result.positions[p].theta, expected.theta, 1e-10);
+        EXPECT_NEAR(result.positions[p].vega, expected.vega, 1e-10);
+        total.price += book.quantity(p) * expected.price;
+        total.delta += book.quantity(p) * expected.delta;
+    }
+    EXPECT_NEAR(result.total.price, total.price, 1e-8);
+    EXPECT_NEAR(result.total.delta, total.delta, 1e-8);
+
+    // Totals are reduced in position order, whatever the chunking
+    pricer.setChunkSize(64);
+    EXPECT_DOUBLE_EQ(pricer.price(book).total.price, result.total.price);
+    EXPECT_THROW(pricer.setChunkSize(0), std::invalid_argument);
+}
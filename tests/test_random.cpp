@@ -0,0 +1,61 @@
+#include "pricer/random.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+// Test the block functions against the Random123 known-answer vectors
+TEST(RandomTest, KnownAnswerVectors) {
+    const auto philox_zero = pricer::philox4x32({0, 0, 0, 0}, {0, 0});
+    EXPECT_EQ(philox_zero[0], 0x6627e8d5u);
+    EXPECT_EQ(philox_zero[1], 0xe169c58du);
+    EXPECT_EQ(philox_zero[2], 0xbc57ac4cu);
+    EXPECT_EQ(philox_zero[3], 0x9b00dbd8u);
+
+    const auto philox_ones = pricer::philox4x32(
+        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+    EXPECT_EQ(philox_ones[0], 0x408f276du);
+    EXPECT_EQ(philox_ones[3], 0x6d5451fdu);
+
+    const auto threefry_zero = pricer::threefry2x64({0, 0}, {0, 0});
+    EXPECT_EQ(threefry_zero[0], 0xc2b6e3a8c2c69865ull);
+    EXPECT_EQ(threefry_zero[1], 0x6f81ed42f350084dull);
+}
+
+// Test the inverse normal CDF by mapping back through erfc
+TEST(RandomTest, InverseNormalCDF) {
+    EXPECT_DOUBLE_EQ(pricer::inverseNormalCDF(0.5), 0.0);
+    EXPECT_NEAR(pricer::inverseNormalCDF(0.975), 1.959963984540054, 1e-14);
+
+    for (const double p : {1e-300, 1e-20, 1e-8, 0.001, 0.02425, 0.1, 0.3, 0.6, 0.9, 0.999}) {
+        const double x = pricer::inverseNormalCDF(p);
+        const double back = 0.5 * std::erfc(-x / std::sqrt(2.0));
+        EXPECT_NEAR(back / p, 1.0, 1e-12) << "p = " << p;
+    }
+
+    // 0.25 and 0.75 are exact, so symmetry can be checked tightly
+    EXPECT_DOUBLE_EQ(pricer::inverseNormalCDF(0.75), -pricer::inverseNormalCDF(0.25));
+}
+
+// Test that block fills match single draws and look standard normal
+TEST(RandomTest, StreamsAreStandardNormal) {
+    for (const auto generator : {pricer::RandomGenerator::Philox4x32,
+                                 pricer::RandomGenerator::Threefry2x64}) {
+        const pricer::CounterBasedRng rng(generator, 42);
+        std::vector<double> z(200000);
+        rng.normals(1000, 3, z);
+
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (size_t i = 0; i < z.size(); ++i) {
+            sum += z[i];
+            sum_sq += z[i] * z[i];
+        }
+        EXPECT_EQ(z[17], rng.normal(1017, 3));
+        EXPECT_NEAR(sum / z.size(), 0.0, 0.01);
+        EXPECT_NEAR(sum_sq / z.size(), 1.0, 0.01);
+
+        // A different draw or seed gives a different stream
+        EXPECT_NE(rng.normal(1017, 4), z[17]);
+        EXPECT_NE(pricer::CounterBasedRng(generator, 43).normal(1017, 3), z[17]);
+    }
+}
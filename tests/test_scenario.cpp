@@ -0,0 +1,135 @@
+#include "pricer/binomial.h"
+#include "pricer/black_scholes.h"
+#include "pricer/monte_carlo.h"
+#include "pricer/scenario.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+class ScenarioTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        bs_engine = pricer::makeBlackScholesPricingEngine();
+        bin_engine = pricer::makeBinomialTreeEngine(100);
+
+        // Two underlyings and both engines, interleaved in position order
+        for (int i = 0; i < 12; ++i) {
+            const pricer::ContractSpec contract{90.0 + 2.0 * i, 0.5 + 0.25 * (i % 2),
+                                                i % 3 ? pricer::OptionType::Call : pricer::OptionType::Put,
+                                                i % 4 == 1 ? pricer::ExerciseStyle::American : pricer::ExerciseStyle::European};
+            const pricer::MarketState market{i % 2 ? 100.0 : 50.0 + i, 0.03, 0.2 + 0.01 * (i % 3), 0.01};
+            book.add(contract, market, i % 5 ? 3.0 : -2.0, i % 4 == 1 ? bin_engine : bs_engine);
+        }
+    }
+
+    static pricer::OptionParameters shifted(const pricer::Portfolio& portfolio, const size_t p,
+                                            const double spot_shift, const double volatility_shift) {
+        pricer::MarketState market = portfolio.market(p);
+        market.spot *= 1.0 + spot_shift;
+        market.volatility += volatility_shift;
+        return {portfolio.contract(p), market};
+    }
+
+    std::shared_ptr<pricer::PricingEngine> bs_engine;
+    std::shared_ptr<pricer::PricingEngine> bin_engine;
+    pricer::Portfolio book;
+};
+
+// Test that ladders are symmetric with an exact zero in the middle
+TEST_F(ScenarioTest, LadderGrid) {
+    const pricer::ScenarioGrid grid = pricer::ScenarioGrid::ladder(0.2, 21, 0.05, 3);
+    ASSERT_EQ(grid.spot_shifts.size(), 21u);
+    ASSERT_EQ(grid.volatility_shifts.size(), 3u);
+    EXPECT_EQ(grid.size(), 63u);
+    EXPECT_DOUBLE_EQ(grid.spot_shifts.front(), -0.2);
+    EXPECT_DOUBLE_EQ(grid.spot_shifts.back(), 0.2);
+    EXPECT_EQ(grid.spot_shifts[10], 0.0);
+    EXPECT_DOUBLE_EQ(grid.spot_shifts[11], 0.02);
+    EXPECT_DOUBLE_EQ(grid.volatility_shifts[0], -0.05);
+
+    EXPECT_EQ(pricer::ScenarioGrid::ladder(0.1, 1).spot_shifts, std::vector<double>{0.0});
+    EXPECT_EQ(pricer::ScenarioGrid::ladder(0.1, 5).volatility_shifts, std::vector<double>{0.0});
+    EXPECT_THROW((void)pricer::ScenarioGrid::ladder(0.1, 0), std::invalid_argument);
+    EXPECT_THROW((void)pricer::ScenarioGrid::ladder(-0.1, 3), std::invalid_argument);
+}
+
+// Test every cell of the cube and the book values against shifting and
+// pricing one position at a time
+TEST_F(ScenarioTest, MatchesShiftedPositions) {
+    const pricer::ScenarioGrid grid = pricer::ScenarioGrid::ladder(0.1, 5, 0.04, 3);
+    pricer::ScenarioPricer scenario_pricer(std::make_shared<pricer::ThreadPool>(3));
+    scenario_pricer.setChunkSize(20);  // Forces one position per task
+    const pricer::ScenarioCube cube = scenario_pricer.price(book, grid);
+
+    ASSERT_EQ(cube.positions, book.size());
+    ASSERT_EQ(cube.prices.size(), book.size() * grid.size());
+    EXPECT_TRUE(cube.results.empty());
+    ASSERT_EQ(cube.book.size(), grid.size());
+
+    for (size_t s = 0; s < grid.spot_shifts.size(); ++s) {
+        for (size_t v = 0; v < grid.volatility_shifts.size(); ++v) {
+            double book_value = 0.0;
+            for (size_t p = 0; p < book.size(); ++p) {
+                const double expected =
+                    book.engine(p).calculate(shifted(book, p, grid.spot_shifts[s], grid.volatility_shifts[v]));
+                EXPECT_NEAR(cube.price(p, s, v), expected, 1e-10) << p << ' ' << s << ' ' << v;
+                book_value += book.quantity(p) * expected;
+            }
+            EXPECT_NEAR(cube.bookValue(s, v), book_value, 1e-8);
+        }
+    }
+
+    // The unshifted scenario reprices the book as it is
+    for (size_t p = 0; p < book.size(); ++p) {
+        EXPECT_NEAR(cube.price(p, 2, 1), book.engine(p).calculate({book.contract(p), book.market(p)}), 1e-10);
+    }
+}
+
+// Test that Greeks mode fills results consistently with prices
+TEST_F(ScenarioTest, GreeksPerScenario) {
+    const pricer::ScenarioGrid grid = pricer::ScenarioGrid::ladder(0.05, 3, 0.02, 2);
+    const pricer::ScenarioPricer scenario_pricer;
+    const pricer::ScenarioCube cube = scenario_pricer.price(book, grid, true);
+    ASSERT_EQ(cube.results.size(), cube.prices.size());
+
+    for (size_t p = 0; p < book.size(); ++p) {
+        for (size_t s = 0; s < grid.spot_shifts.size(); ++s) {
+            for (size_t v = 0; v < grid.volatility_shifts.size(); ++v) {
+                const pricer::PricingResult expected =
+                    book.engine(p).calculateAll(shifted(book, p, grid.spot_shifts[s], grid.volatility_shifts[v]));
+                const pricer::PricingResult& result = cube.results[cube.index(p, s, v)];
+                EXPECT_EQ(result.price, cube.price(p, s, v));
+                EXPECT_NEAR(result.price, expected.price, 1e-10);
+                EXPECT_NEAR(result.delta, expected.delta, 1e-10);
+                EXPECT_NEAR(result.vega, expected.vega, 1e-10);
+            }
+        }
+    }
+}
+
+// Test that Monte Carlo scenarios run on common random numbers: each cell
+// equals a standalone price and the ladder is smooth in spot
+TEST_F(ScenarioTest, MonteCarloCommonRandomNumbers) {
+    pricer::Portfolio mc_book;
+    mc_book.add({100.0, 1.0}, {100.0, 0.05, 0.2, 0.0}, 1.0, pricer::makeMonteCarloEngine(4000, 1));
+
+    const pricer::ScenarioGrid grid = pricer::ScenarioGrid::ladder(0.1, 11);
+    const pricer::ScenarioCube cube = pricer::ScenarioPricer().price(mc_book, grid);
+    for (size_t s = 0; s < grid.spot_shifts.size(); ++s) {
+        EXPECT_EQ(cube.price(0, s, 0), mc_book.engine(0).calculate(shifted(mc_book, 0, grid.spot_shifts[s], 0.0)));
+        if (s > 0) {
+            EXPECT_GT(cube.price(0, s, 0), cube.price(0, s - 1, 0));
+        }
+    }
+}
+
+// Test that shifts leaving the valid range are rejected
+TEST_F(ScenarioTest, RejectsInvalidShifts) {
+    const pricer::ScenarioPricer scenario_pricer;
+    EXPECT_THROW((void)scenario_pricer.price(book, {{-1.0}, {0.0}}), std::invalid_argument);
+    EXPECT_THROW((void)scenario_pricer.price(book, {{0.0}, {-0.5}}), std::invalid_argument);
+    EXPECT_THROW((void)scenario_pricer.price(book, {{}, {0.0}}), std::invalid_argument);
+
+    pricer::ScenarioPricer sized;
+    EXPECT_THROW(sized.setChunkSize(0), std::invalid_argument);
+}
@@ -0,0 +1,85 @@
+#include "pricer/sobol.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+// Test the first points and the primitive polynomial order of Joe & Kuo
+TEST(SobolTest, MatchesReferenceSequence) {
+    const pricer::SobolSequence sobol(21);
+    const double expected[8][2] = {
+        {0.0, 0.0}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75},
+        {0.375, 0.375}, {0.875, 0.875}, {0.625, 0.125}, {0.125, 0.625}
+    };
+    for (size_t n = 0; n < 8; ++n) {
+        EXPECT_DOUBLE_EQ(sobol.coordinate(n, 0) * 0x1.0p-32, expected[n][0]);
+        EXPECT_DOUBLE_EQ(sobol.coordinate(n, 1) * 0x1.0p-32, expected[n][1]);
+    }
+
+    // x + 1, x^2 + x + 1, x^3 + x + 1, ..., x^7 + x^3 + 1
+    EXPECT_EQ(sobol.polynomial(1), 0x3u);
+    EXPECT_EQ(sobol.polynomial(2), 0x7u);
+    EXPECT_EQ(sobol.polynomial(3), 0xbu);
+    EXPECT_EQ(sobol.polynomial(13), 0x43u);
+    EXPECT_EQ(sobol.polynomial(20), 0x89u);
+
+    EXPECT_THROW(pricer::SobolSequence(0), std::invalid_argument);
+}
+
+// Test that every dimension, scrambled or not, stratifies 2^k points
+TEST(SobolTest, ScrambledPointsStayStratified) {
+    const pricer::SobolSequence sobol(300);
+    constexpr size_t points = 1024;
+
+    for (const size_t dim : {0, 1, 7, 50, 299}) {
+        for (const bool scramble : {false, true}) {
+            std::set<std::uint32_t> cells;
+            for (size_t n = 0; n < points; ++n) {
+                std::uint32_t x = sobol.coordinate(n, dim);
+                if (scramble) x = pricer::owenScramble(x, 12345u + dim);
+                cells.insert(x >> 22);  // one of 1024 equal cells
+            }
+            EXPECT_EQ(cells.size(), points) << "dim " << dim;
+        }
+    }
+
+    // Normal draws follow the Gray-code stepping of coordinate()
+    std::vector<double> z(16);
+    sobol.normals(5, 3, false, 0, z);
+    EXPECT_GT(z[0], -10.0);
+    std::vector<double> single(1);
+    sobol.normals(12, 3, false, 0, single);
+    EXPECT_EQ(single[0], z[7]);
+}
+
+// Test the bridge construction order and its covariance
+TEST(SobolTest, BrownianBridge) {
+    constexpr size_t steps = 8;
+    const pricer::BrownianBridge bridge(steps);
+    std::vector<double> z(steps, 0.0);
+    std::vector<double> w(steps);
+
+    // The first draw alone gives the straight line to W(1)
+    z[0] = 1.0;
+    bridge.build(z, w);
+    for (size_t k = 0; k < steps; ++k) {
+        EXPECT_NEAR(w[k], (k + 1.0) / steps, 1e-15);
+    }
+
+    // Var W(t_k) = t_k: each draw's contribution squared, summed
+    std::vector<double> variance(steps, 0.0);
+    for (size_t i = 0; i < steps; ++i) {
+        std::fill(z.begin(), z.end(), 0.0);
+        z[i] = 1.0;
+        bridge.build(z, w);
+        for (size_t k = 0; k < steps; ++k) {
+            variance[k] += w[k] * w[k];
+        }
+    }
+    for (size_t k = 0; k < steps; ++k) {
+        EXPECT_NEAR(variance[k], (k + 1.0) / steps, 1e-14);
+    }
+
+    EXPECT_THROW(bridge.build(std::vector<double>(3), w), std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+#include "pricer/thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+class ThreadPoolTest : public ::testing::Test {
+protected:
+    pricer::ThreadPool pool{4};
+};
+
+// Test that every index runs exactly once
+TEST_F(ThreadPoolTest, ParallelForCoversEveryIndex) {
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&](size_t i) { ++hits[i]; });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+    EXPECT_EQ(pool.size(), 4u);
+}
+
+// Test that a concurrency cap of one runs everything on the caller
+TEST_F(ThreadPoolTest, ConcurrencyLimit) {
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> elsewhere{0};
+    pool.parallelFor(64, [&](size_t) {
+        if (std::this_thread::get_id() != caller) ++elsewhere;
+    }, 1);
+
+    EXPECT_EQ(elsewhere.load(), 0);
+}
+
+// Test nested loops from inside tasks and single-task submission
+TEST_F(ThreadPoolTest, NestedLoopsAndSubmit) {
+    std::atomic<int> total{0};
+    pool.parallelFor(8, [&](size_t) {
+        pool.parallelFor(8, [&](size_t) { ++total; });
+    });
+    EXPECT_EQ(total.load(), 64);
+
+    auto future = pool.submit([] { return 42; });
+    EXPECT_EQ(future.get(), 42);
+}
+
+// Test that a failing task surfaces on the caller after the loop drains
+TEST_F(ThreadPoolTest, ExceptionPropagates) {
+    std::atomic<int> ran{0};
+    EXPECT_THROW(pool.parallelFor(100, [&](size_t i) {
+        ++ran;
+        if (i == 10) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+
+    // The pool keeps working afterwards
+    std::atomic<int> after{0};
+    pool.parallelFor(10, [&](size_t) { ++after; });
+    EXPECT_EQ(after.load(), 10);
+}
+
+// Test that the global pool cannot be reconfigured once running
+TEST_F(ThreadPoolTest, GlobalPool) {
+    pricer::ThreadPool& global = pricer::ThreadPool::global();
+    EXPECT_GE(global.size(), 1u);
+    EXPECT_EQ(&global, &pricer::ThreadPool::global());
+    EXPECT_THROW(pricer::ThreadPool::setGlobalConfiguration(2), std::runtime_error);
+}
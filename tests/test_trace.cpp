@@ -0,0 +1,67 @@
+#include "pricer/black_scholes.h"
+#include "pricer/option.h"
+#include "pricer/trace.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        option = std::make_unique<pricer::EuropeanOption>(
+            pricer::OptionType::Call,
+            100.0,  // Strike
+            1.0,    // Expiry
+            100.0,  // Spot
+            0.05,   // Rate
+            0.2,    // Volatility
+            0.0     // No dividend
+        );
+        option->setPricingEngine(pricer::makeBlackScholesPricingEngine());
+    }
+
+    std::unique_ptr<pricer::Option> option;
+};
+
+// Test that nothing is installed by default
+TEST_F(TraceTest, DisabledByDefault) {
+    EXPECT_EQ(pricer::trace::currentSink(), nullptr);
+}
+
+// Test that a scoped sink captures the intermediate values of one pricing
+TEST_F(TraceTest, RecordsIntermediateValues) {
+    pricer::RecordingTraceSink sink;
+    double price = 0.0;
+    {
+        pricer::trace::ScopedSink scope(sink);
+        price = option->price();
+    }
+
+#if OPTIONS_PRICER_ENABLE_TRACE
+    ASSERT_NE(sink.find("d1"), nullptr);
+    ASSERT_NE(sink.find("Final Price"), nullptr);
+    EXPECT_DOUBLE_EQ(*sink.find("Final Price"), price);
+    EXPECT_EQ(sink.entries().front().engine, "BlackScholes");
+#else
+    EXPECT_TRUE(sink.entries().empty());
+#endif
+
+    // Nothing is recorded once the scope has ended
+    const size_t recorded = sink.entries().size();
+    (void)option->price();
+    EXPECT_EQ(sink.entries().size(), recorded);
+}
+
+// Test that scopes nest and restore the previous sink
+TEST_F(TraceTest, ScopesNest) {
+    pricer::RecordingTraceSink outer;
+    std::ostringstream text;
+    pricer::StreamTraceSink inner(text);
+
+    pricer::trace::ScopedSink outer_scope(outer);
+    {
+        pricer::trace::ScopedSink inner_scope(inner);
+        EXPECT_EQ(pricer::trace::currentSink(), &inner);
+    }
+    EXPECT_EQ(pricer::trace::currentSink(), &outer);
+}